@@ -816,6 +816,22 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_QUEUE_SELECT
+    #define configUSE_QUEUE_SELECT    0
+#endif
+
+#ifndef configUSE_CRITICAL_STATS
+    #define configUSE_CRITICAL_STATS    0
+#endif
+
+#ifndef configUSE_HEAP_TAGS
+    #define configUSE_HEAP_TAGS    0
+#endif
+
+#ifndef configHEAP_MAX_REGIONS
+    #define configHEAP_MAX_REGIONS    4
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -828,6 +844,10 @@
     #define portDONT_DISCARD
 #endif
 
+#ifndef portHOT_FUNCTION
+    #define portHOT_FUNCTION
+#endif
+
 #ifndef configUSE_TIME_SLICING
     #define configUSE_TIME_SLICING    1
 #endif
@@ -880,6 +900,14 @@
     #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
 #endif
 
+#ifndef configQUEUE_SELECT_INDEX
+    #define configQUEUE_SELECT_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if ( ( configUSE_QUEUE_SELECT == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_QUEUE_SELECT requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
     #define configUSE_POSIX_ERRNO    0
 #endif
@@ -1254,6 +1282,11 @@ typedef struct xSTATIC_QUEUE
         void * pvDummy7;
     #endif
 
+    #if ( configUSE_QUEUE_SELECT == 1 )
+        void * pvDummy10;
+        uint32_t ulDummy11;
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
@@ -3,12 +3,13 @@
 
 /* Here is a good place to include header files that are required across
 your application. */
+#include "clock.h"
 
 
 #define configUSE_PREEMPTION                    1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #define configUSE_TICKLESS_IDLE                 0
-#define configCPU_CLOCK_HZ                      80000000
+#define configCPU_CLOCK_HZ                      ( Clock_getFrequency() ) /* Set up by Clock_Init, the SysTick reload is derived from it when the scheduler starts. */
 #define configTICK_RATE_HZ                      1000
 #define configMAX_PRIORITIES                    5
 #define configMINIMAL_STACK_SIZE                128
@@ -16,12 +17,14 @@ your application. */
 #define configUSE_16_BIT_TICKS                  1
 #define configIDLE_SHOULD_YIELD                 1
 #define configUSE_TASK_NOTIFICATIONS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2 /* Index 0 for the default API and the RX ring, index 1 for ulQueueSelect(). */
 #define configUSE_MUTEXES                       1
 #define configUSE_RECURSIVE_MUTEXES             1
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_ALTERNATIVE_API               0 /* Deprecated! */
 #define configQUEUE_REGISTRY_SIZE               10
 #define configUSE_QUEUE_SETS                    0
+#define configUSE_QUEUE_SELECT                  1
 #define configUSE_TIME_SLICING                  0
 #define configUSE_NEWLIB_REENTRANT              0
 #define configENABLE_BACKWARD_COMPATIBILITY     0
@@ -30,24 +33,44 @@ your application. */
 /* Memory allocation related definitions. */
 #define configSUPPORT_STATIC_ALLOCATION         0
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
-#define configTOTAL_HEAP_SIZE                   20000
+#define configTOTAL_HEAP_SIZE                   20000 /* Not used by heap_5.c, main() gives it all the SRAM left by the linker. */
+#define configUSE_HEAP_TAGS                     0 /* 1 to also print who holds the heap with h, at 16 more bytes per block. */
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
-#define configUSE_IDLE_HOOK                     0
+#define configUSE_IDLE_HOOK                     1
 #define configUSE_TICK_HOOK                     0
 #define configCHECK_FOR_STACK_OVERFLOW          0
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+/* Time every critical section and scheduler suspension, see critstats.h, then enter c to print
+ * the longest ones.  It adds to each of them, so leave it at 0 when measuring anything else. */
+#define configUSE_CRITICAL_STATS                0
+#define configCRITICAL_STATS_SITES              16
+
+/* The run time counter is the DWT cycle counter, the clock governor compares the idle
+ * task share of it between two samples, which are always taken at the same clock level.
+ * A board without a DWT brings its own counter, see gcc/qemu/board_qemu.h. */
+#ifndef portGET_RUN_TIME_COUNTER_VALUE
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()                                \
+{                                                                               \
+    *( ( volatile uint32_t * ) 0xE000EDFC ) |= 0x01000000; /* DEMCR TRCENA. */  \
+    *( ( volatile uint32_t * ) 0xE0001004 ) = 0;           /* DWT CYCCNT. */    \
+    *( ( volatile uint32_t * ) 0xE0001000 ) |= 0x00000001; /* DWT CYCCNTENA. */ \
+}
+#define portGET_RUN_TIME_COUNTER_VALUE()        ( *( ( volatile uint32_t * ) 0xE0001004 ) )
+#endif
+
 /* Co-routine related definitions. */
-#define configUSE_CO_ROUTINES                   0
-#define configMAX_CO_ROUTINE_PRIORITIES         0
+/* Co-routines share the stack of the idle task, vApplicationIdleHook() runs them. */
+#define configUSE_CO_ROUTINES                   1
+#define configMAX_CO_ROUTINE_PRIORITIES         2
 
 /* Software timer related definitions. */
 #define configUSE_TIMERS                        0
@@ -63,6 +86,10 @@ your application. */
 /* Define to trap errors during development. */
 #define configASSERT(x)
 
+/* FPU context related definitions. */
+#define configTASK_DEFAULT_USES_FPU             1
+#define configFPU_LAZY_STACKING                 1
+
 /* FreeRTOS MPU specific definitions. */
 #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS 0
 
@@ -0,0 +1,308 @@
+/*
+ * Actors and their scheduler, see actors.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "actors.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define ACTORS_PAIRS               (ACTORS_COUNT / 2)
+
+/* The end of a list, no actor has this index. */
+#define ACTORS_NONE                0xFF
+
+/* What an actor that returned waits for, its ui8Wait. */
+#define ACTORS_WAIT_NONE           0
+#define ACTORS_WAIT_DELAY          1
+#define ACTORS_WAIT_NOTIFY         2
+
+/* The kinds of actors, their ui8Kind, an index in pfnActorsKinds. */
+#define ACTORS_KIND_SENSOR         0
+#define ACTORS_KIND_FILTER         1
+
+/* The filter of pair i is actor 2i + 1, the notification bit its sensor sets when a sample is ready. */
+#define ACTORS_SAMPLE_READY        0x01
+
+/* The average moves by 1/2^ACTORS_FILTER_SHIFT of the distance to every sample. */
+#define ACTORS_FILTER_SHIFT        3
+
+/*
+ * An actor is a function that returns wherever it waits and goes on from
+ * there the next time it is run, like a co-routine of croutine.h. Its locals
+ * do not survive a wait, what it keeps from one run to the next is in the
+ * block. It starts with ACTORS_BEGIN() and ends with ACTORS_END(), and may
+ * not wait inside a switch of its own.
+ */
+#define ACTORS_BEGIN(psActor)       switch ((psActor)->ui16Resume) { case 0:
+#define ACTORS_END()                }
+
+/* Wait for xTicks, at most 32767, the wake tick is kept on 16 bits. */
+#define ACTORS_DELAY(psActor, xTicks)                                           \
+    (psActor)->ui16Wake = (uint16_t) (xTaskGetTickCount () + (xTicks));         \
+    (psActor)->ui8Wait = ACTORS_WAIT_DELAY;                                     \
+    (psActor)->ui16Resume = __LINE__;                                           \
+    return;                                                                     \
+    case __LINE__:
+
+/* Wait for a notification if none is pending, then take its bits into ui8Bits. */
+#define ACTORS_NOTIFY_WAIT(psActor, ui8Bits)                                    \
+    if ((psActor)->ui8Notified == 0)                                            \
+    {                                                                           \
+        (psActor)->ui8Wait = ACTORS_WAIT_NOTIFY;                                \
+        (psActor)->ui16Resume = __LINE__;                                       \
+        return;                                                                 \
+    }                                                                           \
+    case __LINE__:                                                              \
+    (ui8Bits) = (psActor)->ui8Notified;                                         \
+    (psActor)->ui8Notified = 0
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+/* The control block of an actor, 8 bytes. */
+typedef struct
+{
+    uint16_t ui16Resume;        /* Line to go on from, 0 to start. */
+    uint16_t ui16Wake;          /* Low 16 bits of the tick to wake at, while delayed. */
+    uint8_t ui8Next;            /* Next actor in the ready or the delayed list. */
+    uint8_t ui8Kind;
+    uint8_t ui8Wait;
+    uint8_t ui8Notified;        /* Bits given and not taken yet. */
+} Actors_Control;
+
+typedef void (*Actors_Function) (Actors_Control *psActor, uint32_t ui32Index);
+
+/* All the RAM of the actors, in one block of the heap. */
+typedef struct
+{
+    Actors_Control xControl[ACTORS_COUNT];
+    uint16_t ui16Sample[ACTORS_PAIRS];
+    uint16_t ui16Average[ACTORS_PAIRS];
+} Actors_Block;
+
+typedef enum
+{
+    ACTORS_IDLE,
+    ACTORS_REQUESTED,
+    ACTORS_RUNNING,
+    ACTORS_NO_ROOM
+} Actors_State;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static Actors_Block *psActors = NULL;
+static volatile Actors_State eActorsState = ACTORS_IDLE;
+static uint32_t ui32ActorsHeapBytes = 0;
+
+/* The ready list, in the order the actors are run, and the delayed list, soonest first. Only the idle
+ * task touches them. */
+static uint8_t ui8ActorsReadyHead = ACTORS_NONE;
+static uint8_t ui8ActorsReadyTail = ACTORS_NONE;
+static uint8_t ui8ActorsDelayedHead = ACTORS_NONE;
+
+/* Only written by the filters. */
+static volatile uint32_t ui32ActorsSamples = 0;
+
+/*****************************************************************************/
+/*                              Actors Functions                             */
+/*****************************************************************************/
+
+static void Actors_ready (uint8_t ui8Index)
+{
+    psActors->xControl[ui8Index].ui8Next = ACTORS_NONE;
+    if (ui8ActorsReadyHead == ACTORS_NONE)
+    {
+        ui8ActorsReadyHead = ui8Index;
+    }
+    else
+    {
+        psActors->xControl[ui8ActorsReadyTail].ui8Next = ui8Index;
+    }
+    ui8ActorsReadyTail = ui8Index;
+}
+
+/* Every wake tick is within 32767 ticks of now, so their difference on 16 bits orders them across the
+ * wrap of the tick count. */
+static void Actors_delay (uint8_t ui8Index)
+{
+    Actors_Control *psActor = &psActors->xControl[ui8Index];
+    uint8_t *pui8Link = &ui8ActorsDelayedHead;
+
+    while ((*pui8Link != ACTORS_NONE) &&
+           ((int16_t) (psActors->xControl[*pui8Link].ui16Wake - psActor->ui16Wake) <= 0))
+    {
+        pui8Link = &psActors->xControl[*pui8Link].ui8Next;
+    }
+    psActor->ui8Next = *pui8Link;
+    *pui8Link = ui8Index;
+}
+
+/* Give ui8Bits to actor ui8Index, and make it ready if it was waiting for them. From the actors only. */
+static void Actors_notify (uint8_t ui8Index, uint8_t ui8Bits)
+{
+    Actors_Control *psActor = &psActors->xControl[ui8Index];
+
+    psActor->ui8Notified |= ui8Bits;
+    if (psActor->ui8Wait == ACTORS_WAIT_NOTIFY)
+    {
+        psActor->ui8Wait = ACTORS_WAIT_NONE;
+        Actors_ready (ui8Index);
+    }
+}
+
+static void Actors_Sensor (Actors_Control *psActor, uint32_t ui32Index)
+{
+    ACTORS_BEGIN (psActor);
+
+    while (1)
+    {
+        ACTORS_DELAY (psActor, pdMS_TO_TICKS (ACTORS_PERIOD_MS));
+
+        /* There is no sensor behind it, a sample that changes from tick to tick and from actor to actor will do. */
+        psActors->ui16Sample[ui32Index / 2] = (uint16_t) (xTaskGetTickCount () * (ui32Index + 1));
+        Actors_notify (ui32Index + 1, ACTORS_SAMPLE_READY);
+    }
+
+    ACTORS_END ();
+}
+
+static void Actors_Filter (Actors_Control *psActor, uint32_t ui32Index)
+{
+    uint8_t ui8Bits;
+    int32_t i32Sample, i32Average;
+
+    ACTORS_BEGIN (psActor);
+
+    while (1)
+    {
+        ACTORS_NOTIFY_WAIT (psActor, ui8Bits);
+
+        if ((ui8Bits & ACTORS_SAMPLE_READY) != 0)
+        {
+            i32Sample = psActors->ui16Sample[ui32Index / 2];
+            i32Average = psActors->ui16Average[ui32Index / 2];
+            psActors->ui16Average[ui32Index / 2] = (uint16_t) (i32Average + ((i32Sample - i32Average) >> ACTORS_FILTER_SHIFT));
+            ui32ActorsSamples++;
+        }
+    }
+
+    ACTORS_END ();
+}
+
+static const Actors_Function pfnActorsKinds[] = { Actors_Sensor, Actors_Filter };
+
+void Actors_Start (void)
+{
+    if (eActorsState == ACTORS_IDLE)
+    {
+        eActorsState = ACTORS_REQUESTED;
+    }
+}
+
+void Actors_Create (void)
+{
+    size_t xFree;
+    uint32_t i;
+
+    if (eActorsState != ACTORS_REQUESTED)
+    {
+        return;
+    }
+
+    xFree = xPortGetFreeHeapSize ();
+    psActors = (Actors_Block *) pvPortMalloc (sizeof (Actors_Block));
+    if (psActors == NULL)
+    {
+        eActorsState = ACTORS_NO_ROOM;
+        return;
+    }
+    ui32ActorsHeapBytes = xFree - xPortGetFreeHeapSize ();
+
+    for (i = 0; i < ACTORS_COUNT; i++)
+    {
+        psActors->xControl[i].ui16Resume = 0;
+        psActors->xControl[i].ui8Kind = ((i & 1) == 0) ? ACTORS_KIND_SENSOR : ACTORS_KIND_FILTER;
+        psActors->xControl[i].ui8Wait = ACTORS_WAIT_NONE;
+        psActors->xControl[i].ui8Notified = 0;
+        Actors_ready (i);
+    }
+    for (i = 0; i < ACTORS_PAIRS; i++)
+    {
+        psActors->ui16Sample[i] = 0;
+        psActors->ui16Average[i] = 0;
+    }
+
+    eActorsState = ACTORS_RUNNING;
+}
+
+void Actors_Schedule (void)
+{
+    Actors_Control *psActor;
+    uint16_t ui16Now;
+    uint8_t ui8Index;
+
+    if (eActorsState != ACTORS_RUNNING)
+    {
+        return;
+    }
+
+    ui16Now = (uint16_t) xTaskGetTickCount ();
+    while ((ui8ActorsDelayedHead != ACTORS_NONE) &&
+           ((int16_t) (ui16Now - psActors->xControl[ui8ActorsDelayedHead].ui16Wake) >= 0))
+    {
+        ui8Index = ui8ActorsDelayedHead;
+        ui8ActorsDelayedHead = psActors->xControl[ui8Index].ui8Next;
+        psActors->xControl[ui8Index].ui8Wait = ACTORS_WAIT_NONE;
+        Actors_ready (ui8Index);
+    }
+
+    if (ui8ActorsReadyHead == ACTORS_NONE)
+    {
+        return;
+    }
+    ui8Index = ui8ActorsReadyHead;
+    ui8ActorsReadyHead = psActors->xControl[ui8Index].ui8Next;
+    psActor = &psActors->xControl[ui8Index];
+
+    pfnActorsKinds[psActor->ui8Kind] (psActor, ui8Index);
+
+    /* An actor that returned without waiting is run again after the others that are ready. */
+    if (psActor->ui8Wait == ACTORS_WAIT_DELAY)
+    {
+        Actors_delay (ui8Index);
+    }
+    else if (psActor->ui8Wait == ACTORS_WAIT_NONE)
+    {
+        Actors_ready (ui8Index);
+    }
+}
+
+void Actors_getStats (Actors_Stats *psStats)
+{
+    psStats->ui32Actors = (eActorsState == ACTORS_RUNNING) ? ACTORS_COUNT : 0;
+    psStats->bNoRoom = (eActorsState == ACTORS_NO_ROOM);
+    psStats->ui32ControlBytes = sizeof (((Actors_Block *) 0)->xControl);
+    psStats->ui32StateBytes = sizeof (Actors_Block) - psStats->ui32ControlBytes;
+    psStats->ui32HeapBytes = ui32ActorsHeapBytes;
+    psStats->ui32IdleStackFree = uxTaskGetStackHighWaterMark (xTaskGetIdleTaskHandle ()) * sizeof (StackType_t);
+    psStats->ui32TaskBytes = ACTORS_COUNT * (sizeof (StaticTask_t) + configMINIMAL_STACK_SIZE * sizeof (StackType_t));
+    psStats->ui32Samples = ui32ActorsSamples;
+}
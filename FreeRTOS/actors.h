@@ -0,0 +1,83 @@
+/*
+ * Actors, the workload the target of 200 concurrent actors in under 8 KB of
+ * RAM is measured with. ACTORS_COUNT actors, in pairs of a sensor that takes
+ * a sample every ACTORS_PERIOD_MS and a filter that waits for the
+ * notification of its sensor and averages the samples. They run from the idle
+ * hook, on the stack of the idle task, so what each of them takes is its
+ * control block and its share of the state.
+ *
+ * A co-routine of croutine.c would take 60 bytes of control block alone, 40
+ * of them the two list items of the kernel, so the actors have a scheduler
+ * of their own instead. Their control block is 8 bytes: the point to resume
+ * at, the low 16 bits of the tick to wake at, and the index of the next actor
+ * in the ready or the delayed list, both linked by 8 bit indexes. They can
+ * delay and wait for a notification, a co-routine is still the way to wait
+ * on a queue. 200 actors and their state take 2000 bytes.
+ *
+ * There is no room for them beside the tasks in the 32 KB of SRAM at boot, so
+ * they are allocated from the heap when asked for with Actors_Start(), in one
+ * block with no heap header per actor.
+ */
+
+#ifndef ACTORS_H
+#define ACTORS_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Actors created, half sensors and half filters, fewer than 255 for their 8 bit links. */
+#define ACTORS_COUNT               200
+
+/* RAM the ACTORS_COUNT actors are meant to fit in. */
+#define ACTORS_TARGET_BYTES        8192
+
+/* Time between two samples of a sensor, a delay is at most 32767 ticks. */
+#define ACTORS_PERIOD_MS           100
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    /* Actors running, 0 until they are created, and whether the heap had no room for them. */
+    uint32_t ui32Actors;
+    bool bNoRoom;
+    /* Bytes of their control blocks and of their state, and what the heap gave for both, its header included. */
+    uint32_t ui32ControlBytes;
+    uint32_t ui32StateBytes;
+    uint32_t ui32HeapBytes;
+    /* Bytes of the idle task stack never used, the actors share it with the idle task. */
+    uint32_t ui32IdleStackFree;
+    /* Bytes ACTORS_COUNT tasks with the minimal stack would take, control blocks included. */
+    uint32_t ui32TaskBytes;
+    /* Samples averaged by the filters. */
+    uint32_t ui32Samples;
+} Actors_Stats;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Ask for the actors to be created, the first time only. They are created by the idle hook with
+ * Actors_Create(), so they are never added to the lists of the scheduler while it runs. */
+void Actors_Start (void);
+
+/* Called from the idle hook before Actors_Schedule(), does nothing until Actors_Start() is. */
+void Actors_Create (void);
+
+/* Called from the idle hook, wakes the actors whose delay is over and runs the first ready one. */
+void Actors_Schedule (void);
+
+void Actors_getStats (Actors_Stats *psStats);
+
+#endif /* ACTORS_H */
@@ -33,6 +33,12 @@
  * This file implements atomic functions by disabling interrupts globally.
  * Implementations with architecture specific atomic instructions can be
  * provided under each compiler directory.
+ *
+ * Ports that have exclusive access instructions (ldrex/strex) define
+ * portHAS_EXCLUSIVE_ACCESS to 1 in portmacro.h and provide the primitives
+ * xPortCompareAndSwap(), ulPortAtomicSwap(), ulPortAtomicAdd(),
+ * ulPortAtomicOR(), ulPortAtomicAND(), ulPortAtomicNAND() and
+ * ulPortAtomicXOR().  The functions below then never mask interrupts.
  */
 
 #ifndef ATOMIC_H
@@ -87,6 +93,10 @@
     #define portFORCE_INLINE
 #endif
 
+#ifndef portHAS_EXCLUSIVE_ACCESS
+    #define portHAS_EXCLUSIVE_ACCESS    0
+#endif
+
 #define ATOMIC_COMPARE_AND_SWAP_SUCCESS    0x1U     /**< Compare and swap succeeded, swapped. */
 #define ATOMIC_COMPARE_AND_SWAP_FAILURE    0x0U     /**< Compare and swap failed, did not swap. */
 
@@ -111,23 +121,27 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
                                                             uint32_t ulExchange,
                                                             uint32_t ulComparand )
 {
-    uint32_t ulReturnValue;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ( xPortCompareAndSwap( pulDestination, ulComparand, ulExchange ) != pdFALSE ) ? ATOMIC_COMPARE_AND_SWAP_SUCCESS : ATOMIC_COMPARE_AND_SWAP_FAILURE;
+    #else
+        uint32_t ulReturnValue;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        if( *pulDestination == ulComparand )
-        {
-            *pulDestination = ulExchange;
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
-        }
-        else
+        ATOMIC_ENTER_CRITICAL();
         {
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+            if( *pulDestination == ulComparand )
+            {
+                *pulDestination = ulExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+            else
+            {
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+            }
         }
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulReturnValue;
+        return ulReturnValue;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -146,16 +160,20 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
 static portFORCE_INLINE void * Atomic_SwapPointers_p32( void * volatile * ppvDestination,
                                                         void * pvExchange )
 {
-    void * pReturnValue;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ( void * ) ulPortAtomicSwap( ( uint32_t volatile * ) ppvDestination, ( uint32_t ) pvExchange );
+    #else
+        void * pReturnValue;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        pReturnValue = *ppvDestination;
-        *ppvDestination = pvExchange;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            pReturnValue = *ppvDestination;
+            *ppvDestination = pvExchange;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return pReturnValue;
+        return pReturnValue;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -179,19 +197,23 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volat
                                                                     void * pvExchange,
                                                                     void * pvComparand )
 {
-    uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ( xPortCompareAndSwap( ( uint32_t volatile * ) ppvDestination, ( uint32_t ) pvComparand, ( uint32_t ) pvExchange ) != pdFALSE ) ? ATOMIC_COMPARE_AND_SWAP_SUCCESS : ATOMIC_COMPARE_AND_SWAP_FAILURE;
+    #else
+        uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        if( *ppvDestination == pvComparand )
+        ATOMIC_ENTER_CRITICAL();
         {
-            *ppvDestination = pvExchange;
-            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            if( *ppvDestination == pvComparand )
+            {
+                *ppvDestination = pvExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
         }
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulReturnValue;
+        return ulReturnValue;
+    #endif
 }
 
 
@@ -211,16 +233,20 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volat
 static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
                                                  uint32_t ulCount )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicAdd( pulAddend, ulCount );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend += ulCount;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend += ulCount;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -239,16 +265,20 @@ static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAddend,
                                                       uint32_t ulCount )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicAdd( pulAddend, ( uint32_t ) 0 - ulCount );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend -= ulCount;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend -= ulCount;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -264,16 +294,20 @@ static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAdd
  */
 static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAddend )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicAdd( pulAddend, 1 );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend += 1;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend += 1;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -289,16 +323,20 @@ static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAd
  */
 static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAddend )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicAdd( pulAddend, ( uint32_t ) 0 - 1 );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulAddend;
-        *pulAddend -= 1;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend -= 1;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 
 /*----------------------------- Bitwise Logical ------------------------------*/
@@ -317,16 +355,20 @@ static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAd
 static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestination,
                                                 uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicOR( pulDestination, ulValue );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination |= ulValue;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination |= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -344,16 +386,20 @@ static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestinati
 static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestination,
                                                  uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicAND( pulDestination, ulValue );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination &= ulValue;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination &= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -371,16 +417,20 @@ static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestinat
 static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestination,
                                                   uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicNAND( pulDestination, ulValue );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination = ~( ulCurrent & ulValue );
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination = ~( ulCurrent & ulValue );
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -398,16 +448,20 @@ static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestina
 static portFORCE_INLINE uint32_t Atomic_XOR_u32( uint32_t volatile * pulDestination,
                                                  uint32_t ulValue )
 {
-    uint32_t ulCurrent;
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+        return ulPortAtomicXOR( pulDestination, ulValue );
+    #else
+        uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
-    {
-        ulCurrent = *pulDestination;
-        *pulDestination ^= ulValue;
-    }
-    ATOMIC_EXIT_CRITICAL();
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination ^= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
 
-    return ulCurrent;
+        return ulCurrent;
+    #endif
 }
 
 /* *INDENT-OFF* */
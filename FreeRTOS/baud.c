@@ -0,0 +1,232 @@
+/*
+ * UART baud rates checked against the clock they are divided from, see baud.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "baud.h"
+
+/* TivaWare includes.  */
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* Rates the hosts set, the usual ones of the PC and the ones of the USB to serial bridges above 1 Mbaud. */
+static const uint32_t ui32BaudRates[] =
+{
+    9600, 14400, 19200, 38400, 57600, 115200, 128000, 230400, 256000, 460800, 500000,
+    921600, 1000000, 1500000, 2000000, 3000000, 4000000, 6000000
+};
+
+#define BAUD_RATES      (sizeof(ui32BaudRates) / sizeof(ui32BaudRates[0]))
+
+/*****************************************************************************/
+/*                                 Baud Functions                            */
+/*****************************************************************************/
+
+bool Baud_compute (uint32_t ui32ClockHz, uint32_t ui32Baud, Baud_Setting *psSetting)
+{
+    uint32_t ui32Oversample, ui32Divisor;
+    int64_t i64Error;
+
+    psSetting->ui32Baud = ui32Baud;
+    psSetting->ui32Actual = 0;
+    psSetting->i32ErrorPpm = 0;
+    psSetting->ui16Integer = 0;
+    psSetting->ui8Fraction = 0;
+
+    /* UARTConfigSetExpClk() only sets HSE when the rate is past the clock / 16. */
+    psSetting->bHighSpeed = (((uint64_t) ui32Baud * BAUD_OVERSAMPLE) > ui32ClockHz);
+    ui32Oversample = (psSetting->bHighSpeed == true) ? BAUD_OVERSAMPLE_HSE : BAUD_OVERSAMPLE;
+    psSetting->ui32TolerancePpm = BAUD_TOLERANCE_PPM (ui32Oversample);
+
+    if ((ui32Baud == 0) || (((uint64_t) ui32Baud * ui32Oversample) > ui32ClockHz))
+    {
+        return false;
+    }
+
+    /* In 64ths and rounded the same way, HSE divides by 16 from half the rate. */
+    ui32Divisor = (((ui32ClockHz * 8) / ((psSetting->bHighSpeed == true) ? (ui32Baud / 2) : ui32Baud)) + 1) / 2;
+    if ((ui32Divisor / 64) > 0xFFFF)
+    {
+        return false;
+    }
+
+    psSetting->ui16Integer = (uint16_t) (ui32Divisor / 64);
+    psSetting->ui8Fraction = (uint8_t) (ui32Divisor % 64);
+
+    /* The clock / (oversample x divisor / 64), which is 4 x the clock / divisor at 16 times a bit. */
+    psSetting->ui32Actual = (uint32_t) ((((uint64_t) ui32ClockHz * 64 / ui32Oversample) + (ui32Divisor / 2)) / ui32Divisor);
+    i64Error = (((int64_t) ui32ClockHz * 64 * 1000000) / ((int64_t) ui32Oversample * ui32Divisor)) - ((int64_t) ui32Baud * 1000000);
+    psSetting->i32ErrorPpm = (int32_t) (i64Error / ui32Baud);
+
+    return ((psSetting->i32ErrorPpm <= (int32_t) psSetting->ui32TolerancePpm) &&
+            (psSetting->i32ErrorPpm >= -(int32_t) psSetting->ui32TolerancePpm));
+}
+
+uint32_t Baud_fastest (uint32_t ui32ClockHz, uint32_t ui32Max)
+{
+    Baud_Setting xSetting;
+    uint32_t i = BAUD_RATES;
+
+    while (i > 0)
+    {
+        i--;
+        if ((ui32BaudRates[i] <= ui32Max) && (Baud_compute (ui32ClockHz, ui32BaudRates[i], &xSetting) == true))
+        {
+            return ui32BaudRates[i];
+        }
+    }
+
+    return 0;
+}
+
+uint32_t Baud_nearest (uint32_t ui32Measured)
+{
+    uint32_t ui32Distance;
+    uint32_t i;
+
+    for (i = 0; i < BAUD_RATES; i++)
+    {
+        ui32Distance = (ui32Measured > ui32BaudRates[i]) ? (ui32Measured - ui32BaudRates[i]) : (ui32BaudRates[i] - ui32Measured);
+
+        /* The rates are far enough apart that only one can be this close. */
+        if (((uint64_t) ui32Distance * 1000000) <= ((uint64_t) ui32BaudRates[i] * BAUD_DETECT_PPM))
+        {
+            return ui32BaudRates[i];
+        }
+    }
+
+    return 0;
+}
+
+uint32_t Baud_fromEdges (const uint32_t *pui32Edges, uint32_t ui32ClockHz)
+{
+    uint32_t ui32Total = pui32Edges[BAUD_SYNC_EDGES - 1] - pui32Edges[0];
+    uint32_t ui32Interval, i;
+
+    if (ui32Total == 0)
+    {
+        return 0;
+    }
+
+    /* Every falling edge two bits after the last one, within a quarter of the average. A character
+     * other than BAUD_SYNC has an interval of 1 or of 3 bits and more somewhere. */
+    for (i = 1; i < BAUD_SYNC_EDGES; i++)
+    {
+        ui32Interval = (pui32Edges[i] - pui32Edges[i - 1]) * (BAUD_SYNC_EDGES - 1);
+        if ((ui32Interval < (ui32Total - (ui32Total / 4))) || (ui32Interval > (ui32Total + (ui32Total / 4))))
+        {
+            return 0;
+        }
+    }
+
+    return Baud_nearest ((uint32_t) (((uint64_t) ui32ClockHz * 2 * (BAUD_SYNC_EDGES - 1)) / ui32Total));
+}
+
+/* Wait up to ui32Limit cycles for the pin to be high, then up to ui32Limit more for it to go low, and
+ * stamp when it went low. An interrupt between an edge and its stamp would stretch the interval, so
+ * only the wait for the edge is masked, and an edge that came before it is taken as missed. */
+static bool Baud_waitFalling (uint32_t ui32Pin, uint32_t ui32Limit, uint32_t *pui32Stamp)
+{
+    uint32_t ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    uint32_t ui32Now;
+    bool bFound = false;
+
+    do
+    {
+        ui32Now = portGET_RUN_TIME_COUNTER_VALUE ();
+        if ((ui32Now - ui32Start) > ui32Limit)
+        {
+            return false;
+        }
+    } while (HWREG (ui32Pin) == 0);
+
+    taskENTER_CRITICAL ();
+
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    if (HWREG (ui32Pin) != 0)
+    {
+        do
+        {
+            ui32Now = portGET_RUN_TIME_COUNTER_VALUE ();
+            if (HWREG (ui32Pin) == 0)
+            {
+                *pui32Stamp = ui32Now;
+                bFound = true;
+            }
+        } while ((bFound == false) && ((ui32Now - ui32Start) <= ui32Limit));
+    }
+
+    taskEXIT_CRITICAL ();
+
+    return bFound;
+}
+
+uint32_t Baud_detect (uint32_t ui32Port, uint8_t ui8Pin, uint32_t ui32ClockHz, uint32_t ui32TimeoutMs)
+{
+    /* The address of the data register with only the pin in its mask. */
+    uint32_t ui32Pin = ui32Port + GPIO_O_DATA + ((uint32_t) ui8Pin << 2);
+    uint32_t ui32Edges[BAUD_SYNC_EDGES];
+    uint32_t ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    uint32_t ui32Timeout = ui32TimeoutMs * (ui32ClockHz / 1000);
+    /* Two bits at the slowest rate and some, the longest between two falling edges of BAUD_SYNC, and
+     * the longest the interrupts are masked for, 312 us at 80 MHz. */
+    uint32_t ui32EdgeMax = 3 * (ui32ClockHz / BAUD_DETECT_MIN);
+    uint32_t ui32Baud = 0;
+    uint32_t ui32Idle, ui32Low, ui32Now;
+    uint32_t i = 0;
+
+    while ((ui32Baud == 0) && ((portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) < ui32Timeout))
+    {
+        if (Baud_waitFalling (ui32Pin, ui32EdgeMax, &ui32Edges[i]) == false)
+        {
+            /* A silence, or an edge missed to an interrupt, the edges start over. */
+            i = 0;
+        }
+        else if (++i == BAUD_SYNC_EDGES)
+        {
+            /* The first edge may be any of a character, so the edges slide by one until five of them
+             * are the ones of a character. */
+            ui32Baud = Baud_fromEdges (ui32Edges, ui32ClockHz);
+            for (i = 1; i < BAUD_SYNC_EDGES; i++)
+            {
+                ui32Edges[i - 1] = ui32Edges[i];
+            }
+            i = BAUD_SYNC_EDGES - 1;
+        }
+    }
+
+    if (ui32Baud == 0)
+    {
+        return 0;
+    }
+
+    /* The UART would take the rest of the sync characters for characters, wait for two of them of silence. */
+    ui32Idle = 2 * BAUD_FRAME_BITS * (ui32ClockHz / ui32Baud);
+    ui32Low = portGET_RUN_TIME_COUNTER_VALUE ();
+    do
+    {
+        ui32Now = portGET_RUN_TIME_COUNTER_VALUE ();
+        if (HWREG (ui32Pin) == 0)
+        {
+            ui32Low = ui32Now;
+        }
+    } while (((ui32Now - ui32Low) < ui32Idle) && ((ui32Now - ui32Start) < ui32Timeout));
+
+    return ui32Baud;
+}
@@ -0,0 +1,99 @@
+/*
+ * UART baud rates checked against the clock they are divided from.
+ *
+ * The UART divides the system clock by 16, or by 8 with the HSE bit of
+ * UARTCTL, times a divisor with a 6 bit fraction, so most baud rates are only
+ * approached. Baud_compute() works out the divisor the way
+ * UARTConfigSetExpClk() programs it, and the error it leaves. The receiver
+ * finds the start bit within one sample and takes the bit in the middle of
+ * three samples, so the clocks of both ends may drift apart by half a bit
+ * less two samples over the 9.5 bits up to the middle of the stop bit. Half
+ * of that is left to this end, the host has the other half.
+ *
+ * Baud_detect() finds the rate of the host from BAUD_SYNC characters, 0x55,
+ * which are a square wave of one bit per level: the start bit is low and the
+ * data bits alternate from bit 0 high, up to the stop bit. The UART0 Rx pin
+ * PA0 has no timer capture input, so the pin is read as a GPIO while the
+ * cycle counter stamps its falling edges, four of them two bits apart.
+ */
+
+#ifndef BAUD_H
+#define BAUD_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Samples per bit, without and with the HSE bit. */
+#define BAUD_OVERSAMPLE          16
+#define BAUD_OVERSAMPLE_HSE      8
+
+/* Start bit, 8 data bits and the stop bit. */
+#define BAUD_FRAME_BITS          10
+
+/* Largest error in ppm left to this end at an oversampling: (1/2 - 2/oversample) / 9.5 bits / 2 ends. */
+#define BAUD_TOLERANCE_PPM(ui32Oversample)   \
+    ((500000 - (2000000 / (ui32Oversample))) / (2 * BAUD_FRAME_BITS - 1))
+
+/* The character the host sends for Baud_detect(), U. */
+#define BAUD_SYNC                0x55
+
+/* Falling edges stamped, they span 8 bits. */
+#define BAUD_SYNC_EDGES          5
+
+/* A rate measured this close to a rate of the table is taken as it, the closest two of the table
+ * are 11% apart. */
+#define BAUD_DETECT_PPM          40000
+
+/* Slowest rate Baud_detect() waits for, which bounds the wait for each edge, with the interrupts masked. */
+#define BAUD_DETECT_MIN          9600
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    uint32_t ui32Baud;          /* Asked for. */
+    uint32_t ui32Actual;        /* What the divisor gives. */
+    int32_t i32ErrorPpm;        /* Of ui32Actual against ui32Baud. */
+    uint32_t ui32TolerancePpm;  /* Largest error allowed at the oversampling used. */
+    uint16_t ui16Integer;       /* UARTIBRD. */
+    uint8_t ui8Fraction;        /* UARTFBRD, in 64ths. */
+    bool bHighSpeed;            /* HSE set, sampled 8 times a bit. */
+} Baud_Setting;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Divisor of ui32Baud at ui32ClockHz, as UARTConfigSetExpClk() sets it. Returns false if the divisor
+ * is out of range, or its error past the tolerance, psSetting is filled in anyway. */
+bool Baud_compute (uint32_t ui32ClockHz, uint32_t ui32Baud, Baud_Setting *psSetting);
+
+/* Fastest rate of the table up to ui32Max that Baud_compute() accepts at ui32ClockHz, 0 if none. */
+uint32_t Baud_fastest (uint32_t ui32ClockHz, uint32_t ui32Max);
+
+/* Rate of the table within BAUD_DETECT_PPM of ui32Measured, 0 if none. */
+uint32_t Baud_nearest (uint32_t ui32Measured);
+
+/* Rate of BAUD_SYNC_EDGES falling edges stamped in cycles of ui32ClockHz, 0 if they are not the
+ * ones of BAUD_SYNC characters or of no rate of the table. */
+uint32_t Baud_fromEdges (const uint32_t *pui32Edges, uint32_t ui32ClockHz);
+
+/* Wait up to ui32TimeoutMs for BAUD_SYNC characters on the pin ui8Pin of the GPIO port ui32Port,
+ * and return their rate, then wait for the host to stop sending them, within the same time.
+ * Returns 0 if nothing was recognised. The pin must be a GPIO input, and the cycle counter
+ * running. The interrupts are only masked while one falling edge is waited for, three bits at
+ * BAUD_DETECT_MIN at most, 312 us, and are let in between two edges. */
+uint32_t Baud_detect (uint32_t ui32Port, uint8_t ui8Pin, uint32_t ui32ClockHz, uint32_t ui32TimeoutMs);
+
+#endif /* BAUD_H */
@@ -0,0 +1,404 @@
+/*
+ * Kernel benchmark, see bench.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Header Files Includes.  */
+#include "bench.h"
+#include "print.h"
+
+/* TivaWare includes.  */
+#include "utils/ustdlib.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "fastmutex.h"
+#include "atomic.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Above the tasks that run the commands, so every notification switches to it straight away. */
+#define BENCH_TASK_PRIORITY        (configMAX_PRIORITIES - 2)
+#define STACK_SIZE_BENCH           128
+
+/* Start of the SRAM, the hot paths run from flash below it. */
+#define BENCH_SRAM_BASE            0x20000000
+
+/* A line like the ones of the console, with only the conversions both engines know. */
+#define BENCH_FORMAT               "Task %s, load %% %u, stack %u, stamp %08x, delta %d\n\r"
+#define BENCH_FORMAT_SIZE          96
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+/* A conversion of Print_snprintf(), with what printf() of the C library gives for it. */
+typedef struct
+{
+    const char *pcFormat;
+    int32_t i32First;
+    int32_t i32Second;
+    const char *pcExpected;
+} Bench_FormatCheck;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static TaskHandle_t xBenchTask = NULL;
+static TaskHandle_t xBenchFPUTask = NULL;
+
+/* Worked on by the FPU task every time it is notified, so it always blocks with a live floating point
+ * context, and whether it drops that context with portRESET_FPU_CONTEXT() before blocking. */
+static volatile float fBenchFPUValue = 1.0f;
+static volatile bool bBenchFPUReset = false;
+
+/* The mutexes timed by Bench_Mutex, the fast one is also the one the benchmark task waits for. */
+static FastMutex_t xBenchMutex;
+static SemaphoreHandle_t xBenchKernelMutex = NULL;
+
+/* Set by Bench_Mutex for the benchmark task to take the fast mutex, or the kernel one, when notified,
+ * waiting for it xBenchMutexWait ticks, whether it got it, and the cycle counter when it did. */
+static volatile bool bBenchMutexWait = false;
+static volatile bool bBenchMutexKernel = false;
+static volatile TickType_t xBenchMutexWait;
+static volatile bool bBenchMutexTaken;
+static volatile uint32_t ui32BenchMutexTakenAt;
+
+/* The counter incremented by Bench_Atomic. */
+static volatile uint32_t ui32BenchCounter = 0;
+
+/* The flags, widths and precisions of the integer conversions, the second argument is only read by the '*' ones. */
+static const Bench_FormatCheck xBenchFormatChecks[] =
+{
+    { "%d", -2147483647 - 1, 0, "-2147483648" },
+    { "%05d", -42, 0, "-0042" },
+    { "%+d", 5, 0, "+5" },
+    { "%.3d", 7, 0, "007" },
+    { "%8.3d", -7, 0, "    -007" },
+    { "%.*d", 4, 12, "0012" },
+    { "%.0d", 0, 0, "" },
+    { "%5.0d|", 0, 0, "     |" },
+    { "%+.3d", -1, 0, "-001" },
+    { "%08.3d", 5, 0, "     005" },
+    { "%-*d|", 6, 12, "12    |" },
+    { "%.0u", 0, 0, "" },
+    { "%.10u", 12345, 0, "0000012345" },
+    { "%08X", 0xBEEF, 0, "0000BEEF" },
+    { "%.3x", 0xA, 0, "00a" },
+    { "%-6.3X|", 0xAB, 0, "0AB   |" }
+};
+
+/*****************************************************************************/
+/*                               Bench Functions                             */
+/*****************************************************************************/
+
+static void Bench_Task (void * pvParameters)
+{
+    /* This task never uses floats, so drop its FPU access to keep its context switches cheap. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
+    while (1)
+    {
+        /* Blocking again is the switch back to Bench_Run. */
+        ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+
+        if ((bBenchMutexWait == true) && (bBenchMutexKernel == true))
+        {
+            bBenchMutexTaken = (xSemaphoreTake (xBenchKernelMutex, xBenchMutexWait) == pdTRUE);
+            ui32BenchMutexTakenAt = portGET_RUN_TIME_COUNTER_VALUE ();
+            if (bBenchMutexTaken == true)
+            {
+                xSemaphoreGive (xBenchKernelMutex);
+            }
+        }
+        else if (bBenchMutexWait == true)
+        {
+            bBenchMutexTaken = (xFastMutexTake (&xBenchMutex, xBenchMutexWait) == pdTRUE);
+            ui32BenchMutexTakenAt = portGET_RUN_TIME_COUNTER_VALUE ();
+            if (bBenchMutexTaken == true)
+            {
+                xFastMutexGive (&xBenchMutex);
+            }
+        }
+    }
+}
+
+/* The same as Bench_Task, with floats. */
+static void Bench_FPUTask (void * pvParameters)
+{
+    portTASK_USES_FLOATING_POINT();
+
+    while (1)
+    {
+        ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+
+        fBenchFPUValue = (fBenchFPUValue * 0.5f) + 1.0f;
+        if (bBenchFPUReset == true)
+        {
+            portRESET_FPU_CONTEXT();
+        }
+    }
+}
+
+void Bench_Init (void)
+{
+    vFastMutexInit (&xBenchMutex);
+    xBenchKernelMutex = xSemaphoreCreateMutex ();
+    xTaskCreate (Bench_Task, "Task_BENCH", STACK_SIZE_BENCH, NULL, BENCH_TASK_PRIORITY, &xBenchTask);
+    xTaskCreate (Bench_FPUTask, "Task_BENCH_FPU", STACK_SIZE_BENCH, NULL, BENCH_TASK_PRIORITY, &xBenchFPUTask);
+}
+
+void Bench_Run (uint32_t ui32Rounds, uint32_t ui32Ticks, Bench_Result *psResult)
+{
+    uint32_t ui32Start, ui32Now, ui32Last, ui32Gap;
+    uint32_t ui32Loop = 0xFFFFFFFF;
+    uint64_t ui64TickSum = 0;
+    TickType_t xStart;
+    uint32_t i;
+
+    /* vTaskSwitchContext is in .hot_text, so where it runs is where all of them run. */
+    psResult->bInSRAM = ((uint32_t) &vTaskSwitchContext >= BENCH_SRAM_BASE);
+
+    /* Every round is two switches, to the benchmark task on the notification, and back when it blocks. */
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xTaskNotifyGive (xBenchTask);
+    }
+    psResult->ui32SwitchCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / (2 * ui32Rounds);
+
+    /* Wait for a tick to start from, then spin reading the cycle counter. A gap between two reads
+     * is something else that ran meanwhile, which is only ever the tick, unless a character comes in. */
+    vTaskDelay (1);
+
+    psResult->ui32TickMin = 0xFFFFFFFF;
+    psResult->ui32TickMax = 0;
+    psResult->ui32Ticks = 0;
+
+    xStart = xTaskGetTickCount ();
+    ui32Last = portGET_RUN_TIME_COUNTER_VALUE ();
+    while ((xTaskGetTickCount () - xStart) < ui32Ticks)
+    {
+        ui32Now = portGET_RUN_TIME_COUNTER_VALUE ();
+        ui32Gap = ui32Now - ui32Last;
+        ui32Last = ui32Now;
+
+        if (ui32Gap <= BENCH_GAP_CYCLES)
+        {
+            /* The shortest turn of the loop is what it costs on its own. */
+            if (ui32Gap < ui32Loop)
+            {
+                ui32Loop = ui32Gap;
+            }
+        }
+        else
+        {
+            psResult->ui32Ticks++;
+            ui64TickSum += ui32Gap;
+            if (ui32Gap < psResult->ui32TickMin)
+            {
+                psResult->ui32TickMin = ui32Gap;
+            }
+            if (ui32Gap > psResult->ui32TickMax)
+            {
+                psResult->ui32TickMax = ui32Gap;
+            }
+        }
+    }
+
+    if (psResult->ui32Ticks == 0)
+    {
+        psResult->ui32TickMin = 0;
+        psResult->ui32TickAverage = 0;
+        return;
+    }
+
+    /* Take the turn of the loop the interrupt came in out of every gap. */
+    if (ui32Loop == 0xFFFFFFFF)
+    {
+        ui32Loop = 0;
+    }
+    psResult->ui32TickMin -= ui32Loop;
+    psResult->ui32TickMax -= ui32Loop;
+    psResult->ui32TickAverage = (uint32_t) (ui64TickSum / psResult->ui32Ticks) - ui32Loop;
+}
+
+void Bench_FPU (uint32_t ui32Rounds, Bench_FPUResult *psResult)
+{
+    uint32_t ui32Start;
+    uint32_t i;
+
+    /* Each round is a notification, the switch to the task notified, and the switch back when it blocks. */
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xTaskNotifyGive (xBenchTask);
+    }
+    psResult->ui32PlainCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / ui32Rounds;
+
+    /* Switching out of the FPU task saves s0-s31 and FPSCR, switching back in restores them, and the
+     * CPACR is rewritten both ways. */
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xTaskNotifyGive (xBenchFPUTask);
+    }
+    psResult->ui32FPUCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / ui32Rounds;
+
+    bBenchFPUReset = true;
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xTaskNotifyGive (xBenchFPUTask);
+    }
+    psResult->ui32ResetCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / ui32Rounds;
+    bBenchFPUReset = false;
+}
+
+void Bench_Format (uint32_t ui32Rounds, Bench_FormatResult *psResult)
+{
+    char pcLine[BENCH_FORMAT_SIZE];
+    uint32_t ui32Start, ui32Print = 0, ui32TivaWare = 0;
+    uint32_t i;
+
+    /* The same arguments for both, changing every round so the digits change too. */
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+        Print_snprintf (pcLine, BENCH_FORMAT_SIZE, BENCH_FORMAT, "Task_UART_RECEIVE", i % 101, i * 7, i * 2654435761u, 500 - (int32_t) i);
+        ui32Print += portGET_RUN_TIME_COUNTER_VALUE () - ui32Start;
+
+        ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+        usnprintf (pcLine, BENCH_FORMAT_SIZE, BENCH_FORMAT, "Task_UART_RECEIVE", i % 101, i * 7, i * 2654435761u, 500 - (int32_t) i);
+        ui32TivaWare += portGET_RUN_TIME_COUNTER_VALUE () - ui32Start;
+    }
+
+    psResult->ui32PrintCycles = ui32Print / ui32Rounds;
+    psResult->ui32TivaWareCycles = ui32TivaWare / ui32Rounds;
+    psResult->ui32Length = Print_snprintf (pcLine, BENCH_FORMAT_SIZE, BENCH_FORMAT, "Task_UART_RECEIVE", 0, 0, 0, 0);
+
+    /* Then check the output is the one of printf(). */
+    psResult->ui32Checks = sizeof (xBenchFormatChecks) / sizeof (xBenchFormatChecks[0]);
+    psResult->ui32Mismatches = 0;
+    psResult->pcMismatch = NULL;
+    for (i = 0; i < psResult->ui32Checks; i++)
+    {
+        Print_snprintf (pcLine, BENCH_FORMAT_SIZE, xBenchFormatChecks[i].pcFormat,
+                        xBenchFormatChecks[i].i32First, xBenchFormatChecks[i].i32Second);
+        if (strcmp (pcLine, xBenchFormatChecks[i].pcExpected) != 0)
+        {
+            if (psResult->ui32Mismatches == 0)
+            {
+                psResult->pcMismatch = xBenchFormatChecks[i].pcFormat;
+            }
+            psResult->ui32Mismatches++;
+        }
+    }
+}
+
+void Bench_Mutex (uint32_t ui32Rounds, Bench_MutexResult *psResult)
+{
+    UBaseType_t uxBasePriority = uxTaskPriorityGet (NULL);
+    uint64_t ui64Handoff;
+    uint32_t ui32Start;
+    uint32_t i;
+
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xFastMutexTake (&xBenchMutex, 0);
+        xFastMutexGive (&xBenchMutex);
+    }
+    psResult->ui32FastCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / ui32Rounds;
+
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xSemaphoreTake (xBenchKernelMutex, 0);
+        xSemaphoreGive (xBenchKernelMutex);
+    }
+    psResult->ui32KernelCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / ui32Rounds;
+
+    /* The benchmark task runs as soon as it is notified and blocks on the mutex held here, which
+     * gives its priority to this task, until it times out while this one is delayed. */
+    bBenchMutexWait = true;
+    xFastMutexTake (&xBenchMutex, 0);
+    xBenchMutexWait = BENCH_MUTEX_TIMEOUT;
+    xTaskNotifyGive (xBenchTask);
+    psResult->bInherited = (uxTaskPriorityGet (NULL) == BENCH_TASK_PRIORITY);
+    vTaskDelay (BENCH_MUTEX_TIMEOUT + 1);
+    psResult->bTimedOut = (bBenchMutexTaken == false);
+    psResult->bRestored = (uxTaskPriorityGet (NULL) == uxBasePriority);
+    xFastMutexGive (&xBenchMutex);
+
+    /* This time the give wakes it, it takes the mutex and gives it back before this task runs again. */
+    xFastMutexTake (&xBenchMutex, 0);
+    xBenchMutexWait = portMAX_DELAY;
+    xTaskNotifyGive (xBenchTask);
+    xFastMutexGive (&xBenchMutex);
+    psResult->bHandedOver = (bBenchMutexTaken == true);
+    psResult->bRestored = psResult->bRestored && (uxTaskPriorityGet (NULL) == uxBasePriority);
+
+    /* The same handover, timed from the give here to the take returning in the benchmark task. */
+    ui64Handoff = 0;
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xFastMutexTake (&xBenchMutex, 0);
+        xTaskNotifyGive (xBenchTask);
+        ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+        xFastMutexGive (&xBenchMutex);
+        ui64Handoff += ui32BenchMutexTakenAt - ui32Start;
+    }
+    psResult->ui32FastHandoffCycles = (uint32_t) (ui64Handoff / ui32Rounds);
+
+    bBenchMutexKernel = true;
+    ui64Handoff = 0;
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xSemaphoreTake (xBenchKernelMutex, 0);
+        xTaskNotifyGive (xBenchTask);
+        ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+        xSemaphoreGive (xBenchKernelMutex);
+        ui64Handoff += ui32BenchMutexTakenAt - ui32Start;
+    }
+    psResult->ui32KernelHandoffCycles = (uint32_t) (ui64Handoff / ui32Rounds);
+    bBenchMutexKernel = false;
+
+    bBenchMutexWait = false;
+}
+
+void Bench_Atomic (uint32_t ui32Rounds, Bench_AtomicResult *psResult)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint32_t ui32Start;
+    uint32_t i;
+
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        Atomic_Increment_u32 (&ui32BenchCounter);
+    }
+    psResult->ui32AtomicCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / ui32Rounds;
+
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR ();
+        ui32BenchCounter++;
+        portCLEAR_INTERRUPT_MASK_FROM_ISR (uxSavedInterruptStatus);
+    }
+    psResult->ui32CriticalCycles = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) / ui32Rounds;
+}
@@ -0,0 +1,130 @@
+/*
+ * Kernel benchmark. Times the two paths portHOT_FUNCTION places in .hot_text,
+ * the context switch and the tick interrupt, in cycles, so the build with
+ * HOT_PATHS_IN_SRAM set in tm4c123gh6pm.cmd can be compared with the one
+ * running them from flash.
+ *
+ * Also times a notification round trip to a task without FPU access against
+ * one to a task with a floating point context, formatting a line of the
+ * console with print.c against the formatting code of TivaWare, a fast mutex
+ * against a kernel one, with a check of its priority inheritance when a
+ * waiting task times out, and the ldrex/strex increment of atomic.h against
+ * the critical section it replaced.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* A gap longer than this between two reads of the cycle counter in the tick loop is an interrupt,
+ * shorter ones are the loop itself. */
+#define BENCH_GAP_CYCLES           60
+
+/* Ticks the benchmark task waits for the fast mutex held by the caller of Bench_Mutex before it times out. */
+#define BENCH_MUTEX_TIMEOUT        5
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    /* Average cycles of one switch between two tasks, the notification that causes it included. */
+    uint32_t ui32SwitchCycles;
+    /* Cycles the tick interrupt took the processor away for, entry and exit included. The maximum
+     * also has the ticks that woke a task and switched to it. */
+    uint32_t ui32TickMin;
+    uint32_t ui32TickAverage;
+    uint32_t ui32TickMax;
+    uint32_t ui32Ticks;
+    /* Whether the hot paths ran from SRAM. */
+    bool bInSRAM;
+} Bench_Result;
+
+typedef struct
+{
+    /* Average cycles of a notification round trip from the calling task, which must have no floating point
+     * context, to a task without FPU access, to a task that used the FPU, and to the same task when it
+     * drops its floating point context with portRESET_FPU_CONTEXT() before it blocks. */
+    uint32_t ui32PlainCycles;
+    uint32_t ui32FPUCycles;
+    uint32_t ui32ResetCycles;
+} Bench_FPUResult;
+
+typedef struct
+{
+    /* Average cycles to format the same line into memory, with Print_snprintf() and with usnprintf()
+     * of TivaWare, whose digit loops are the ones of UARTprintf(). */
+    uint32_t ui32PrintCycles;
+    uint32_t ui32TivaWareCycles;
+    /* Characters in the line. */
+    uint32_t ui32Length;
+    /* Conversions checked against the output of printf(), those that differ, and the format of the first of them, or NULL. */
+    uint32_t ui32Checks;
+    uint32_t ui32Mismatches;
+    const char *pcMismatch;
+} Bench_FormatResult;
+
+typedef struct
+{
+    /* Average cycles of an uncontended take and give, of a fast mutex and of a kernel mutex. */
+    uint32_t ui32FastCycles;
+    uint32_t ui32KernelCycles;
+    /* Whether the caller holding the fast mutex inherited the priority of the benchmark task waiting
+     * for it, whether that task timed out, and whether the caller then had its own priority back. */
+    bool bInherited;
+    bool bTimedOut;
+    bool bRestored;
+    /* Whether a give with the benchmark task waiting handed the mutex over to it. */
+    bool bHandedOver;
+    /* Average cycles from that give to the take returning in the benchmark task, the switch to it
+     * included, with the fast mutex and with the kernel one. */
+    uint32_t ui32FastHandoffCycles;
+    uint32_t ui32KernelHandoffCycles;
+} Bench_MutexResult;
+
+typedef struct
+{
+    /* Average cycles to increment a counter with Atomic_Increment_u32(), and with the interrupts
+     * masked around it, the way atomic.h did before the port had exclusive access. */
+    uint32_t ui32AtomicCycles;
+    uint32_t ui32CriticalCycles;
+} Bench_AtomicResult;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Create the tasks switched to, they stay blocked until Bench_Run and Bench_FPU. */
+void Bench_Init (void);
+
+/* Switch ui32Rounds times to the benchmark task and back, then watch ui32Ticks ticks, blocks the
+ * calling task meanwhile. Must be called from a task below configMAX_PRIORITIES - 2. */
+void Bench_Run (uint32_t ui32Rounds, uint32_t ui32Ticks, Bench_Result *psResult);
+
+/* Notify each benchmark task ui32Rounds times, same restriction on the caller as Bench_Run. */
+void Bench_FPU (uint32_t ui32Rounds, Bench_FPUResult *psResult);
+
+/* Format the same line ui32Rounds times with each engine, with different numbers every time. */
+void Bench_Format (uint32_t ui32Rounds, Bench_FormatResult *psResult);
+
+/* Take and give each mutex ui32Rounds times, then hold the fast mutex while the benchmark task waits for
+ * it, once until it times out and once until it is given, then hand each mutex over ui32Rounds times.
+ * Same restriction on the caller as Bench_Run. */
+void Bench_Mutex (uint32_t ui32Rounds, Bench_MutexResult *psResult);
+
+/* Increment the same counter ui32Rounds times each way. */
+void Bench_Atomic (uint32_t ui32Rounds, Bench_AtomicResult *psResult);
+
+#endif /* BENCH_H */
@@ -0,0 +1,81 @@
+/*
+ * Consistent Overhead Byte Stuffing, see cobs.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+
+/* Header Files Includes.  */
+#include "cobs.h"
+
+/*****************************************************************************/
+/*                                COBS Functions                             */
+/*****************************************************************************/
+
+uint32_t Cobs_encode (const uint8_t *pui8Data, uint32_t ui32Length, uint8_t *pui8Encoded)
+{
+    /* Where the code of the current run goes, it is only known at the end of the run. */
+    uint32_t ui32Code = 0;
+    uint32_t ui32Out = 1;
+    uint8_t ui8Run = 1;
+    uint32_t i;
+
+    for (i = 0; i < ui32Length; i++)
+    {
+        if (pui8Data[i] != 0)
+        {
+            pui8Encoded[ui32Out++] = pui8Data[i];
+            ui8Run++;
+        }
+
+        /* A 0 ends the run, and so does a run of 254 bytes, unless the data ends with it. */
+        if ((pui8Data[i] == 0) || ((ui8Run == 0xFF) && (i != (ui32Length - 1))))
+        {
+            pui8Encoded[ui32Code] = ui8Run;
+            ui32Code = ui32Out++;
+            ui8Run = 1;
+        }
+    }
+    pui8Encoded[ui32Code] = ui8Run;
+
+    return ui32Out;
+}
+
+uint32_t Cobs_decode (uint8_t *pui8Block, uint32_t ui32Length)
+{
+    uint32_t ui32In = 0;
+    uint32_t ui32Out = 0;
+    uint8_t ui8Code, i;
+
+    while (ui32In < ui32Length)
+    {
+        ui8Code = pui8Block[ui32In++];
+
+        /* A 0 cannot be in the block, and a run cannot go past its end. */
+        if ((ui8Code == 0) || ((ui32In + ui8Code - 1) > ui32Length))
+        {
+            return 0;
+        }
+
+        for (i = 1; i < ui8Code; i++)
+        {
+            if (pui8Block[ui32In] == 0)
+            {
+                return 0;
+            }
+            pui8Block[ui32Out++] = pui8Block[ui32In++];
+        }
+
+        /* The 0 the run stood for, except after a full run and at the very end. */
+        if ((ui8Code != 0xFF) && (ui32In != ui32Length))
+        {
+            pui8Block[ui32Out++] = 0;
+        }
+    }
+
+    return ui32Out;
+}
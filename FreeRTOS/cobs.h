@@ -0,0 +1,37 @@
+/*
+ * Consistent Overhead Byte Stuffing. A block is encoded without any 0 byte,
+ * for at most one byte more every 254, so a 0 can delimit the frames of a
+ * stream, and a receiver that lost its place finds the next frame at the next
+ * 0. The delimiters are not part of the encoded block.
+ */
+
+#ifndef COBS_H
+#define COBS_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Most bytes ui32Length bytes are encoded into. */
+#define COBS_ENCODED_MAX(ui32Length)    ((ui32Length) + ((ui32Length) / 254) + 1)
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Encode ui32Length bytes of pui8Data into pui8Encoded, which must not overlap them and must hold
+ * COBS_ENCODED_MAX(ui32Length) bytes. Returns the number of bytes encoded. */
+uint32_t Cobs_encode (const uint8_t *pui8Data, uint32_t ui32Length, uint8_t *pui8Encoded);
+
+/* Decode ui32Length bytes in place, the data is never longer than the block it came from.
+ * Returns the number of bytes decoded, 0 if the block is not valid COBS. */
+uint32_t Cobs_decode (uint8_t *pui8Block, uint32_t ui32Length);
+
+#endif /* COBS_H */
@@ -0,0 +1,37 @@
+/*
+ * Table driven CRCs, one table lookup per byte:
+ *  - CRC-16/CCITT-FALSE, polynomial 0x1021, initial value 0xFFFF, not
+ *    reflected, check value 0x29B1,
+ *  - CRC-32 of Ethernet and zlib, polynomial 0x04C11DB7 reflected, initial
+ *    value and final XOR 0xFFFFFFFF, check value 0xCBF43926.
+ * Both can be computed in pieces, by passing the result of one call as the
+ * CRC of the next, starting from CRC16_INIT or CRC32_INIT.
+ */
+
+#ifndef CRC_H
+#define CRC_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define CRC16_INIT          0xFFFF
+#define CRC32_INIT          0x00000000
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+uint16_t Crc_16 (uint16_t ui16Crc, const uint8_t *pui8Data, uint32_t ui32Length);
+
+/* The final XOR is done on every call, so CRC32_INIT is 0 and the pieces chain. */
+uint32_t Crc_32 (uint32_t ui32Crc, const uint8_t *pui8Data, uint32_t ui32Length);
+
+#endif /* CRC_H */
@@ -0,0 +1,168 @@
+/*
+ * Critical section and scheduler suspension statistics, see critstats.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "critstats.h"
+
+/* Remove the whole file if the statistics are not being gathered. */
+#if ( configUSE_CRITICAL_STATS == 1 )
+
+/* uxCritStatsGetTop() keeps track of the sites copied in a 32 bit mask. */
+    #if ( configCRITICAL_STATS_SITES > 32 )
+        #error configCRITICAL_STATS_SITES must not be more than 32
+    #endif
+
+/* Where and when the region of each kind currently held was entered.  Only one
+ * of each can be held at a time, nested regions are not timed on their own. */
+    typedef struct xCRIT_STATS_PENDING
+    {
+        const char * pcFile;
+        uint32_t ulLine;
+        uint32_t ulStart;
+    } CritStatsPending_t;
+
+    static CritStatsPending_t xPending[ 2 ] = { { NULL, 0, 0 }, { NULL, 0, 0 } };
+    static CritStatsSite_t xSites[ configCRITICAL_STATS_SITES ];
+
+/*-----------------------------------------------------------*/
+
+    void vCritStatsEnter( uint8_t ucKind,
+                          const char * pcFile,
+                          uint32_t ulLine )
+    {
+        /* Only note the site, the search is done on exit after the time is
+         * taken, so it is not counted. */
+        xPending[ ucKind ].pcFile = pcFile;
+        xPending[ ucKind ].ulLine = ulLine;
+        xPending[ ucKind ].ulStart = configCRITICAL_STATS_GET_CYCLES();
+    }
+/*-----------------------------------------------------------*/
+
+    void vCritStatsExit( uint8_t ucKind )
+    {
+        uint32_t ulCycles = configCRITICAL_STATS_GET_CYCLES() - xPending[ ucKind ].ulStart;
+        const char * pcFile = xPending[ ucKind ].pcFile;
+        uint32_t ulLine = xPending[ ucKind ].ulLine;
+        uint32_t ulBucket, ulLimit;
+        UBaseType_t x;
+
+        /* A region entered without going through the macros, such as a direct
+         * call to vPortEnterCritical(), has no site. */
+        if( pcFile == NULL )
+        {
+            return;
+        }
+
+        xPending[ ucKind ].pcFile = NULL;
+
+        for( x = 0; x < configCRITICAL_STATS_SITES; x++ )
+        {
+            if( xSites[ x ].pcFile == NULL )
+            {
+                /* First time this site is seen. */
+                xSites[ x ].pcFile = pcFile;
+                xSites[ x ].ulLine = ulLine;
+                xSites[ x ].ucKind = ucKind;
+                break;
+            }
+
+            /* The same __FILE__ is the same string in a given file, so
+             * comparing the pointers is enough. */
+            if( ( xSites[ x ].pcFile == pcFile ) && ( xSites[ x ].ulLine == ulLine ) )
+            {
+                break;
+            }
+        }
+
+        if( x == configCRITICAL_STATS_SITES )
+        {
+            /* The table is full. */
+            return;
+        }
+
+        for( ulBucket = 0, ulLimit = 64; ulBucket < ( critstatsBUCKETS - 1 ); ulBucket++, ulLimit <<= 2 )
+        {
+            if( ulCycles < ulLimit )
+            {
+                break;
+            }
+        }
+
+        xSites[ x ].ulCount++;
+        xSites[ x ].ulBuckets[ ulBucket ]++;
+
+        if( ulCycles > xSites[ x ].ulMaxCycles )
+        {
+            xSites[ x ].ulMaxCycles = ulCycles;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxCritStatsGetTop( CritStatsSite_t * pxSites,
+                                   UBaseType_t uxMaxSites )
+    {
+        UBaseType_t uxCopied, x, uxBest;
+        uint32_t ulCopiedSites = 0;
+
+        /* Only tasks update the statistics, so keeping the other tasks out is
+         * enough to copy them in one piece, and does not hold off interrupts
+         * for as long as the copy takes. */
+        vTaskSuspendAll();
+        {
+            for( uxCopied = 0; uxCopied < uxMaxSites; uxCopied++ )
+            {
+                uxBest = configCRITICAL_STATS_SITES;
+
+                /* The longest site not copied yet. */
+                for( x = 0; x < configCRITICAL_STATS_SITES; x++ )
+                {
+                    if( ( xSites[ x ].pcFile != NULL ) && ( ( ulCopiedSites & ( 1UL << x ) ) == 0 ) )
+                    {
+                        if( ( uxBest == configCRITICAL_STATS_SITES ) || ( xSites[ x ].ulMaxCycles > xSites[ uxBest ].ulMaxCycles ) )
+                        {
+                            uxBest = x;
+                        }
+                    }
+                }
+
+                if( uxBest == configCRITICAL_STATS_SITES )
+                {
+                    /* Every site seen has been copied. */
+                    break;
+                }
+
+                pxSites[ uxCopied ] = xSites[ uxBest ];
+                ulCopiedSites |= ( 1UL << uxBest );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCopied;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCritStatsReset( void )
+    {
+        UBaseType_t x, y;
+
+        vTaskSuspendAll();
+        {
+            for( x = 0; x < configCRITICAL_STATS_SITES; x++ )
+            {
+                xSites[ x ].pcFile = NULL;
+                xSites[ x ].ulLine = 0;
+                xSites[ x ].ulCount = 0;
+                xSites[ x ].ulMaxCycles = 0;
+
+                for( y = 0; y < critstatsBUCKETS; y++ )
+                {
+                    xSites[ x ].ulBuckets[ y ] = 0;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* configUSE_CRITICAL_STATS */
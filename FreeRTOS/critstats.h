@@ -0,0 +1,106 @@
+/*
+ * Critical section and scheduler suspension statistics.  When
+ * configUSE_CRITICAL_STATS is set to 1 in FreeRTOSConfig.h, every outermost
+ * taskENTER_CRITICAL()/taskEXIT_CRITICAL() pair and every outermost
+ * vTaskSuspendAll()/xTaskResumeAll() pair is timed, and the time is charged to
+ * the file and line that entered it.  Critical sections bound how late an
+ * interrupt can be taken, scheduler suspensions how late a task can be
+ * switched in.
+ *
+ * When configUSE_CRITICAL_STATS is 0 (the default) the kernel calls nothing
+ * here and taskENTER_CRITICAL() and vTaskSuspendAll() are what they always
+ * were.
+ *
+ * Only regions entered by tasks are timed, the interrupt safe
+ * taskENTER_CRITICAL_FROM_ISR() is not.
+ */
+
+#ifndef CRIT_STATS_H
+#define CRIT_STATS_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include critstats.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The number of different call sites that can be told apart, the regions
+ * entered from any more are not counted. */
+#ifndef configCRITICAL_STATS_SITES
+    #define configCRITICAL_STATS_SITES    16
+#endif
+
+/* A free running cycle counter, the DWT one on this port. */
+#ifndef configCRITICAL_STATS_GET_CYCLES
+    #define configCRITICAL_STATS_GET_CYCLES()    portGET_RUN_TIME_COUNTER_VALUE()
+#endif
+
+/* The kinds of region timed. */
+#define critstatsCRITICAL    ( ( uint8_t ) 0 )
+#define critstatsSUSPEND     ( ( uint8_t ) 1 )
+
+/* Bucket n of the histogram counts the regions that lasted less than
+ * 64 << ( 2 * n ) cycles, the last bucket all the longer ones. */
+#define critstatsBUCKETS     8
+
+typedef struct xCRIT_STATS_SITE
+{
+    const char * pcFile;                    /*< __FILE__ where the region was entered, NULL for an unused site. */
+    uint32_t ulLine;                        /*< __LINE__ where the region was entered. */
+    uint8_t ucKind;                         /*< critstatsCRITICAL or critstatsSUSPEND. */
+    uint32_t ulCount;                       /*< The number of times the region was entered. */
+    uint32_t ulMaxCycles;                   /*< The longest the region lasted. */
+    uint32_t ulBuckets[ critstatsBUCKETS ]; /*< Histogram of how long the region lasted. */
+} CritStatsSite_t;
+
+/*
+ * Called by the kernel when the outermost region of the kind is entered, and
+ * when it is left.  Both run with the region already held, so nothing else
+ * can update the statistics meanwhile.
+ */
+void vCritStatsEnter( uint8_t ucKind,
+                      const char * pcFile,
+                      uint32_t ulLine );
+void vCritStatsExit( uint8_t ucKind );
+
+/**
+ * critstats. h
+ * <pre>
+ * UBaseType_t uxCritStatsGetTop( CritStatsSite_t * pxSites, UBaseType_t uxMaxSites );
+ * </pre>
+ *
+ * Copy the statistics of the call sites with the longest regions, longest
+ * first, to print them.
+ *
+ * @param pxSites Array of uxMaxSites sites the statistics are copied to.
+ *
+ * @param uxMaxSites The number of sites wanted.
+ *
+ * @return The number of sites copied, fewer than uxMaxSites if fewer sites
+ * have been seen.
+ */
+UBaseType_t uxCritStatsGetTop( CritStatsSite_t * pxSites,
+                               UBaseType_t uxMaxSites );
+
+/**
+ * critstats. h
+ * <pre>
+ * void vCritStatsReset( void );
+ * </pre>
+ *
+ * Forget everything measured so far, to measure one part of the application
+ * on its own.
+ */
+void vCritStatsReset( void );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* CRIT_STATS_H */
@@ -58,6 +58,8 @@ typedef struct corCoRoutineControlBlock
     UBaseType_t uxPriority;      /*< The priority of the co-routine in relation to other co-routines. */
     UBaseType_t uxIndex;         /*< Used to distinguish between co-routines when multiple co-routines use the same co-routine function. */
     uint16_t uxState;            /*< Used internally by the co-routine implementation. */
+    uint8_t ucNotifyState;       /*< Whether the co-routine is waiting for, or has received, a notification. */
+    uint32_t ulNotifiedValue;    /*< Bits set by xCoRoutineNotify() that crNOTIFY_WAIT() has not taken yet. */
 } CRCB_t;                        /* Co-routine control block.  Note must be identical in size down to uxPriority with TCB_t. */
 
 /**
@@ -137,6 +139,50 @@ BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode,
                              UBaseType_t uxPriority,
                              UBaseType_t uxIndex );
 
+/**
+ * croutine. h
+ * <pre>
+ * CoRoutineHandle_t xCoRoutineCreateStatic(
+ *                               crCOROUTINE_CODE pxCoRoutineCode,
+ *                               UBaseType_t uxPriority,
+ *                               UBaseType_t uxIndex,
+ *                               CRCB_t *pxCoRoutineBuffer
+ *                             );
+ * </pre>
+ *
+ * As xCoRoutineCreate(), but the co-routine control block is provided by the
+ * application instead of being allocated from the heap.  Co-routines share
+ * the stack of the task that calls vCoRoutineSchedule(), so the control block
+ * is all the RAM a co-routine needs, and an array of them avoids the heap
+ * block overhead for every one of them.
+ *
+ * @param pxCoRoutineBuffer Must point to a CRCB_t that stays valid for as long
+ * as the co-routine exists.
+ *
+ * @return The handle of the co-routine, to be used with xCoRoutineNotify().
+ *
+ * Example usage:
+ * <pre>
+ * static CRCB_t xLedCoRoutines[ 200 ];
+ *
+ * void vOtherFunction( void )
+ * {
+ * UBaseType_t uxIndex;
+ *
+ *   for( uxIndex = 0; uxIndex < 200; uxIndex++ )
+ *   {
+ *       xCoRoutineCreateStatic( vFlashCoRoutine, 0, uxIndex, &( xLedCoRoutines[ uxIndex ] ) );
+ *   }
+ * }
+ * </pre>
+ * \defgroup xCoRoutineCreateStatic xCoRoutineCreateStatic
+ * \ingroup Tasks
+ */
+CoRoutineHandle_t xCoRoutineCreateStatic( crCOROUTINE_CODE pxCoRoutineCode,
+                                          UBaseType_t uxPriority,
+                                          UBaseType_t uxIndex,
+                                          CRCB_t * pxCoRoutineBuffer );
+
 
 /**
  * croutine. h
@@ -723,6 +769,107 @@ void vCoRoutineSchedule( void );
 #define crQUEUE_RECEIVE_FROM_ISR( pxQueue, pvBuffer, pxCoRoutineWoken ) \
     xQueueCRReceiveFromISR( ( pxQueue ), ( pvBuffer ), ( pxCoRoutineWoken ) )
 
+/**
+ * croutine. h
+ * <pre>
+ * crNOTIFY_WAIT(
+ *                CoRoutineHandle_t xHandle,
+ *                TickType_t xTicksToWait,
+ *                uint32_t *pulNotificationValue,
+ *                BaseType_t *pxResult
+ *              )
+ * </pre>
+ *
+ * The co-routine equivalent of xTaskNotifyWait().  Waits for another
+ * co-routine, a task or an ISR to notify this co-routine with
+ * xCoRoutineNotify() or xCoRoutineNotifyFromISR(), then clears the
+ * notification bits.  Notifications sent while the co-routine was not waiting
+ * are kept, so none is lost.
+ *
+ * crNOTIFY_WAIT can only be called from the co-routine function itself - not
+ * from within a function called by the co-routine function.  This is because
+ * co-routines do not maintain their own stack.
+ *
+ * @param xHandle The handle of the calling co-routine.  This is the xHandle
+ * parameter of the co-routine function.
+ *
+ * @param xTicksToWait The number of ticks to wait for a notification.  Zero
+ * returns at once.
+ *
+ * @param pulNotificationValue Receives the bits that were set by all the
+ * notifications since the last call.  Can be NULL.
+ *
+ * @param pxResult Set to pdPASS if a notification was received, or pdFAIL if
+ * none arrived before xTicksToWait expired.
+ *
+ * Example usage:
+ * <pre>
+ * // A sensor co-routine that is notified with one bit per sample ready.
+ * void vSensorCoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex )
+ * {
+ * static uint32_t ulBits;
+ * static BaseType_t xResult;
+ *
+ *   crSTART( xHandle );
+ *
+ *   for( ;; )
+ *   {
+ *       crNOTIFY_WAIT( xHandle, 100, &ulBits, &xResult );
+ *
+ *       if( xResult == pdPASS )
+ *       {
+ *           vProcessSamples( ulBits );
+ *       }
+ *   }
+ *
+ *   crEND();
+ * }
+ * </pre>
+ * \defgroup crNOTIFY_WAIT crNOTIFY_WAIT
+ * \ingroup Tasks
+ */
+#define crNOTIFY_WAIT( xHandle, xTicksToWait, pulNotificationValue, pxResult )                  \
+    {                                                                                           \
+        *( pxResult ) = xCoRoutineNotifyWait( ( xTicksToWait ), ( pulNotificationValue ) );     \
+        if( *( pxResult ) == errQUEUE_BLOCKED )                                                 \
+        {                                                                                       \
+            crSET_STATE0( ( xHandle ) );                                                        \
+            *( pxResult ) = xCoRoutineNotifyWait( 0, ( pulNotificationValue ) );                \
+        }                                                                                       \
+    }
+
+/**
+ * croutine. h
+ * <pre>
+ * BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine, uint32_t ulValue );
+ * BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine, uint32_t ulValue );
+ * </pre>
+ *
+ * Set the bits ulValue in the notification value of a co-routine, and ready
+ * it if it is blocked in crNOTIFY_WAIT().  xCoRoutineNotify() can be called
+ * from tasks and co-routines, xCoRoutineNotifyFromISR() from interrupts.
+ *
+ * @return pdTRUE if a co-routine was readied.
+ * \defgroup xCoRoutineNotify xCoRoutineNotify
+ * \ingroup Tasks
+ */
+BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine,
+                             uint32_t ulValue );
+BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine,
+                                    uint32_t ulValue );
+
+/*
+ * This function is intended for internal use by the co-routine macros only.
+ * The macro nature of the co-routine implementation requires that the
+ * prototype appears here.  The function should not be used by application
+ * writers.
+ *
+ * Takes the notification of the current co-routine, or places it in the
+ * appropriate delayed list to wait for one.
+ */
+BaseType_t xCoRoutineNotifyWait( TickType_t xTicksToWait,
+                                 uint32_t * pulNotificationValue );
+
 /*
  * This function is intended for internal use by the co-routine macros only.
  * The macro nature of the co-routine implementation requires that the
@@ -0,0 +1,225 @@
+/*
+ * Mutex with an uncontended fast path, see fastmutex.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "fastmutex.h"
+
+/* Remove the whole file if mutexes are not being used. */
+#if ( configUSE_MUTEXES == 1 )
+
+/* Set in ulLock by a task that is about to block, so the holder knows it has
+ * to go through the kernel to give the mutex.  Task handles are word aligned
+ * so the bit is never part of one. */
+    #define fmCONTENDED_BIT    ( ( uint32_t ) 1 )
+
+/*
+ * Take or give the mutex through the kernel.  Both are called inside a
+ * critical section, so no other task can touch ulLock meanwhile and it can
+ * be accessed directly.
+ */
+    static BaseType_t prvTakeContended( FastMutex_t * pxMutex,
+                                        TickType_t xTicksToWait );
+    static BaseType_t prvGiveContended( FastMutex_t * pxMutex );
+
+/*-----------------------------------------------------------*/
+
+    void vFastMutexInit( FastMutex_t * pxMutex )
+    {
+        configASSERT( pxMutex );
+
+        pxMutex->ulLock = 0;
+        vListInitialise( &( pxMutex->xTasksWaiting ) );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xFastMutexTake( FastMutex_t * pxMutex,
+                               TickType_t xTicksToWait )
+    {
+        uint32_t ulSelf = ( uint32_t ) xTaskGetCurrentTaskHandle();
+
+        configASSERT( pxMutex );
+        configASSERT( ( ulSelf & fmCONTENDED_BIT ) == 0 );
+
+        /* The mutex is free and nobody waits for it, take it with no
+         * critical section at all.  It is counted with the mutexes held like
+         * a kernel one, for the priority inheritance to know when the holder
+         * holds nothing else. */
+        if( xPortCompareAndSwap( &( pxMutex->ulLock ), 0, ulSelf ) != pdFALSE )
+        {
+            ( void ) pvTaskIncrementMutexHeldCount();
+            return pdTRUE;
+        }
+
+        return prvTakeContended( pxMutex, xTicksToWait );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xFastMutexGive( FastMutex_t * pxMutex )
+    {
+        uint32_t ulSelf = ( uint32_t ) xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn;
+
+        configASSERT( pxMutex );
+
+        /* Nobody is waiting, release the mutex with no critical section.  The
+         * holder may still run at a priority inherited through this mutex from
+         * a task that timed out while it held others, or through another one,
+         * it is given back once the last mutex held is. */
+        if( xPortCompareAndSwap( &( pxMutex->ulLock ), ulSelf, 0 ) != pdFALSE )
+        {
+            if( xTaskDecrementMutexHeldCount() != pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    if( xTaskPriorityDisinherit( ( TaskHandle_t ) ulSelf ) != pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvGiveContended( pxMutex );
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTakeContended( FastMutex_t * pxMutex,
+                                        TickType_t xTicksToWait )
+    {
+        uint32_t ulSelf = ( uint32_t ) xTaskGetCurrentTaskHandle();
+        uint32_t ulHolder;
+        UBaseType_t uxHighestWaitingPriority;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        vTaskInternalSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                ulHolder = pxMutex->ulLock & ~fmCONTENDED_BIT;
+
+                if( ulHolder == 0 )
+                {
+                    /* The mutex was given while the bit was set, or the tasks
+                     * that set it timed out.  Keep the bit if any task is
+                     * still waiting, so the next give wakes it. */
+                    if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+                    {
+                        pxMutex->ulLock = ulSelf | fmCONTENDED_BIT;
+                    }
+                    else
+                    {
+                        pxMutex->ulLock = ulSelf;
+                    }
+
+                    ( void ) pvTaskIncrementMutexHeldCount();
+                    taskEXIT_CRITICAL();
+                    return pdTRUE;
+                }
+
+                if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+                {
+                    /* Timed out, lower the priority the holder may have
+                     * inherited from this task to the highest one still
+                     * waiting, as xQueueSemaphoreTake() does.  That is only
+                     * done if this is the one mutex the holder holds, so the
+                     * fast ones are counted in its mutexes held. */
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        if( listCURRENT_LIST_LENGTH( &( pxMutex->xTasksWaiting ) ) > 0U )
+                        {
+                            uxHighestWaitingPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxMutex->xTasksWaiting ) );
+                        }
+                        else
+                        {
+                            uxHighestWaitingPriority = tskIDLE_PRIORITY;
+                        }
+
+                        vTaskPriorityDisinheritAfterTimeout( ( TaskHandle_t ) ulHolder, uxHighestWaitingPriority );
+                    }
+
+                    taskEXIT_CRITICAL();
+                    return pdFALSE;
+                }
+
+                /* Make the holder take the kernel path when it gives the
+                 * mutex.  A compare and swap the holder is in the middle of
+                 * fails, as the critical section was entered since its
+                 * ldrex, and it retries seeing the bit. */
+                pxMutex->ulLock = ulHolder | fmCONTENDED_BIT;
+
+                xInheritanceOccurred |= xTaskPriorityInherit( ( TaskHandle_t ) ulHolder );
+                vTaskPlaceOnEventList( &( pxMutex->xTasksWaiting ), xTicksToWait );
+
+                /* The switch happens as soon as the critical section is
+                 * left, the loop then runs again once this task is woken by
+                 * a give or by the timeout. */
+                portYIELD_WITHIN_API();
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvGiveContended( FastMutex_t * pxMutex )
+    {
+        uint32_t ulSelf = ( uint32_t ) xTaskGetCurrentTaskHandle();
+        BaseType_t xYieldRequired = pdFALSE;
+
+        if( ( pxMutex->ulLock & ~fmCONTENDED_BIT ) != ulSelf )
+        {
+            /* Only the holder can give the mutex. */
+            return pdFALSE;
+        }
+
+        /* The mutex is left free, the woken task takes it when it runs.  The
+         * bit stays set while other tasks are still waiting. */
+        if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+        {
+            if( xTaskRemoveFromEventList( &( pxMutex->xTasksWaiting ) ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+        }
+
+        if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+        {
+            pxMutex->ulLock = fmCONTENDED_BIT;
+        }
+        else
+        {
+            pxMutex->ulLock = 0;
+        }
+
+        /* The priority inherited from the waiting tasks is dropped with the
+         * count of mutexes held, unless the task still holds another mutex. */
+        if( xTaskPriorityDisinherit( ( TaskHandle_t ) ulSelf ) != pdFALSE )
+        {
+            xYieldRequired = pdTRUE;
+        }
+
+        /* The switch happens when the critical section is left. */
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+
+        return pdTRUE;
+    }
+
+#endif /* configUSE_MUTEXES == 1 */
@@ -0,0 +1,79 @@
+/*
+ * Mutex with an uncontended fast path.  Taking a free mutex and giving one
+ * nobody waits for is a single ldrex/strex compare and swap, without a
+ * critical section.  Only when the mutex is contended do the take and give
+ * go through the kernel, with the same priority inheritance as a mutex
+ * created with xSemaphoreCreateMutex().
+ *
+ * Fast mutexes can only be used from tasks, never from interrupts, and are
+ * not recursive.  They are counted with the kernel mutexes a task holds, so a
+ * task that inherited a priority keeps it until it gives the last mutex it
+ * holds of either kind, and gets its base priority back when a task that gave
+ * it its priority times out and the mutex was the only one held.
+ */
+
+#ifndef FAST_MUTEX_H
+#define FAST_MUTEX_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include fastmutex.h"
+#endif
+
+#include "list.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+typedef struct xFAST_MUTEX
+{
+    volatile uint32_t ulLock; /*< 0 when free, otherwise the handle of the holder, ORed with fmCONTENDED_BIT when tasks may be waiting. */
+    List_t xTasksWaiting;     /*< Tasks blocked on the mutex, in priority order. */
+} FastMutex_t;
+
+/**
+ * fastmutex. h
+ * <pre>
+ * void vFastMutexInit( FastMutex_t * pxMutex );
+ * </pre>
+ *
+ * Initialise a fast mutex, it is created free.  The mutex is provided by the
+ * application so nothing is allocated.
+ */
+void vFastMutexInit( FastMutex_t * pxMutex );
+
+/**
+ * fastmutex. h
+ * <pre>
+ * BaseType_t xFastMutexTake( FastMutex_t * pxMutex, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Same as xSemaphoreTake() on a mutex.
+ *
+ * @return pdTRUE if the mutex was obtained, pdFALSE if xTicksToWait expired.
+ */
+BaseType_t xFastMutexTake( FastMutex_t * pxMutex,
+                           TickType_t xTicksToWait );
+
+/**
+ * fastmutex. h
+ * <pre>
+ * BaseType_t xFastMutexGive( FastMutex_t * pxMutex );
+ * </pre>
+ *
+ * Same as xSemaphoreGive() on a mutex, must be called by the holder.
+ *
+ * @return pdTRUE if the mutex was released, pdFALSE if the calling task was
+ * not holding it.
+ */
+BaseType_t xFastMutexGive( FastMutex_t * pxMutex );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* FAST_MUTEX_H */
@@ -0,0 +1,218 @@
+/*
+ * Serial gateway, see gateway.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "gateway.h"
+#include "serial.h"
+
+/* TivaWare includes.  */
+#include "inc/hw_memmap.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/gpio.h"
+#include "driverlib/uart.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Above the console, with the other tasks that have to keep up with the hardware. */
+#define GATEWAY_TASK_PRIORITY      (configMAX_PRIORITIES - 2)
+#define STACK_SIZE_GATEWAY         200
+
+/* Bytes moved from one ring to the other at a time, on the stack of the task. */
+#define GATEWAY_CHUNK              64
+
+#define GATEWAY_CONFIG             (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE)
+
+/* The peer of a port, the other of its pair. */
+#define GATEWAY_PEER(i)            ((i) ^ 1)
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    uint32_t ui32Port;
+    uint32_t ui32GPIOPeriph;
+    uint32_t ui32GPIOBase;
+    uint32_t ui32RxPinConfig;
+    uint32_t ui32TxPinConfig;
+    uint8_t ui8Pins;
+} Gateway_Port;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* Pins the LaunchPad leaves free, away from the console, the JTAG port on PC0-PC3 and the USB port on PD4/PD5. */
+static const Gateway_Port xGatewayPorts[GATEWAY_PORTS] =
+{
+    { 1, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PB0_U1RX, GPIO_PB1_U1TX, GPIO_PIN_0 | GPIO_PIN_1 },
+    { 3, SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE, GPIO_PC6_U3RX, GPIO_PC7_U3TX, GPIO_PIN_6 | GPIO_PIN_7 },
+    { 4, SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE, GPIO_PC4_U4RX, GPIO_PC5_U4TX, GPIO_PIN_4 | GPIO_PIN_5 },
+    { 7, SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PE0_U7RX, GPIO_PE1_U7TX, GPIO_PIN_0 | GPIO_PIN_1 }
+};
+
+static uint8_t ui8GatewayRx[GATEWAY_PORTS][GATEWAY_RING_SIZE];
+static uint8_t ui8GatewayTx[GATEWAY_PORTS][GATEWAY_RING_SIZE];
+
+/* Only written by the gateway task. */
+static volatile uint32_t ui32GatewayWakeups = 0;
+static volatile uint32_t ui32GatewayForwarded[GATEWAY_PORTS];
+
+/*****************************************************************************/
+/*                              Gateway Functions                            */
+/*****************************************************************************/
+
+/* Move what port i has received to its peer, as much as the peer has room for.
+ * Returns true if bytes are left behind for want of room. */
+static bool Gateway_forward (uint32_t i)
+{
+    uint32_t ui32From = xGatewayPorts[i].ui32Port;
+    uint32_t ui32To = xGatewayPorts[GATEWAY_PEER (i)].ui32Port;
+    uint8_t ui8Chunk[GATEWAY_CHUNK];
+    uint32_t ui32Length, ui32Space;
+
+    while (1)
+    {
+        ui32Length = Serial_Available (ui32From);
+        ui32Space = Serial_Space (ui32To);
+        if (ui32Length > ui32Space)
+        {
+            ui32Length = ui32Space;
+        }
+        if (ui32Length > GATEWAY_CHUNK)
+        {
+            ui32Length = GATEWAY_CHUNK;
+        }
+        if (ui32Length == 0)
+        {
+            break;
+        }
+
+        ui32Length = Serial_Read (ui32From, ui8Chunk, ui32Length);
+        Serial_Write (ui32To, ui8Chunk, ui32Length);
+        ui32GatewayForwarded[i] += ui32Length;
+    }
+
+    return (Serial_Available (ui32From) != 0);
+}
+
+/* What to wait for on port i with the ports in ui32Blocked left with bytes their peer had no room
+ * for: its bytes unless it is one of them, and room if its peer is. */
+static uint32_t Gateway_events (uint32_t i, uint32_t ui32Blocked)
+{
+    uint32_t ui32Events = 0;
+
+    if ((ui32Blocked & (1UL << i)) == 0)
+    {
+        ui32Events |= SERIAL_EVENT_RX;
+    }
+    if ((ui32Blocked & (1UL << GATEWAY_PEER (i))) != 0)
+    {
+        ui32Events |= SERIAL_EVENT_TX;
+    }
+
+    return ui32Events;
+}
+
+static void Gateway_Task (void *pvParameters)
+{
+    /* Ports with bytes their peer had no room for, one bit per port. */
+    uint32_t ui32Blocked = 0;
+    uint32_t ui32WasBlocked, ui32Ready, i;
+
+    /* This is an I/O task that never uses floats, so drop its FPU access to keep its context switches cheap. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
+    for (i = 0; i < GATEWAY_PORTS; i++)
+    {
+        Serial_SelectAdd (xGatewayPorts[i].ui32Port, SERIAL_EVENT_RX);
+    }
+
+    while (1)
+    {
+        ui32Ready = Serial_Select (portMAX_DELAY);
+        ui32GatewayWakeups++;
+
+        /* A port is forwarded when it has bytes, or when its peer has room for the bytes it was left with. */
+        ui32WasBlocked = ui32Blocked;
+        for (i = 0; i < GATEWAY_PORTS; i++)
+        {
+            if ((ui32Ready & (SERIAL_SELECT_RX (xGatewayPorts[i].ui32Port) |
+                              SERIAL_SELECT_TX (xGatewayPorts[GATEWAY_PEER (i)].ui32Port))) == 0)
+            {
+                continue;
+            }
+
+            if (Gateway_forward (i) == true)
+            {
+                ui32Blocked |= (1UL << i);
+            }
+            else
+            {
+                ui32Blocked &= ~(1UL << i);
+            }
+        }
+
+        /* Reading a blocked port would only find bytes there is no room for, so it is waited on for the
+         * room of its peer instead, until the peer has sent half of what it holds. */
+        for (i = 0; i < GATEWAY_PORTS; i++)
+        {
+            if (Gateway_events (i, ui32Blocked) != Gateway_events (i, ui32WasBlocked))
+            {
+                Serial_SelectAdd (xGatewayPorts[i].ui32Port, Gateway_events (i, ui32Blocked));
+            }
+        }
+    }
+}
+
+bool Gateway_Init (void)
+{
+    uint32_t i;
+
+    for (i = 0; i < GATEWAY_PORTS; i++)
+    {
+        /* Enable Clock for the GPIO port, and give both pins to the UART. */
+        SysCtlPeripheralEnable (xGatewayPorts[i].ui32GPIOPeriph);
+        while (!SysCtlPeripheralReady (xGatewayPorts[i].ui32GPIOPeriph)) {}
+        GPIOPinConfigure (xGatewayPorts[i].ui32RxPinConfig);
+        GPIOPinConfigure (xGatewayPorts[i].ui32TxPinConfig);
+        GPIOPinTypeUART (xGatewayPorts[i].ui32GPIOBase, xGatewayPorts[i].ui8Pins);
+
+        if (Serial_Open (xGatewayPorts[i].ui32Port, GATEWAY_BAUD, GATEWAY_CONFIG,
+                         ui8GatewayRx[i], GATEWAY_RING_SIZE, ui8GatewayTx[i], GATEWAY_RING_SIZE) == false)
+        {
+            return false;
+        }
+    }
+
+    return (xTaskCreate (Gateway_Task, "Task_GATEWAY", STACK_SIZE_GATEWAY, NULL, GATEWAY_TASK_PRIORITY, NULL) == pdPASS);
+}
+
+void Gateway_getStats (Gateway_Stats *psStats)
+{
+    uint32_t i;
+
+    psStats->ui32Wakeups = ui32GatewayWakeups;
+    for (i = 0; i < GATEWAY_PORTS; i++)
+    {
+        psStats->ui32Port[i] = xGatewayPorts[i].ui32Port;
+        psStats->ui32Forwarded[i] = ui32GatewayForwarded[i];
+    }
+}
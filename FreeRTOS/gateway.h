@@ -0,0 +1,59 @@
+/*
+ * Serial gateway, what one UART receives the other sends, both ways, for two
+ * pairs of ports: UART1 on PB0/PB1 with UART3 on PC6/PC7, and UART4 on
+ * PC4/PC5 with UART7 on PE0/PE1, at GATEWAY_BAUD.
+ *
+ * A single task serves the four ports in both directions, it waits for all
+ * of them at once in Serial_Select(). A port whose peer has no room left
+ * stops being read until the peer has sent half its ring, then the bytes
+ * left in its receive ring go first. The UARTs have no flow control, what
+ * arrives with the receive ring full is dropped and counted.
+ */
+
+#ifndef GATEWAY_H
+#define GATEWAY_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Ports bridged, 0 with 1 and 2 with 3. */
+#define GATEWAY_PORTS              4
+
+#define GATEWAY_BAUD               115200
+
+/* Each ring holds 22 ms at GATEWAY_BAUD, more than the task takes to get to it. */
+#define GATEWAY_RING_SIZE          256
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    /* Returns of Serial_Select(). */
+    uint32_t ui32Wakeups;
+    /* UART of each port, and the bytes forwarded from it to its peer. */
+    uint32_t ui32Port [GATEWAY_PORTS];
+    uint32_t ui32Forwarded [GATEWAY_PORTS];
+} Gateway_Stats;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Set up the pins, open the ports and create the task. Returns false if a port could not be opened,
+ * the task is only created when all of them are. */
+bool Gateway_Init (void);
+
+void Gateway_getStats (Gateway_Stats *psStats);
+
+#endif /* GATEWAY_H */
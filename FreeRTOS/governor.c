@@ -0,0 +1,147 @@
+/*
+ * Load adaptive clock governor, switches the MCU between the PLL clock levels
+ * depending on how much of the time the idle task gets to run.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "clock.h"
+#include "governor.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* Run mode current of every clock level, in the order of Clock_Level. */
+static const uint32_t ulGovernorCurrentUA [CLOCK_LEVELS] =
+{
+    GOVERNOR_CURRENT_80MHZ_UA,
+    GOVERNOR_CURRENT_40MHZ_UA,
+    GOVERNOR_CURRENT_16MHZ_UA
+};
+
+/* Statistics handed out by Governor_getStats. */
+static Governor_Stats xGovernorStats;
+
+/* Totals the energy estimate is computed from. */
+static uint64_t ullGovernorEnergyMicroJoules = 0;
+static uint64_t ullGovernorBusyCycles = 0;
+
+/*****************************************************************************/
+/*                              Governor Functions                           */
+/*****************************************************************************/
+
+static void Governor_switch (Clock_Level eLevel)
+{
+    uint32_t ui32SlowestHz;
+    uint32_t ui32Start;
+    uint32_t ui32Cycles;
+
+    /* The cycle counter runs at the old clock before the switch and at the new one after it,
+     * so convert using the slower of the two, which gives an upper bound of the latency. */
+    ui32SlowestHz = Clock_getLevelFrequency (eLevel);
+    if (Clock_getFrequency () < ui32SlowestHz)
+    {
+        ui32SlowestHz = Clock_getFrequency ();
+    }
+
+    ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+    if (Clock_setLevel (eLevel) == false)
+    {
+        return;
+    }
+    ui32Cycles = portGET_RUN_TIME_COUNTER_VALUE () - ui32Start;
+
+    taskENTER_CRITICAL ();
+    {
+        xGovernorStats.ui32Switches++;
+        xGovernorStats.ui32LastSwitchUs = ui32Cycles / (ui32SlowestHz / 1000000);
+        if (xGovernorStats.ui32LastSwitchUs > xGovernorStats.ui32MaxSwitchUs)
+        {
+            xGovernorStats.ui32MaxSwitchUs = xGovernorStats.ui32LastSwitchUs;
+        }
+    }
+    taskEXIT_CRITICAL ();
+}
+
+void Governor_Task (void * pvParameters)
+{
+    TickType_t xLastWakeTime;
+    uint32_t ui32LastTotal, ui32LastIdle;
+    uint32_t ui32Total, ui32Idle, ui32Load;
+    Clock_Level eLevel;
+
+    /* The governor only does integer arithmetic. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
+    ui32LastTotal = portGET_RUN_TIME_COUNTER_VALUE ();
+    ui32LastIdle  = ulTaskGetIdleRunTimeCounter ();
+    xLastWakeTime = xTaskGetTickCount ();
+
+    while (1)
+    {
+        vTaskDelayUntil (&xLastWakeTime, pdMS_TO_TICKS (GOVERNOR_PERIOD_MS));
+
+        /* The clock only changes at the end of a period, so both counters ran at the same
+         * frequency during it and their ratio is the idle share of the period. */
+        ui32Total = portGET_RUN_TIME_COUNTER_VALUE () - ui32LastTotal;
+        ui32Idle  = ulTaskGetIdleRunTimeCounter () - ui32LastIdle;
+        ui32LastTotal += ui32Total;
+        ui32LastIdle  += ui32Idle;
+
+        if ((ui32Total < 100) || (ui32Idle > ui32Total))
+        {
+            continue;
+        }
+        ui32Load = 100 - (ui32Idle / (ui32Total / 100));
+
+        eLevel = Clock_getLevel ();
+
+        taskENTER_CRITICAL ();
+        {
+            xGovernorStats.ui32Load = ui32Load;
+            xGovernorStats.ui32TimeMs[eLevel] += GOVERNOR_PERIOD_MS;
+
+            /* mV * uA * ms gives picojoules, keep microjoules. */
+            ullGovernorEnergyMicroJoules += ((uint64_t) GOVERNOR_SUPPLY_MV * ulGovernorCurrentUA[eLevel] * GOVERNOR_PERIOD_MS) / 1000000;
+            ullGovernorBusyCycles += ui32Total - ui32Idle;
+
+            xGovernorStats.ui32EnergyMilliJoules = (uint32_t) (ullGovernorEnergyMicroJoules / 1000);
+            if (ullGovernorBusyCycles >= 1000000)
+            {
+                xGovernorStats.ui32MicroJoulesPerMCycle = (uint32_t) (ullGovernorEnergyMicroJoules / (ullGovernorBusyCycles / 1000000));
+            }
+        }
+        taskEXIT_CRITICAL ();
+
+        /* Bursts need full speed straight away, while slowing down is done one level at a time. */
+        if ((ui32Load >= GOVERNOR_UP_LOAD) && (eLevel != CLOCK_LEVEL_80MHZ))
+        {
+            Governor_switch (CLOCK_LEVEL_80MHZ);
+        }
+        else if ((ui32Load <= GOVERNOR_DOWN_LOAD) && (eLevel < (CLOCK_LEVELS - 1)))
+        {
+            Governor_switch ((Clock_Level) (eLevel + 1));
+        }
+    }
+}
+
+void Governor_getStats (Governor_Stats *pxStats)
+{
+    taskENTER_CRITICAL ();
+    {
+        *pxStats = xGovernorStats;
+    }
+    taskEXIT_CRITICAL ();
+}
@@ -0,0 +1,67 @@
+/*
+ * Load adaptive clock governor, switches the MCU between the PLL clock levels
+ * depending on how much of the time the idle task gets to run.
+ */
+
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "clock.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* How often the load is sampled and the clock level reconsidered. */
+#define GOVERNOR_PERIOD_MS         100
+
+/* Go straight to full speed above this load, step one level down below the other one (percent). */
+#define GOVERNOR_UP_LOAD           70
+#define GOVERNOR_DOWN_LOAD         30
+
+/* Supply voltage and run mode current of every clock level used for the energy estimate.
+ * These are rough figures for the MCU alone, calibrate them on the board for real numbers. */
+#define GOVERNOR_SUPPLY_MV         3300
+#define GOVERNOR_CURRENT_80MHZ_UA  32000
+#define GOVERNOR_CURRENT_40MHZ_UA  19000
+#define GOVERNOR_CURRENT_16MHZ_UA  10000
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    /* Time spent at every clock level. */
+    uint32_t ui32TimeMs [CLOCK_LEVELS];
+    /* Number of clock level changes, and how long the last and the longest one took. */
+    uint32_t ui32Switches;
+    uint32_t ui32LastSwitchUs;
+    uint32_t ui32MaxSwitchUs;
+    /* Load measured during the last period, in percent. */
+    uint32_t ui32Load;
+    /* Estimated energy used so far, and per million cycles of work done outside the idle task. */
+    uint32_t ui32EnergyMilliJoules;
+    uint32_t ui32MicroJoulesPerMCycle;
+} Governor_Stats;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Task that samples the idle time every GOVERNOR_PERIOD_MS and picks the clock level. */
+void Governor_Task (void * pvParameters);
+
+/* Copy of the statistics gathered by the governor so far. */
+void Governor_getStats (Governor_Stats *pxStats);
+
+#endif /* GOVERNOR_H */
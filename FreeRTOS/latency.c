@@ -0,0 +1,252 @@
+/*
+ * Interrupt latency test mode, see latency.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "latency.h"
+#include "vectors.h"
+
+/* TivaWare includes.  */
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/gpio.h"
+#include "driverlib/timer.h"
+#include "driverlib/interrupt.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* The woken task runs above everything but the governor, the load below everything but the idle task. */
+#define LATENCY_TASK_PRIORITY      (configMAX_PRIORITIES - 2)
+#define LATENCY_LOAD_PRIORITY      (tskIDLE_PRIORITY + 1)
+#define STACK_SIZE_LATENCY         200
+#define STACK_SIZE_LATENCY_LOAD    200
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static TaskHandle_t xLatencyTask = NULL;
+static TaskHandle_t xLatencyLoadTask = NULL;
+
+/* Set up by Latency_Run, then only the timer handler writes the ISR histogram,
+ * and only the woken task the two others. */
+static Latency_Result *psLatencyResult;
+static volatile Latency_Load eLatencyLoad;
+static uint32_t ui32LatencySamples;
+static volatile uint32_t ui32LatencyFired;
+static volatile bool bLatencyRunning = false;
+
+/* Cycle count at the last timer time-out, and whether its task has not run yet. */
+static volatile uint32_t ui32LatencyStamp;
+static volatile bool bLatencyPending;
+
+/*****************************************************************************/
+/*                              Latency Functions                            */
+/*****************************************************************************/
+
+static void Latency_add (Latency_Point ePoint, uint32_t ui32Cycles)
+{
+    uint32_t ui32Bucket = ui32Cycles / LATENCY_BUCKET_CYCLES;
+
+    if (ui32Bucket >= LATENCY_BUCKETS)
+    {
+        ui32Bucket = LATENCY_BUCKETS - 1;
+    }
+    psLatencyResult->ui32Buckets[ePoint][ui32Bucket]++;
+
+    if (ui32Cycles < psLatencyResult->ui32Min[ePoint])
+    {
+        psLatencyResult->ui32Min[ePoint] = ui32Cycles;
+    }
+    if (ui32Cycles > psLatencyResult->ui32Max[ePoint])
+    {
+        psLatencyResult->ui32Max[ePoint] = ui32Cycles;
+    }
+}
+
+/* Burn ui32Cycles cycles without giving the processor away. */
+static void Latency_spin (uint32_t ui32Cycles)
+{
+    uint32_t ui32Start = portGET_RUN_TIME_COUNTER_VALUE ();
+
+    while ((portGET_RUN_TIME_COUNTER_VALUE () - ui32Start) < ui32Cycles) {}
+}
+
+void Timer0AIntHandler (void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ui32Now;
+    uint32_t ui32Elapsed;
+
+    /* The timer counts down from LATENCY_PERIOD_CYCLES - 1 and reloads at the time-out, so what it
+     * counted since is the latency to here. Both counters run from the system clock. */
+    ui32Now = portGET_RUN_TIME_COUNTER_VALUE ();
+    ui32Elapsed = (LATENCY_PERIOD_CYCLES - 1) - TimerValueGet (TIMER0_BASE, TIMER_A);
+
+    TimerIntClear (TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+
+    ui32LatencyStamp = ui32Now - ui32Elapsed;
+    Latency_add (LATENCY_TO_ISR, ui32Elapsed);
+    psLatencyResult->ui32Samples++;
+
+    if (bLatencyPending == true)
+    {
+        psLatencyResult->ui32Overruns++;
+    }
+    bLatencyPending = true;
+
+    ui32LatencyFired++;
+    if (ui32LatencyFired == ui32LatencySamples)
+    {
+        TimerDisable (TIMER0_BASE, TIMER_A);
+    }
+
+    vTaskNotifyGiveFromISR (xLatencyTask, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR (xHigherPriorityTaskWoken);
+}
+
+static void Latency_Task (void * pvParameters)
+{
+    uint32_t ui32Stamp;
+    uint32_t ui32ToTask;
+    uint32_t ui32ToGpio;
+    uint8_t ui8Level = 0;
+
+    /* This is an I/O task that never uses floats, so drop its FPU access to keep its context switches cheap. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
+    while (1)
+    {
+        ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+
+        /* Take both times first, the bookkeeping comes after. */
+        ui32Stamp = ui32LatencyStamp;
+        ui32ToTask = portGET_RUN_TIME_COUNTER_VALUE () - ui32Stamp;
+        ui8Level ^= LATENCY_GPIO_PIN;
+        GPIOPinWrite (LATENCY_GPIO_BASE, LATENCY_GPIO_PIN, ui8Level);
+        ui32ToGpio = portGET_RUN_TIME_COUNTER_VALUE () - ui32Stamp;
+
+        bLatencyPending = false;
+        Latency_add (LATENCY_TO_TASK, ui32ToTask);
+        Latency_add (LATENCY_TO_GPIO, ui32ToGpio);
+
+        /* The last interrupt has been handled, release Latency_Run and the load task. */
+        if (ui32LatencyFired == ui32LatencySamples)
+        {
+            bLatencyRunning = false;
+        }
+    }
+}
+
+static void Latency_LoadTask (void * pvParameters)
+{
+    /* This task never uses floats, so drop its FPU access to keep its context switches cheap. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
+    while (1)
+    {
+        /* Wait for a run that needs a load. */
+        ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+
+        while (bLatencyRunning == true)
+        {
+            switch (eLatencyLoad)
+            {
+            case LATENCY_LOAD_CRITICAL:
+                taskENTER_CRITICAL ();
+                Latency_spin (LATENCY_LOAD_HOLD_CYCLES);
+                taskEXIT_CRITICAL ();
+                break;
+            case LATENCY_LOAD_SUSPEND:
+                vTaskSuspendAll ();
+                Latency_spin (LATENCY_LOAD_HOLD_CYCLES);
+                (void) xTaskResumeAll ();
+                break;
+            default:
+                Latency_spin (LATENCY_LOAD_HOLD_CYCLES);
+                break;
+            }
+        }
+    }
+}
+
+void Latency_Init (void)
+{
+    /* Enable Clock for the GPIO port of the spare pin, and set it as an Output Pin. */
+    SysCtlPeripheralEnable (LATENCY_GPIO_PERIPH);
+    while (!SysCtlPeripheralReady (LATENCY_GPIO_PERIPH)) {}
+    GPIOPinTypeGPIOOutput (LATENCY_GPIO_BASE, LATENCY_GPIO_PIN);
+
+    /* Enable Clock for Timer 0, and make it a periodic 32 bit timer. */
+    SysCtlPeripheralEnable (SYSCTL_PERIPH_TIMER0);
+    while (!SysCtlPeripheralReady (SYSCTL_PERIPH_TIMER0)) {}
+    TimerConfigure (TIMER0_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet (TIMER0_BASE, TIMER_A, LATENCY_PERIOD_CYCLES - 1);
+
+    /* Interrupt on the time-out, at the same priority as the other interrupts that use the kernel. */
+    TimerIntEnable (TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+    IntPrioritySet (INT_TIMER0A, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+#if (VECTORS_RUNTIME_REGISTER == 1)
+    TimerIntRegister (TIMER0_BASE, TIMER_A, Timer0AIntHandler);
+#else
+    IntEnable (INT_TIMER0A);
+#endif
+
+    xTaskCreate (Latency_Task, "Task_LATENCY", STACK_SIZE_LATENCY, NULL, LATENCY_TASK_PRIORITY, &xLatencyTask);
+    xTaskCreate (Latency_LoadTask, "Task_LOAD", STACK_SIZE_LATENCY_LOAD, NULL, LATENCY_LOAD_PRIORITY, &xLatencyLoadTask);
+}
+
+void Latency_Run (Latency_Load eLoad, uint32_t ui32Samples, Latency_Result *psResult)
+{
+    uint32_t i, j;
+
+    /* Start from an empty result, the timer is stopped so nothing else touches it. */
+    psResult->ui32Samples = 0;
+    psResult->ui32Overruns = 0;
+    for (i = 0; i < LATENCY_POINTS; i++)
+    {
+        psResult->ui32Min[i] = 0xFFFFFFFF;
+        psResult->ui32Max[i] = 0;
+        for (j = 0; j < LATENCY_BUCKETS; j++)
+        {
+            psResult->ui32Buckets[i][j] = 0;
+        }
+    }
+
+    psLatencyResult = psResult;
+    eLatencyLoad = eLoad;
+    ui32LatencySamples = ui32Samples;
+    ui32LatencyFired = 0;
+    bLatencyPending = false;
+    bLatencyRunning = true;
+
+    if (eLoad != LATENCY_LOAD_IDLE)
+    {
+        xTaskNotifyGive (xLatencyLoadTask);
+    }
+
+    /* Start the first period from the top. */
+    TimerLoadSet (TIMER0_BASE, TIMER_A, LATENCY_PERIOD_CYCLES - 1);
+    TimerEnable (TIMER0_BASE, TIMER_A);
+
+    /* The calling task is below the woken one, and above the load, so it only gets back here in between. */
+    while (bLatencyRunning == true)
+    {
+        vTaskDelay (pdMS_TO_TICKS (10));
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Interrupt latency test mode. Timer 0A interrupts at known times, and every
+ * interrupt is timed three ways, in cycles from the timer time-out:
+ *  - to the entry of the interrupt handler, read back from the timer itself,
+ *  - to the task woken from the handler running,
+ *  - to the first GPIO write of that task.
+ * A load task keeps the rest of the system busy the way chosen for the run.
+ *
+ * On the board the test is started with t on the console. Its host mode is
+ * make qemu-latency in gcc/, which builds the QEMU image and runs t there
+ * with qemu/qemu_bench.py. The timer and the cycle counter are then worked
+ * out by qemu/board_qemu.c from the SysTick, so the cycles are those of QEMU
+ * with -icount: the same from run to run, good to compare loads and changes,
+ * not those of the board.
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Cycles between two interrupts, long enough for the woken task to always finish in between. */
+#define LATENCY_PERIOD_CYCLES      20000
+
+/* Bucket n of the histograms counts the latencies from n to n + 1 times LATENCY_BUCKET_CYCLES,
+ * the last bucket all the longer ones. */
+#define LATENCY_BUCKETS            16
+#define LATENCY_BUCKET_CYCLES      32
+
+/* Cycles the load task holds a critical section or the scheduler at a time. */
+#define LATENCY_LOAD_HOLD_CYCLES   2000
+
+/* The spare pin written by the woken task, to check the timing with a scope as well. */
+#define LATENCY_GPIO_PERIPH        SYSCTL_PERIPH_GPIOB
+#define LATENCY_GPIO_BASE          GPIO_PORTB_BASE
+#define LATENCY_GPIO_PIN           GPIO_PIN_5
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+/* What the load task does during a run. */
+typedef enum
+{
+    LATENCY_LOAD_IDLE,          /* Nothing, the idle task runs between the interrupts. */
+    LATENCY_LOAD_BUSY,          /* Spins at the lowest priority, without masking anything. */
+    LATENCY_LOAD_CRITICAL,      /* Spins in critical sections of LATENCY_LOAD_HOLD_CYCLES. */
+    LATENCY_LOAD_SUSPEND,       /* Spins with the scheduler suspended for LATENCY_LOAD_HOLD_CYCLES. */
+    LATENCY_LOADS
+} Latency_Load;
+
+/* The three latencies measured for every interrupt. */
+typedef enum
+{
+    LATENCY_TO_ISR,
+    LATENCY_TO_TASK,
+    LATENCY_TO_GPIO,
+    LATENCY_POINTS
+} Latency_Point;
+
+typedef struct
+{
+    uint32_t ui32Samples;
+    /* Interrupts whose task had not run yet when the next one came, they are only in the LATENCY_TO_ISR histogram. */
+    uint32_t ui32Overruns;
+    uint32_t ui32Min [LATENCY_POINTS];
+    uint32_t ui32Max [LATENCY_POINTS];
+    uint32_t ui32Buckets [LATENCY_POINTS][LATENCY_BUCKETS];
+} Latency_Result;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Create the tasks and set up the timer and the pin, the timer only runs during Latency_Run. */
+void Latency_Init (void);
+
+/* Take ui32Samples interrupts under the load eLoad, blocks the calling task until they are all in psResult. */
+void Latency_Run (Latency_Load eLoad, uint32_t ui32Samples, Latency_Result *psResult);
+
+/* Timer 0 subtimer A, in the vector table. */
+void Timer0AIntHandler (void);
+
+#endif /* LATENCY_H */
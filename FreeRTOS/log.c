@@ -0,0 +1,159 @@
+/*
+ * Deferred-format binary logging, see log.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+/* Header Files Includes.  */
+#include "log.h"
+#include "ring.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Above the console task, so this task gets the sink back between two chunks before it can, and a
+ * record is never cut in two by its text. */
+#define LOG_TASK_PRIORITY          (configMAX_PRIORITIES - 2)
+#define STACK_SIZE_LOG             128
+
+/* Bytes taken out of the ring at a time. */
+#define LOG_CHUNK                  16
+
+/* Longest 32 bit value in 7 bits per byte, and longest record before the arguments. */
+#define LOG_VARINT_MAX             5
+#define LOG_HEADER_MAX             (3 + LOG_VARINT_MAX)
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static Ring_t xLogRing;
+static uint8_t ui8LogBuffer[LOG_RING_SIZE];
+static Print_Sink *psLogSink;
+
+/* Only written with the interrupts masked, the cycle counter value the time of the last record
+ * written stands for, which the next one counts from. */
+static uint8_t ui8LogSequence = 0;
+static uint32_t ui32LogStamp = 0;
+
+/* Written from tasks and interrupts alike, with the atomics of atomic.h. */
+static volatile uint32_t ui32LogDropped = 0;
+
+/*****************************************************************************/
+/*                                Log Functions                              */
+/*****************************************************************************/
+
+static void Log_Task (void * pvParameters)
+{
+    uint8_t ui8Chunk[LOG_CHUNK];
+    uint32_t ui32Length;
+
+    /* This is an I/O task that never uses floats, so drop its FPU access to keep its context switches cheap. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
+    while (1)
+    {
+        /* Polled rather than woken by LOG(), so logging never costs a notification. */
+        vTaskDelay (pdMS_TO_TICKS (LOG_DRAIN_MS));
+
+        while ((ui32Length = Ring_Read (&xLogRing, ui8Chunk, LOG_CHUNK)) != 0)
+        {
+            Print_write (psLogSink, (const char *) ui8Chunk, ui32Length);
+        }
+    }
+}
+
+/* Write ui32Value 7 bits per byte, low first, the high bit set on all bytes but the last, returns the bytes written. */
+static uint32_t Log_putVarint (uint8_t *pui8Out, uint32_t ui32Value)
+{
+    uint32_t ui32Length = 0;
+
+    while (ui32Value >= 0x80)
+    {
+        pui8Out[ui32Length++] = (uint8_t) (ui32Value | 0x80);
+        ui32Value >>= 7;
+    }
+    pui8Out[ui32Length++] = (uint8_t) ui32Value;
+
+    return ui32Length;
+}
+
+void Log_Init (Print_Sink *psSink)
+{
+    psLogSink = psSink;
+    Ring_Init (&xLogRing, ui8LogBuffer, LOG_RING_SIZE);
+
+    xTaskCreate (Log_Task, "Task_LOG", STACK_SIZE_LOG, NULL, LOG_TASK_PRIORITY, NULL);
+}
+
+bool Log_write (const char *pcFormat, uint32_t ui32Count, ...)
+{
+    uint8_t ui8Header[LOG_HEADER_MAX];
+    uint8_t ui8Args[LOG_VARINT_MAX * LOG_ARGS_MAX];
+    uint32_t ui32HeaderLength, ui32ArgsLength = 0;
+    uint32_t ui32Base, ui32Stamp;
+    UBaseType_t uxSavedInterruptStatus;
+    bool bWritten = false;
+    va_list xArgs;
+    uint32_t i;
+
+    configASSERT (ui32Count <= LOG_ARGS_MAX);
+
+    va_start (xArgs, ui32Count);
+    for (i = 0; i < ui32Count; i++)
+    {
+        ui32ArgsLength += Log_putVarint (&ui8Args[ui32ArgsLength], va_arg (xArgs, uint32_t));
+    }
+    va_end (xArgs);
+
+    /* Several tasks and interrupts write the ring, so the producer side is masked, the
+     * sequence number is taken with the space, and the timestamp in the same order. */
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR ();
+
+    ui8Header[0] = LOG_SYNC | ui8LogSequence;
+    ui8Header[1] = (uint8_t) ((uint32_t) pcFormat & 0xFF);
+    ui8Header[2] = (uint8_t) (((uint32_t) pcFormat >> 8) & 0xFF);
+
+    /* The record of sequence number 0 has the time itself, so the decoder gets back in step
+     * after it missed one, the others the time since the last record written. */
+    ui32Base = (ui8LogSequence == 0) ? 0 : ui32LogStamp;
+    ui32Stamp = (portGET_RUN_TIME_COUNTER_VALUE () - ui32Base) >> LOG_STAMP_SHIFT;
+    ui32HeaderLength = 3 + Log_putVarint (&ui8Header[3], ui32Stamp);
+    ui8LogSequence = (ui8LogSequence + 1) & LOG_SEQUENCE_MASK;
+
+    if ((LOG_RING_SIZE - Ring_Count (&xLogRing)) >= (ui32HeaderLength + ui32ArgsLength))
+    {
+        Ring_Write (&xLogRing, ui8Header, ui32HeaderLength);
+        Ring_Write (&xLogRing, ui8Args, ui32ArgsLength);
+        ui32LogStamp = ui32Base + (ui32Stamp << LOG_STAMP_SHIFT);
+        bWritten = true;
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR (uxSavedInterruptStatus);
+
+    /* Nothing else has to be in step with the count of records dropped, it is left out of the masked section. */
+    if (bWritten == false)
+    {
+        Atomic_Increment_u32 (&ui32LogDropped);
+    }
+
+    return bWritten;
+}
+
+uint32_t Log_getDropped (void)
+{
+    return ui32LogDropped;
+}
@@ -0,0 +1,104 @@
+/*
+ * Deferred-format binary logging. LOG() does not format anything on the target,
+ * it puts its format string in the .logstr section, which is kept in the ELF
+ * file but never loaded, and only writes a record to a ring buffer:
+ *
+ *  - 1 byte   LOG_SYNC with a sequence number in the low 5 bits, so the
+ *             records dropped can be told,
+ *  - 2 bytes  the address of the format string in .logstr, which starts at
+ *             0, little endian,
+ *  - 1 to 5   the time since the last record written, in units of
+ *             2^LOG_STAMP_SHIFT cycles, or in the record of sequence number
+ *             0 the cycle counter itself in the same units,
+ *  - 1 to 5   per argument,
+ *
+ * the time and the arguments 7 bits per byte, low first, with the high bit
+ * set on all bytes but the last, so a value below 128 takes one byte. The
+ * number of arguments is the number of conversions of the format string. A
+ * 55 character message with one small argument, sent less than 210 ms after
+ * the one before, takes 6 bytes.
+ *
+ * A task writes the records to the sink of the console, between its lines of
+ * text and its protocol frames, and log_decode.py turns them back into lines
+ * with the format strings read from the ELF file. The sequence number wraps
+ * at 32, Log_getDropped() has the exact count.
+ *
+ * Only the first byte is kept out of ASCII, the others are binary and any of
+ * them can look like a LOG_SYNC byte, as can a byte of a protocol frame. The
+ * decoder only takes a record whose ID is the start of a format string, and
+ * moves on one byte otherwise.
+ *
+ * The arguments are taken as 32 bit words, so only integers, characters and
+ * pointers can be passed, no float or 64 bit value, and a negative one takes
+ * 5 bytes. A %s argument has to be a string constant, which the decoder also
+ * finds in the ELF file.
+ *
+ * LOG() can be called from tasks and from the interrupts that use the kernel,
+ * it masks them for the few cycles of the copy into the ring. A record that
+ * does not fit is dropped whole.
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "print.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Bytes waiting to be sent, must be a power of 2. */
+#define LOG_RING_SIZE       512
+
+/* How often the ring is emptied into the sink. */
+#define LOG_DRAIN_MS        10
+
+/* The first byte of a record, never a character of the console text, which is all ASCII. */
+#define LOG_SYNC            0xA0
+#define LOG_SEQUENCE_MASK   0x1F
+#define LOG_ARGS_MAX        6
+
+/* 1024 cycles, 12.8 us at 80 MHz, one byte of time up to 1.6 ms between two records, two up to 210 ms. */
+#define LOG_STAMP_SHIFT     10
+
+/* Where the format strings go, placed at address 0 by the linker script so their address is their ID. */
+#define LOG_SECTION         __attribute__((section(".logstr")))
+
+/* Number of arguments after the format, up to LOG_ARGS_MAX. */
+#define LOG_COUNT(...)                             LOG_COUNT_(__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0, 0)
+#define LOG_COUNT_(f, a1, a2, a3, a4, a5, a6, n, ...)    n
+#define LOG_FORMAT(pcFormat, ...)                  pcFormat
+#define LOG_ARGS(pcFormat, ...)                    __VA_ARGS__
+
+/* LOG("format", arguments), the format is a string literal. The extra 0 keeps the argument list
+ * valid when there is no argument, Log_write() only reads the ones counted. */
+#define LOG(...)                                                                        \
+    do                                                                                  \
+    {                                                                                   \
+        static const char pcLogFormat[] LOG_SECTION = LOG_FORMAT (__VA_ARGS__, 0);      \
+        Log_write (pcLogFormat, LOG_COUNT (__VA_ARGS__), LOG_ARGS (__VA_ARGS__, 0));    \
+    } while (0)
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Start the ring empty and create the task that writes it to psSink, before the first LOG(). */
+void Log_Init (Print_Sink *psSink);
+
+/* Called by LOG(), write one record of ui32Count arguments, returns false if it was dropped. */
+bool Log_write (const char *pcFormat, uint32_t ui32Count, ...);
+
+/* Records dropped so far because the ring was full. */
+uint32_t Log_getDropped (void);
+
+#endif /* LOG_H */
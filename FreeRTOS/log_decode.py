@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+#
+# Turns the binary records written by LOG(), see log.h, back into lines of
+# text, with the format strings read from the .logstr section of the ELF file
+# of the same build, the .out of CCS or the .elf of gcc/Makefile.
+#
+# The console text around the records is passed through as it is, so this can
+# sit between the UART and the terminal:
+#
+#   stty -F /dev/ttyACM0 128000 raw
+#   python3 log_decode.py Debug/FreeRTOS.out < /dev/ttyACM0
+#
+# Only the standard library is used, the ELF file is read with struct.
+#
+
+import argparse
+import re
+import struct
+import sys
+
+LOG_SYNC = 0xA0
+LOG_SEQUENCE_MASK = 0x1F
+LOG_ARGS_MAX = 6
+LOG_STAMP_SHIFT = 10
+
+# The longest a record can be after its sync byte: the ID, the time and the arguments.
+VARINT_MAX = 5
+RECORD_MAX = 2 + VARINT_MAX * (1 + LOG_ARGS_MAX)
+
+SPECIFIER = re.compile(r"%([-+ 0#]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|t)?([diuxXcsp%])")
+
+
+class Elf:
+    """The sections of a 32 bit little endian ELF file, which is all the TM4C123 builds give."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError("%s is not a 32 bit little endian ELF file" % path)
+
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x2E)
+
+        headers = [struct.unpack_from("<IIIIIIIIII", self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx][4]
+
+        self.sections = {}
+        for name, type_, flags, addr, offset, size in (h[:6] for h in headers):
+            # SHT_NOBITS has nothing in the file.
+            if type_ == 8:
+                continue
+            end = self.data.index(b"\0", names + name)
+            self.sections[self.data[names + name:end].decode()] = (addr, offset, size, flags)
+
+    def section(self, name):
+        if name not in self.sections:
+            raise ValueError("no %s section, was the image built with log.c?" % name)
+        addr, offset, size, _ = self.sections[name]
+        return addr, self.data[offset:offset + size]
+
+    def string_at(self, address):
+        """A string constant of the image, for %s, from the loaded sections."""
+        for addr, offset, size, flags in self.sections.values():
+            # SHF_ALLOC
+            if (flags & 2) and addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.find(b"\0", start, offset + size)
+                return self.data[start:end if end >= 0 else offset + size].decode("latin-1")
+        return "<0x%08x>" % address
+
+
+class Stream:
+    """The capture, with the bytes after a sync byte looked at before they are taken as a record."""
+
+    def __init__(self, f):
+        self.f = f
+        self.pending = bytearray()
+
+    def peek(self, n):
+        if len(self.pending) < n:
+            self.pending += self.f.read(n - len(self.pending))
+        return bytes(self.pending[:n])
+
+    def read(self, n):
+        data = self.peek(n)
+        del self.pending[:n]
+        return data
+
+
+def c_string(data, offset):
+    end = data.find(b"\0", offset)
+    return data[offset:end].decode("latin-1")
+
+
+def is_sync(byte):
+    return (byte & 0xE0) == LOG_SYNC
+
+
+def varint(body, offset):
+    """(value, offset after it) of the 7 bits per byte value LOG() wrote at offset, or None if it cannot
+    be one: cut short, longer than 32 bits, or longer than it has to be."""
+    value = 0
+    for i in range(VARINT_MAX):
+        if offset + i >= len(body):
+            return None
+        byte = body[offset + i]
+        value |= (byte & 0x7F) << (7 * i)
+        if not byte & 0x80:
+            if (byte == 0 and i > 0) or value >= 1 << 32:
+                return None
+            return value, offset + i + 1
+    return None
+
+
+def parse_record(strings, base, header, body):
+    """(format, sequence, time, arguments, length) of the record of sync byte header and the bytes after
+    it in body, length counting those, or None if it cannot be one LOG() wrote: its ID has to be the
+    start of a string of .logstr and the values after it have to be whole."""
+    if len(body) < 3:
+        return None
+    ident, = struct.unpack_from("<H", body, 0)
+    offset = ident - base
+    if offset < 0 or offset >= len(strings) or (offset > 0 and strings[offset - 1] != 0):
+        return None
+    fmt = c_string(strings, offset)
+    count = sum(1 for m in SPECIFIER.finditer(fmt) if m.group(4) != "%")
+    if count > LOG_ARGS_MAX:
+        return None
+    values = []
+    offset = 2
+    for _ in range(1 + count):
+        value = varint(body, offset)
+        if value is None:
+            return None
+        values.append(value[0])
+        offset = value[1]
+    return fmt, header & LOG_SEQUENCE_MASK, values[0], values[1:], offset
+
+
+def starts_inside(stream, strings, base, length, sequence):
+    """Whether a record numbered sequence starts in the next length bytes of the stream."""
+    for i in range(length):
+        byte = stream.peek(i + 1)[i:]
+        if byte and is_sync(byte[0]):
+            record = parse_record(strings, base, byte[0], stream.peek(i + 1 + RECORD_MAX)[i + 1:])
+            if record is not None and record[1] == sequence:
+                return True
+    return False
+
+
+def format_record(elf, fmt, args):
+    """printf() on the host, with the 32 bit arguments of the record."""
+    values = iter(args)
+
+    def convert(m):
+        flags, width, precision, spec = m.groups()
+        if spec == "%":
+            return "%"
+        value = next(values, 0)
+        if spec in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            spec = "d"
+        elif spec == "c":
+            value = chr(value & 0xFF)
+        elif spec == "s":
+            value = elf.string_at(value)
+        elif spec == "p":
+            value, spec, flags = "0x%08x" % value, "s", ""
+        out = "%" + flags + width + ("." + precision if precision else "") + spec
+        return out % value
+
+    return SPECIFIER.sub(convert, fmt)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the LOG() records of a UART capture.")
+    parser.add_argument("elf", help="ELF file of the image that wrote the records")
+    parser.add_argument("input", nargs="?", default="-", help="capture of the UART, stdin by default")
+    parser.add_argument("--clock", type=float, default=80e6,
+                        help="Hz of the cycle counter, to print seconds, 0 to print cycles (default 80 MHz)")
+    parser.add_argument("--quiet", action="store_true", help="drop the console text, only print the records")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    base, strings = elf.section(".logstr")
+
+    stream = Stream(sys.stdin.buffer if args.input == "-" else open(args.input, "rb"))
+    out = sys.stdout
+    sequence = None
+    dropped = 0
+    # The cycles since the reset, only known once a record of sequence number 0 was read, counted from
+    # the first record read before that.
+    cycles = 0
+    synced = False
+
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            break
+
+        header = byte[0]
+        if not is_sync(header):
+            # Console text, always ASCII, or a byte of a protocol frame or of a record cut short.
+            if not args.quiet and header < 0x80:
+                out.write(chr(header))
+                out.flush()
+            continue
+
+        # The sync byte can also be in the middle of a record or of a frame, so what follows is only
+        # taken as a record if it is one, and if it is out of step with the records before, only if
+        # the record that was due does not start inside it. Otherwise the scan goes on from the byte
+        # after the sync byte.
+        record = parse_record(strings, base, header, stream.peek(RECORD_MAX))
+        if record is not None and sequence is not None and record[1] != sequence:
+            if starts_inside(stream, strings, base, record[4], sequence):
+                record = None
+        if record is None:
+            continue
+        fmt, seq, stamp, words, length = record
+        stream.read(length)
+
+        if sequence is not None and seq != sequence:
+            dropped += (seq - sequence) & LOG_SEQUENCE_MASK
+            out.write("<%d records dropped>\n" % ((seq - sequence) & LOG_SEQUENCE_MASK))
+        sequence = (seq + 1) & LOG_SEQUENCE_MASK
+
+        # The time of a record of sequence number 0 is the 32 bit cycle counter, taken as the count since
+        # the reset that is nearest to the one kept here, which it corrects if a record was missed.
+        if seq == 0:
+            delta = ((stamp << LOG_STAMP_SHIFT) - cycles) & 0xFFFFFFFF
+            cycles += delta - (1 << 32) if delta & 0x80000000 else delta
+            synced = True
+        else:
+            cycles += stamp << LOG_STAMP_SHIFT
+
+        stamp = "%12.6f" % (cycles / args.clock) if args.clock else "%10u" % cycles
+        text = format_record(elf, fmt, words)
+        out.write("[%s%s] %s\n" % ("" if synced else "~", stamp, text.rstrip("\r\n ")))
+        out.flush()
+
+    if dropped:
+        sys.stderr.write("%d records dropped in total\n" % dropped)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -12,26 +12,43 @@
 #include <stdbool.h>
 
 /* Header Files Includes.  */
+#include "clock.h"
+#include "governor.h"
+#include "latency.h"
+#include "bench.h"
+#include "ring.h"
+#include "log.h"
+#include "print.h"
+#include "proto.h"
+#include "baud.h"
+#include "serial.h"
+#include "gateway.h"
+#include "actors.h"
+#include "vectors.h"
 
 
 /* TivaWare includes.  */
 #include "inc/hw_memmap.h"
 #include "inc/tm4c123gh6pm.h"
+#include "inc/hw_ints.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
 #include "driverlib/uart.h"
-#include "utils/uartstdio.h"
+#include "driverlib/interrupt.h"
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
 #include "semphr.h"
+#include "croutine.h"
+#include "critstats.h"
 
 /* Main Code #defines */
 #define PINS     GPIO_PIN_0 | GPIO_PIN_1
 #define LEDS     GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3
+#define SW1      GPIO_PIN_4
 #define LEDS_OFF 0
 #define RED      2
 #define BLUE     4
@@ -42,19 +59,136 @@
 #define STACK_SIZE_TASK_2 1250
 #define STACK_SIZE_TASK_3 1000
 #define STACK_SIZE_TASK_4 800
+#define STACK_SIZE_GOVERNOR 200
+
+/* Bytes received by UART0 wait in a lock-free ring for vTask1, set to 0 to pass them through a
+ * queue instead, so the latency printed with l can be compared between the two. Must be a power of 2,
+ * and hold what comes in at full line rate while vTask1 sends the reply to a protocol frame. */
+#define RX_USE_RING 1
+#define RX_SIZE     512
+
+/* Bytes taken out of the Rx FIFO at a time, the whole FIFO. */
+#define RX_FIFO_SIZE 16
+
+/* UART0 starts at CONSOLE_BAUD, 8 bits, 1 stop bit and no parity. CMD_BAUD with a rate of 0 switches to the
+ * fastest one up to CONSOLE_BAUD_MAX, what the USB to serial bridge of the host is known to take. */
+#define CONSOLE_CONFIG          (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE)
+#define CONSOLE_BAUD            128000
+#define CONSOLE_BAUD_MAX        921600
+
+/* How long vTask1 listens for U characters at boot to take the rate of the host, 0 to start at CONSOLE_BAUD.
+ * Off by default, the console is silent meanwhile and vTask1 spins on PA0, see baud.h. */
+#define CONSOLE_AUTOBAUD_MS     0
+
+/* A rate set with CMD_BAUD goes back to the last one if no frame comes in at it for this long. */
+#define CONSOLE_BAUD_CONFIRM_MS 2000
+
+/* Protocol commands of this application, on top of the ones of proto.h. */
+#define CMD_LED        (PROTO_CMD_USER + 0)    /* One of r, g, b or o, as the characters. */
+#define CMD_LATENCY    (PROTO_CMD_USER + 1)    /* Reply with the latency last/max printed with l. */
+#define CMD_BAUD       (PROTO_CMD_USER + 2)    /* 4 bytes of rate, 0 for the fastest, reply with the rate and its error in ppm. */
+
+/* vTask1 waits on the UART and on SW1 at once with ulQueueSelect(), set to 0 to poll each of them
+ * with a zero block time once a tick instead, the latency printed with l then shows the difference. */
+#define CMD_USE_SELECT 1
+#define SELECT_RX      0x01
+#define SELECT_SW1     0x02
+
+/* UART1 with UART3 and UART4 with UART7 are bridged by the gateway task, their statistics are printed
+ * with u. Set to 0 to leave their pins alone, the QEMU board does since its part has no UART3 to UART7. */
+#ifndef GATEWAY_USE
+#define GATEWAY_USE 1
+#endif
+
+/* Number of call sites printed with c. */
+#define CRITICAL_STATS_TOP 5
+
+/* Number of owner and call site pairs printed with h. */
+#define HEAP_TAGS_TOP 12
+
+/* Interrupts timed under every load by the latency test, entered with t. */
+#define LATENCY_TEST_SAMPLES 1000
+
+/* Round trips to the benchmark task and ticks watched by the kernel benchmark, entered with k. */
+#define BENCH_ROUNDS 1000
+#define BENCH_TICKS  500
 
 /*****************************************************************************/
 /*                               Function Prototypes                         */
 /*****************************************************************************/
 
 void SystemInit (void){}
+void Heap_Init (void);
 void UART0_Init (void);
+/* On the receive path, so it runs from SRAM with the kernel hot paths, see tm4c123gh6pm.cmd. */
+portHOT_FUNCTION void UART0IntHandler (void);
 void PORTF_Init (void);
+void GPIOFIntHandler (void);
+
+/*****************************************************************************/
+/*                                 Receive Path                              */
+/*****************************************************************************/
+
+#if (RX_USE_RING == 1)
+/* Only UART0IntHandler writes the ring and only vTask1 reads it, so neither side needs a critical section. */
+static Ring_t xRxRing;
+static uint8_t ui8RxBuffer[RX_SIZE];
+#else
+static QueueHandle_t xRxQueue = NULL;
+#endif
+
+/* Everything printed on UART0 goes through it, so the lines of different tasks do not mix. */
+static Print_Sink xConsole;
+
+/* Rate of UART0, the one CMD_BAUD asked for, switched to once its reply is sent, and the one before it
+ * until a frame comes in at the new one, with the frames received and the tick at the switch. */
+static uint32_t ui32ConsoleBaud = CONSOLE_BAUD;
+static uint32_t ui32ConsoleBaudNext = 0;
+static uint32_t ui32ConsoleBaudLast = 0;
+static uint32_t ui32ConsoleFrames;
+static TickType_t xConsoleBaudSince;
+
+/* Given by GPIOFIntHandler every time SW1 is pressed, to turn the LEDS off. */
+static SemaphoreHandle_t xSW1Semaphore = NULL;
+
+/* Cycle count when the last character was received, and how long it took until the LEDS changed.
+ * Printed with l, to compare against the same measurement in RTC_Scheduler_Example. */
+static volatile uint32_t EventStamp = 0;
+static volatile uint32_t LatencyLast = 0;
+static volatile uint32_t LatencyMax = 0;
+
+/*****************************************************************************/
+/*                                    Heap                                   */
+/*****************************************************************************/
+
+/* Set by tm4c123gh6pm.cmd, the SRAM between the end of the variables and the start of the stack, or of the
+ * hot code when it runs from SRAM, is free. */
+extern uint8_t __HEAP_START;
+extern uint8_t __HEAP_END;
+
+/* Bytes heap_5.c can hand out over all the regions, printed with l and h. */
+static size_t xHeapTotal = 0;
 
 /*****************************************************************************/
 /*                                 Main Functions                            */
 /*****************************************************************************/
 
+void Heap_Init (void)
+{
+    /* In address order and ended by an empty region. The first one takes all the SRAM the linker left,
+     * more regions can be added after it, such as memory only free once the application is up. */
+    HeapRegion_t xHeapRegions[] =
+    {
+        { &__HEAP_START, (size_t) (&__HEAP_END - &__HEAP_START) },
+        { NULL, 0 }
+    };
+
+    vPortDefineHeapRegions (xHeapRegions);
+
+    /* Nothing is allocated yet, so all of it is free. */
+    xHeapTotal = xPortGetFreeHeapSize ();
+}
+
 void PORTF_Init (void)
 {
     /* Enable Clock for the GPIO Port F peripheral. */
@@ -66,6 +200,23 @@ void PORTF_Init (void)
     GPIOUnlockPin(GPIO_PORTF_BASE, LEDS);
     /* Set Pins (PF1, PF2, PF3) as Output Pins. */
     GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, LEDS);
+    /* Set SW1 (PF4) as an Input Pin, pulled up as the switch connects it to ground. */
+    GPIOPinTypeGPIOInput(GPIO_PORTF_BASE, SW1);
+    GPIOPadConfigSet(GPIO_PORTF_BASE, SW1, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+
+    /* The semaphore has to exist before the first interrupt. */
+    xSW1Semaphore = xSemaphoreCreateBinary ();
+
+    /* Interrupt on the falling edge, when SW1 is pressed, GPIOFIntHandler is in the vector table.
+     * The handler uses the kernel, so its priority must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+    GPIOIntTypeSet(GPIO_PORTF_BASE, SW1, GPIO_FALLING_EDGE);
+    GPIOIntEnable(GPIO_PORTF_BASE, SW1);
+    IntPrioritySet (INT_GPIOF, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+#if (VECTORS_RUNTIME_REGISTER == 1)
+    GPIOIntRegister (GPIO_PORTF_BASE, GPIOFIntHandler);
+#else
+    IntEnable (INT_GPIOF);
+#endif
 }
 
 void UART0_Init (void)
@@ -82,11 +233,95 @@ void UART0_Init (void)
     GPIOPinConfigure (GPIO_PA0_U0RX);
     GPIOPinConfigure (GPIO_PA1_U0TX);
     GPIOPinTypeUART  (GPIO_PORTA_BASE, PINS);
-    /* Initialize the UART, by choosing UART0, baud rate as 128000,
+    /* Initialize the UART, by choosing UART0, baud rate as CONSOLE_BAUD,
      * 8 bits mode, 1 stop bit, and no parity bit. */
-    UARTConfigSetExpClk (UART0_BASE, SysCtlClockGet(), 128000, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |UART_CONFIG_PAR_NONE));
+    Clock_UARTConfigSet (UART0_BASE, CONSOLE_BAUD, CONSOLE_CONFIG);
     /* Finalize the initialization process by enabling the module to transmit and receive FIFOs. / */
     UARTEnable(UART0_BASE);
+
+    /* The console prints through its sink from now on. */
+    Print_SinkInit (&xConsole, Print_UARTWrite, (void *) UART0_BASE);
+
+    /* The receive path has to exist before the first interrupt. */
+#if (RX_USE_RING == 1)
+    Ring_Init (&xRxRing, ui8RxBuffer, RX_SIZE);
+#else
+    xRxQueue = xQueueCreate (RX_SIZE, sizeof(uint8_t));
+#endif
+
+    /* Interrupt when the Rx FIFO fills up, or when a character has been waiting in it for a while.
+     * The handler uses the kernel, so its priority must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+    UARTIntEnable (UART0_BASE, UART_INT_RX | UART_INT_RT);
+    IntPrioritySet (INT_UART0, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+#if (VECTORS_RUNTIME_REGISTER == 1)
+    UARTIntRegister (UART0_BASE, UART0IntHandler);
+#else
+    IntEnable (INT_UART0);
+#endif
+}
+
+/* Empty the Rx FIFO into the receive path, vTask1 is only woken when there was nothing waiting before. */
+void UART0IntHandler (void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8_t ui8Data[RX_FIFO_SIZE];
+    uint32_t ui32Count = 0;
+    uint32_t ui32Written;
+
+    UARTIntClear (UART0_BASE, UART_INT_RX | UART_INT_RT);
+
+    EventStamp = portGET_RUN_TIME_COUNTER_VALUE();
+
+    while ((UARTCharsAvail (UART0_BASE) == true) && (ui32Count < RX_FIFO_SIZE))
+    {
+        ui8Data[ui32Count] = UARTCharGetNonBlocking (UART0_BASE);
+        ui32Count++;
+    }
+
+#if (RX_USE_RING == 1)
+    /* Characters that do not fit in the ring are dropped, all of them in one go. */
+    ui32Written = Ring_WriteFromISR (&xRxRing, ui8Data, ui32Count, &xHigherPriorityTaskWoken);
+    if (ui32Written < ui32Count)
+    {
+        LOG ("UART0 receive ring full, %u characters dropped", ui32Count - ui32Written);
+    }
+#else
+    /* The same work through the queue, one masked critical section per character. */
+    for (ui32Written = 0; ui32Written < ui32Count; ui32Written++)
+    {
+        if (xQueueSendFromISR (xRxQueue, &ui8Data[ui32Written], &xHigherPriorityTaskWoken) != pdPASS)
+        {
+            LOG ("UART0 receive queue full, %u characters dropped", ui32Count - ui32Written);
+            break;
+        }
+    }
+#endif
+
+    portYIELD_FROM_ISR (xHigherPriorityTaskWoken);
+}
+
+/* Take the next character received, without blocking, returns false if there is none. */
+static bool Rx_Read (uint8_t *pui8Character)
+{
+#if (RX_USE_RING == 1)
+    return (Ring_Read (&xRxRing, pui8Character, 1) == 1);
+#else
+    return (xQueueReceive (xRxQueue, pui8Character, 0) == pdPASS);
+#endif
+}
+
+/* SW1 was pressed, hand it to vTask1 the same way as a character. */
+void GPIOFIntHandler (void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    GPIOIntClear (GPIO_PORTF_BASE, SW1);
+
+    EventStamp = portGET_RUN_TIME_COUNTER_VALUE();
+
+    xSemaphoreGiveFromISR (xSW1Semaphore, &xHigherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR (xHigherPriorityTaskWoken);
 }
 
 /*******************************************************************************
@@ -139,6 +374,92 @@ void UART_sendString(uint32_t ui32Base, const uint8_t *Str)
     }
 }
 
+/*****************************************************************************/
+/*                                Console Functions                          */
+/*****************************************************************************/
+
+/* Change the rate of UART0 once what was sent has left it, nothing else is written meanwhile. */
+static void Console_setBaud (uint32_t ui32Baud)
+{
+    Print_lock (&xConsole);
+    while (UARTBusy (UART0_BASE)) {}
+
+    if (Clock_UARTConfigSet (UART0_BASE, ui32Baud, CONSOLE_CONFIG) == true)
+    {
+        ui32ConsoleBaud = ui32Baud;
+    }
+
+    Print_unlock (&xConsole);
+}
+
+#if (CONSOLE_AUTOBAUD_MS > 0)
+/* Listen for U characters on PA0 at boot, and take their rate if the divisors make it at this clock. */
+static void Console_autobaud (void)
+{
+    uint32_t ui32Baud;
+    uint8_t ui8Discard;
+
+    Print_lock (&xConsole);
+    while (UARTBusy (UART0_BASE)) {}
+
+    /* PA0 is read as a GPIO meanwhile, it has no timer capture input. */
+    UARTDisable (UART0_BASE);
+    GPIOPinTypeGPIOInput (GPIO_PORTA_BASE, GPIO_PIN_0);
+
+    ui32Baud = Baud_detect (GPIO_PORTA_BASE, GPIO_PIN_0, Clock_getFrequency (), CONSOLE_AUTOBAUD_MS);
+
+    GPIOPinTypeUART (GPIO_PORTA_BASE, GPIO_PIN_0);
+    if ((ui32Baud != 0) && (Clock_UARTConfigSet (UART0_BASE, ui32Baud, CONSOLE_CONFIG) == true))
+    {
+        ui32ConsoleBaud = ui32Baud;
+    }
+    else
+    {
+        UARTEnable (UART0_BASE);
+    }
+
+    Print_unlock (&xConsole);
+
+    /* What the UART made of the sync characters before it was turned off. */
+    while (Rx_Read (&ui8Discard) == true) {}
+
+    if (ui32ConsoleBaud != CONSOLE_BAUD)
+    {
+        Print_printf (&xConsole, "Console at %u baud\n\r", ui32ConsoleBaud);
+    }
+}
+#endif
+
+/* Switch to the rate CMD_BAUD asked for once its reply is sent, and go back to the last one
+ * if the host does not send a frame at the new one, it may not have been able to follow. */
+static void Console_updateBaud (void)
+{
+    Proto_Stats xStats;
+
+    Proto_getStats (&xStats);
+
+    if (ui32ConsoleBaudNext != 0)
+    {
+        ui32ConsoleBaudLast = ui32ConsoleBaud;
+        Console_setBaud (ui32ConsoleBaudNext);
+        ui32ConsoleBaudNext = 0;
+        ui32ConsoleFrames = xStats.ui32Frames;
+        xConsoleBaudSince = xTaskGetTickCount ();
+    }
+    else if (ui32ConsoleBaudLast != 0)
+    {
+        if (xStats.ui32Frames != ui32ConsoleFrames)
+        {
+            ui32ConsoleBaudLast = 0;
+        }
+        else if ((TickType_t) (xTaskGetTickCount () - xConsoleBaudSince) >= pdMS_TO_TICKS (CONSOLE_BAUD_CONFIRM_MS))
+        {
+            Console_setBaud (ui32ConsoleBaudLast);
+            ui32ConsoleBaudLast = 0;
+        }
+    }
+}
+
 /*****************************************************************************/
 /*                      Task Entry Function Definition                       */
 /*****************************************************************************/
@@ -146,11 +467,383 @@ void UART_sendString(uint32_t ui32Base, const uint8_t *Str)
 /* Queue used to send initials of LEDS to be used. */
 QueueHandle_t xQueue1 = NULL;
 
+#if (configUSE_CRITICAL_STATS == 1)
+/* Print the call sites that held off interrupts or the scheduler the longest. */
+static void Command_PrintCriticalStats (void)
+{
+    /* Too big for the stack of vTask1 to spare every time, and only vTask1 prints it. */
+    static CritStatsSite_t xTop[CRITICAL_STATS_TOP];
+    UBaseType_t uxCount, i, j;
+    const char *pcName;
+
+    uxCount = uxCritStatsGetTop (xTop, CRITICAL_STATS_TOP);
+
+    for (i = 0; i < uxCount; i++)
+    {
+        /* Only the file name, __FILE__ may hold the whole path. */
+        pcName = xTop[i].pcFile;
+        for (j = 0; xTop[i].pcFile[j] != '\0'; j++)
+        {
+            if ((xTop[i].pcFile[j] == '/') || (xTop[i].pcFile[j] == '\\'))
+            {
+                pcName = &xTop[i].pcFile[j + 1];
+            }
+        }
+
+        Print_printf (&xConsole, "%s %s:%u max cycles %u, count %u, below 64/256/1K/4K/16K/64K/256K/above ",
+                      (xTop[i].ucKind == critstatsCRITICAL) ? "Critical" : "Suspend", pcName,
+                      xTop[i].ulLine, xTop[i].ulMaxCycles, xTop[i].ulCount);
+        for (j = 0; j < critstatsBUCKETS; j++)
+        {
+            Print_printf (&xConsole, "%u%s", xTop[i].ulBuckets[j], (j < (critstatsBUCKETS - 1)) ? "/" : "\n\r");
+        }
+    }
+}
+#endif
+
+/* Start the actors the first time, then print what they take against their target. */
+static void Command_PrintActors (void)
+{
+    Actors_Stats xStats;
+
+    /* The idle hook creates them, give it the time to and the sensors the time to take a sample. */
+    Actors_Start ();
+    vTaskDelay (pdMS_TO_TICKS (2 * ACTORS_PERIOD_MS));
+    Actors_getStats (&xStats);
+
+    if (xStats.bNoRoom == true)
+    {
+        Print_printf (&xConsole, "No room in the heap for %u actors, bytes %u, free %u\n\r",
+                      ACTORS_COUNT, xStats.ui32ControlBytes + xStats.ui32StateBytes, xPortGetFreeHeapSize ());
+        return;
+    }
+
+    Print_printf (&xConsole, "Actors %u, samples %u, bytes %u control/state %u/%u, per actor %u, target %u %s\n\r",
+                  xStats.ui32Actors, xStats.ui32Samples, xStats.ui32HeapBytes, xStats.ui32ControlBytes,
+                  xStats.ui32StateBytes, xStats.ui32HeapBytes / ACTORS_COUNT, ACTORS_TARGET_BYTES,
+                  (xStats.ui32HeapBytes <= ACTORS_TARGET_BYTES) ? "met" : "missed");
+    Print_printf (&xConsole, "Idle stack bytes free %u, bytes as tasks %u\n\r",
+                  xStats.ui32IdleStackFree, xStats.ui32TaskBytes);
+}
+
+#if (GATEWAY_USE == 1)
+/* Print what each port of the gateway forwarded to its peer, and what its UART dropped. */
+static void Command_PrintGatewayStats (void)
+{
+    Gateway_Stats xStats;
+    Serial_Stats xPort;
+    uint32_t i;
+
+    Gateway_getStats (&xStats);
+    Print_printf (&xConsole, "Gateway wakeups %u\n\r", xStats.ui32Wakeups);
+
+    for (i = 0; i < GATEWAY_PORTS; i++)
+    {
+        Serial_getStats (xStats.ui32Port[i], &xPort);
+        Print_printf (&xConsole, "UART%u to UART%u bytes %u, received/sent %u/%u, dropped %u, errors %u, interrupts %u\n\r",
+                      xStats.ui32Port[i], xStats.ui32Port[i ^ 1], xStats.ui32Forwarded[i], xPort.ui32Received,
+                      xPort.ui32Sent, xPort.ui32Dropped, xPort.ui32Errors, xPort.ui32Interrupts);
+    }
+}
+#endif
+
+/* Print how the heap is used, over all and region by region. */
+static void Command_PrintHeapStats (void)
+{
+    HeapStats_t xStats;
+    HeapRegionStats_t xRegions[configHEAP_MAX_REGIONS];
+    UBaseType_t uxRegions, r;
+#if (configUSE_HEAP_TAGS == 1)
+    /* Too big for the stack of vTask1 to spare every time, and only vTask1 prints it. */
+    static HeapTag_t xTags[HEAP_TAGS_TOP];
+    UBaseType_t uxCount, i;
+#endif
+
+    vPortGetHeapStats (&xStats);
+
+    /* The fragmentation is how much of the free space cannot be had in one piece, 0 when it is all one block. */
+    Print_printf (&xConsole, "Heap bytes %u, free %u, minimum ever free %u, largest free block %u of %u blocks, "
+                  "fragmentation %% %u, allocations/frees %u/%u\n\r",
+                  xHeapTotal, xStats.xAvailableHeapSpaceInBytes, xStats.xMinimumEverFreeBytesRemaining,
+                  xStats.xSizeOfLargestFreeBlockInBytes, xStats.xNumberOfFreeBlocks,
+                  (xStats.xAvailableHeapSpaceInBytes == 0) ? 0 :
+                  100 - ((xStats.xSizeOfLargestFreeBlockInBytes * 100) / xStats.xAvailableHeapSpaceInBytes),
+                  xStats.xNumberOfSuccessfulAllocations, xStats.xNumberOfSuccessfulFrees);
+
+    uxRegions = uxPortGetHeapRegionStats (xRegions, configHEAP_MAX_REGIONS);
+
+    for (r = 0; r < uxRegions; r++)
+    {
+        Print_printf (&xConsole, "Region %u bytes %u, free %u, largest free block %u\n\r", r, xRegions[r].xSizeInBytes,
+                      xRegions[r].xAvailableHeapSpaceInBytes, xRegions[r].xSizeOfLargestFreeBlockInBytes);
+    }
+
+#if (configUSE_HEAP_TAGS == 1)
+    uxCount = uxPortGetHeapTags (xTags, HEAP_TAGS_TOP);
+
+    for (i = 0; i < uxCount; i++)
+    {
+        Print_printf (&xConsole, "%s %s:%u bytes %u in blocks %u\n\r",
+                      (xTags[i].pvOwner == NULL) ? "main" : pcTaskGetName ((TaskHandle_t) xTags[i].pvOwner),
+                      xTags[i].pcFile, xTags[i].ulLine, xTags[i].xBytes, xTags[i].xBlocks);
+    }
+#endif
+}
+
+/* Run the latency test under every load and print the histograms. */
+static void Command_LatencyTest (void)
+{
+    /* Too big for the stack of vTask1 to spare every time, and only vTask1 runs the test. */
+    static Latency_Result xResult;
+    static const char *pcLoads[LATENCY_LOADS] = {"idle", "busy", "critical", "suspend"};
+    static const char *pcPoints[LATENCY_POINTS] = {" to ISR ", " to task ", " to GPIO "};
+    uint32_t ui32Load, ui32Point, i;
+
+    Print_printf (&xConsole, "Latency cycles min/max, then per %u cycles: \n\r", LATENCY_BUCKET_CYCLES);
+
+    for (ui32Load = 0; ui32Load < LATENCY_LOADS; ui32Load++)
+    {
+        Latency_Run ((Latency_Load) ui32Load, LATENCY_TEST_SAMPLES, &xResult);
+
+        Print_printf (&xConsole, "Load %s, samples %u, overruns %u\n\r", pcLoads[ui32Load],
+                      xResult.ui32Samples, xResult.ui32Overruns);
+
+        for (ui32Point = 0; ui32Point < LATENCY_POINTS; ui32Point++)
+        {
+            Print_printf (&xConsole, "%s%u/%u: ", pcPoints[ui32Point], xResult.ui32Min[ui32Point], xResult.ui32Max[ui32Point]);
+            for (i = 0; i < LATENCY_BUCKETS; i++)
+            {
+                Print_printf (&xConsole, "%u%s", xResult.ui32Buckets[ui32Point][i], (i < (LATENCY_BUCKETS - 1)) ? " " : "\n\r");
+            }
+        }
+    }
+}
+
+/* Time the context switch and the tick interrupt, to compare running them from flash and from SRAM. */
+static void Command_KernelBench (void)
+{
+    Bench_Result xResult;
+    Bench_MutexResult xMutex;
+    Bench_AtomicResult xAtomic;
+    Bench_FPUResult xFPU;
+
+    Bench_Run (BENCH_ROUNDS, BENCH_TICKS, &xResult);
+
+    Print_printf (&xConsole, "Hot paths in %s, context switch cycles %u, tick cycles min/average/max %u/%u/%u over %u ticks\n\r",
+                  (xResult.bInSRAM == true) ? "SRAM" : "flash", xResult.ui32SwitchCycles,
+                  xResult.ui32TickMin, xResult.ui32TickAverage, xResult.ui32TickMax, xResult.ui32Ticks);
+
+    Bench_FPU (BENCH_ROUNDS, &xFPU);
+
+    Print_printf (&xConsole, "Notify round trip cycles to no FPU/FPU/FPU reset %u/%u/%u\n\r",
+                  xFPU.ui32PlainCycles, xFPU.ui32FPUCycles, xFPU.ui32ResetCycles);
+
+    Bench_Mutex (BENCH_ROUNDS, &xMutex);
+
+    Print_printf (&xConsole, "Mutex take and give cycles fast/kernel %u/%u, inheritance %s, timeout %s, priority back %s, handover %s\n\r",
+                  xMutex.ui32FastCycles, xMutex.ui32KernelCycles, (xMutex.bInherited == true) ? "ok" : "FAILED",
+                  (xMutex.bTimedOut == true) ? "ok" : "FAILED", (xMutex.bRestored == true) ? "ok" : "FAILED",
+                  (xMutex.bHandedOver == true) ? "ok" : "FAILED");
+    Print_printf (&xConsole, "Mutex handover cycles fast/kernel %u/%u\n\r",
+                  xMutex.ui32FastHandoffCycles, xMutex.ui32KernelHandoffCycles);
+
+    Bench_Atomic (BENCH_ROUNDS, &xAtomic);
+
+    Print_printf (&xConsole, "Counter increment cycles atomic/critical section %u/%u\n\r",
+                  xAtomic.ui32AtomicCycles, xAtomic.ui32CriticalCycles);
+}
+
+/* Time formatting a line of the console, to compare with the engine of UARTprintf, and check the output against printf. */
+static void Command_FormatBench (void)
+{
+    Bench_FormatResult xResult;
+
+    Bench_Format (BENCH_ROUNDS, &xResult);
+
+    Print_printf (&xConsole, "Format cycles per line of %u characters Print_snprintf/usnprintf %u/%u\n\r",
+                  xResult.ui32Length, xResult.ui32PrintCycles, xResult.ui32TivaWareCycles);
+    Print_printf (&xConsole, "Format checks against printf %u, mismatches %u%s%s\n\r", xResult.ui32Checks,
+                  xResult.ui32Mismatches, (xResult.ui32Mismatches != 0) ? ", first " : "",
+                  (xResult.ui32Mismatches != 0) ? xResult.pcMismatch : "");
+}
+
+/* Act on a character received, or on 'o' when SW1 is pressed. */
+static void Command_Handle (uint8_t ReceivedCharacter)
+{
+    /* Statistics of the clock governor, printed on request. */
+    Governor_Stats Stats;
+
+    switch (ReceivedCharacter)
+        {
+        case 'r':
+        case 'g':
+        case 'b':
+        case 'o':
+            /* if the queue is full, wait for upwards to 100 ticks, until there is an empty slot in the queue.*/
+            if( xQueueSend(xQueue1, (void *) &ReceivedCharacter, (TickType_t) 100) != pdPASS )
+            {
+                /* if the queue wasn't freed for over 100 ticks, then send this error message on the screen and carry on. */
+                LOG ("The last color preference %c will be unable to be used.", ReceivedCharacter);
+            }
+            break;
+        case 's':
+            /* Print what the clock governor measured so far. */
+            Governor_getStats (&Stats);
+            Print_printf (&xConsole, "Load %% %u, clock MHz %u, ms at 80/40/16 MHz %u/%u/%u\n\r",
+                          Stats.ui32Load, Clock_getFrequency () / 1000000, Stats.ui32TimeMs[CLOCK_LEVEL_80MHZ],
+                          Stats.ui32TimeMs[CLOCK_LEVEL_40MHZ], Stats.ui32TimeMs[CLOCK_LEVEL_16MHZ]);
+            /* The energy is printed in J with the mJ as decimals. */
+            Print_printf (&xConsole, "Switches %u, last/max switch us %u/%u, energy J %.3q, uJ per Mcycle of work %u\n\r",
+                          Stats.ui32Switches, Stats.ui32LastSwitchUs, Stats.ui32MaxSwitchUs,
+                          Stats.ui32EnergyMilliJoules, Stats.ui32MicroJoulesPerMCycle);
+            break;
+        case 'l':
+            /* Print the measurements to compare with the run-to-completion scheduler. */
+            Print_printf (&xConsole, "Latency cycles last/max %u/%u, heap bytes used %u\n\r",
+                          LatencyLast, LatencyMax, xHeapTotal - xPortGetFreeHeapSize ());
+            break;
+        case 'h':
+            /* Print the heap watermarks and fragmentation. */
+            Command_PrintHeapStats ();
+            break;
+        case 't':
+            /* Measure the interrupt latency, the commands entered meanwhile wait for the end of the test. */
+            Command_LatencyTest ();
+            break;
+        case 'k':
+            /* Time the context switch and the tick, the commands entered meanwhile wait for the end of it. */
+            Command_KernelBench ();
+            break;
+        case 'f':
+            /* Time the formatted output against TivaWare. */
+            Command_FormatBench ();
+            break;
+        case 'a':
+            /* Start the actors and print their memory. */
+            Command_PrintActors ();
+            break;
+#if (GATEWAY_USE == 1)
+        case 'u':
+            /* Print what went through the gateway. */
+            Command_PrintGatewayStats ();
+            break;
+#endif
+#if (configUSE_CRITICAL_STATS == 1)
+        case 'c':
+            /* Print the longest critical sections and scheduler suspensions, then start over. */
+            Command_PrintCriticalStats ();
+            vCritStatsReset ();
+            break;
+#endif
+        }
+}
+
+/* Protocol command CMD_LED, straight to vTask2 like the characters. */
+static uint8_t Command_Led (const uint8_t *pui8Args, uint32_t ui32Length, uint8_t *pui8Reply, uint32_t *pui32ReplyLength)
+{
+    *pui32ReplyLength = 0;
+
+    if ((ui32Length != 1) || ((pui8Args[0] != 'r') && (pui8Args[0] != 'g') && (pui8Args[0] != 'b') && (pui8Args[0] != 'o')))
+    {
+        return PROTO_BAD_ARGS;
+    }
+
+    /* A full queue is for the host to retry, vTask1 does not wait on it here with more frames coming. */
+    if (xQueueSend (xQueue1, pui8Args, 0) != pdPASS)
+    {
+        return PROTO_BUSY;
+    }
+
+    return PROTO_OK;
+}
+
+/* Protocol command CMD_LATENCY, the last and the longest latency in cycles, little endian. */
+static uint8_t Command_Latency (const uint8_t *pui8Args, uint32_t ui32Length, uint8_t *pui8Reply, uint32_t *pui32ReplyLength)
+{
+    uint32_t ui32Last = LatencyLast;
+    uint32_t ui32Max = LatencyMax;
+    uint32_t i;
+
+    if (*pui32ReplyLength < 8)
+    {
+        *pui32ReplyLength = 0;
+        return PROTO_TRUNCATED;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        pui8Reply[i] = (uint8_t) (ui32Last >> (8 * i));
+        pui8Reply[4 + i] = (uint8_t) (ui32Max >> (8 * i));
+    }
+    *pui32ReplyLength = 8;
+
+    return PROTO_OK;
+}
+
+/* Protocol command CMD_BAUD, 4 bytes of rate little endian, 0 for the fastest up to CONSOLE_BAUD_MAX at this clock.
+ * The reply, the rate and its error in ppm, still goes at the old rate, vTask1 switches after it. */
+static uint8_t Command_Baud (const uint8_t *pui8Args, uint32_t ui32Length, uint8_t *pui8Reply, uint32_t *pui32ReplyLength)
+{
+    Baud_Setting xSetting;
+    uint32_t ui32Baud = 0;
+    uint32_t i;
+
+    if (*pui32ReplyLength < 8)
+    {
+        *pui32ReplyLength = 0;
+        return PROTO_TRUNCATED;
+    }
+    *pui32ReplyLength = 0;
+
+    if (ui32Length != 4)
+    {
+        return PROTO_BAD_ARGS;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        ui32Baud |= (uint32_t) pui8Args[i] << (8 * i);
+    }
+    if (ui32Baud == 0)
+    {
+        ui32Baud = Baud_fastest (Clock_getFrequency (), CONSOLE_BAUD_MAX);
+    }
+
+    if (Baud_compute (Clock_getFrequency (), ui32Baud, &xSetting) == false)
+    {
+        return PROTO_BAD_ARGS;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        pui8Reply[i] = (uint8_t) (ui32Baud >> (8 * i));
+        pui8Reply[4 + i] = (uint8_t) ((uint32_t) xSetting.i32ErrorPpm >> (8 * i));
+    }
+    *pui32ReplyLength = 8;
+
+    ui32ConsoleBaudNext = ui32Baud;
+
+    return PROTO_OK;
+}
+
+static const Proto_Command xCommands[] =
+{
+    {CMD_LED, Command_Led},
+    {CMD_LATENCY, Command_Latency},
+    {CMD_BAUD, Command_Baud}
+};
+
 void vTask1 (void * pvParameters)
 {
     /* Create a character that stores the initials of the color of LEDS required. */
     uint8_t ReceivedCharacter;
 
+    /* Which of the UART and SW1 have something waiting. */
+    uint32_t ui32Ready;
+
+    /* This is an I/O task that never uses floats, so drop its FPU access to keep its context switches cheap. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
     /* Initialize a queue of 10 slots, that send these initials to the task that changes the LEDS. */
     xQueue1 = xQueueCreate (10, sizeof(uint8_t));
 
@@ -160,28 +853,67 @@ void vTask1 (void * pvParameters)
          * Send a message to the PC indicating Error that requires debugging.
          * Suspend this current task until further notice, which should allow other tasks to work if needed be.
          */
-        UART_sendString (UART0_BASE, "An error has occurred that ruins the system, Please Debug and then Reset. \n\r");
+        LOG ("An error has occurred that ruins the system, Please Debug and then Reset.");
         vTaskSuspend (NULL);
     }
 
+#if (CONSOLE_AUTOBAUD_MS > 0)
+    /* Before anything else is printed, so the host sees it at its own rate. */
+    Console_autobaud ();
+#endif
+
+    /* The protocol frames come in with the characters, their commands go to the queue above. */
+    Proto_Init (xCommands, sizeof(xCommands) / sizeof(xCommands[0]), &xConsole);
+
+#if (CMD_USE_SELECT == 1)
+    /* Register this task on both sources, each sets its own bit when it has something. */
+#if (RX_USE_RING == 1)
+    Ring_SelectAdd (&xRxRing, SELECT_RX);
+#else
+    vQueueSelectAdd (xRxQueue, SELECT_RX);
+#endif
+    vQueueSelectAdd (xSW1Semaphore, SELECT_SW1);
+#endif
+
     /* Continue here if Queue was initialized successfully and print this on PC screen. */
-    UART_sendString (UART0_BASE, "Please enter r, g or b at any given moment to toggle the LED accordingly: \n\r");
+    Print_printf (&xConsole, "Please enter r, g or b at any given moment to toggle the LED accordingly, s for the clock statistics, l for the benchmark, h for the heap statistics, t for the latency test, k for the kernel benchmark, f for the format benchmark, a for the actors or u for the gateway statistics, SW1 turns the LEDS off: \n\r");
 
     while (1)
     {
-        ReceivedCharacter = UARTCharGet(UART0_BASE);
-        switch (ReceivedCharacter)
+        /* Block until the UART or SW1 has something, the idle time left meanwhile
+         * is what the clock governor measures. */
+#if (CMD_USE_SELECT == 1)
+        ui32Ready = ulQueueSelect ((ui32ConsoleBaudLast != 0) ? pdMS_TO_TICKS (CONSOLE_BAUD_CONFIRM_MS) : portMAX_DELAY);
+#else
+        /* Look at each source with a zero block time, then sleep a tick before looking again. */
+        ui32Ready = SELECT_RX | SELECT_SW1;
+#endif
+
+        /* A bit only says something arrived, so empty each source before waiting again. */
+        if ((ui32Ready & SELECT_SW1) != 0)
+        {
+            while (xSemaphoreTake (xSW1Semaphore, 0) == pdTRUE)
             {
-            case 'r':
-            case 'g':
-            case 'b':
-                /* if the queue is full, wait for upwards to 100 ticks, until there is an empty slot in the queue.*/
-                if( xQueueSend(xQueue1, (void *) &ReceivedCharacter, (TickType_t) 100) != pdPASS )
+                Command_Handle ('o');
+            }
+        }
+        if ((ui32Ready & SELECT_RX) != 0)
+        {
+            while (Rx_Read (&ReceivedCharacter) == true)
+            {
+                if (Proto_Receive (ReceivedCharacter) == false)
                 {
-                    /* if the queue wasn't freed for over 100 ticks, then send this error message on the screen and carry on. */
-                    UART_sendString (UART0_BASE, "The last color preference will be unable to be used. \n\r");
+                    Command_Handle (ReceivedCharacter);
                 }
             }
+        }
+
+        /* After the frames, so a CMD_BAUD reply is out before the rate changes. */
+        Console_updateBaud ();
+
+#if (CMD_USE_SELECT == 0)
+        vTaskDelay (1);
+#endif
     }
 }
 
@@ -190,13 +922,19 @@ void vTask2 (void * pvParameters)
     /* Create a variable that stores the initial of the color to be used. */
     uint8_t Leds_State = LEDS_OFF;
 
+    /* Cycles from the character being read to the LEDS changing. */
+    uint32_t Latency;
+
+    /* This is an I/O task that never uses floats, so drop its FPU access to keep its context switches cheap. */
+    portTASK_DOES_NOT_USE_FLOATING_POINT();
+
     while (1)
     {
         /* Receive the initial from the queue and store in the variable Leds_State.
-         * These queues will not block if empty, as its not a rule that the user has to constantly change the color
-         * and also we wont use the if statement here, we used in the xQueueSend for the same reason.
+         * Block until the user changes the color, the LEDS keep their last state meanwhile,
+         * and the idle time left over is what the clock governor measures.
          */
-        xQueueReceive(xQueue1, &(Leds_State), (TickType_t) 0);
+        xQueueReceive(xQueue1, &(Leds_State), portMAX_DELAY);
 
         /* Constantly check if the Leds_State was updated. */
         switch (Leds_State)
@@ -210,6 +948,16 @@ void vTask2 (void * pvParameters)
         case 'g':
             GPIOPinWrite(GPIO_PORTF_BASE, LEDS, GREEN);
             break;
+        case 'o':
+            GPIOPinWrite(GPIO_PORTF_BASE, LEDS, LEDS_OFF);
+            break;
+        }
+
+        Latency = portGET_RUN_TIME_COUNTER_VALUE() - EventStamp;
+        LatencyLast = Latency;
+        if (Latency > LatencyMax)
+        {
+            LatencyMax = Latency;
         }
     }
 }
@@ -251,14 +999,30 @@ void vTask4 (void * pvParameters)
 }
 */
 
+/*****************************************************************************/
+/*                                  Idle Hook                                */
+/*****************************************************************************/
+
+void vApplicationIdleHook (void)
+{
+    /* Run the co-routines and the actors, they all share the stack of the idle task instead of
+     * each having its own. Their run time is counted as idle by the clock governor. */
+    Actors_Create ();
+    Actors_Schedule ();
+    vCoRoutineSchedule ();
+}
+
 /*****************************************************************************/
 /*                               Main Function                               */
 /*****************************************************************************/
 
 int main (void)
 {
-    /* Enable Clock of MCU with no Pre-Scalar, use OSC, main oscillator source, 16MHz external crystal frequency*/
-    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    /* Give the free SRAM to the heap first, every init below may allocate from it. */
+    Heap_Init ();
+
+    /* Initialize Clock with 80 Mhz from the PLL, the kernel tick and the UART divisors are derived from it. */
+    Clock_Init ();
 
     /* Initialize PORTF through PINS PF1, PF2 and PF3 to be used as LEDS. */
     PORTF_Init ();
@@ -266,6 +1030,23 @@ int main (void)
     /* Initialize UART0 through PINS PA0 and PA2 as Rx and Tx. / */
     UART0_Init ();
 
+    /* The diagnostics below are LOG() records, sent by the log task once the scheduler runs, read them with log_decode.py. */
+    Log_Init (&xConsole);
+
+    /* Make sure the clock the tick and the baud rate were computed from is the one actually running. */
+    if (Clock_verify () == false)
+    {
+        LOG ("The system clock could not be verified at 80 MHz, timing computed for %u Hz may be inaccurate.", Clock_getFrequency ());
+    }
+
+#if (GATEWAY_USE == 1)
+    /* The ports of the gateway are registered with the clock like UART0, so their rates follow the governor. */
+    if (Gateway_Init () == false)
+    {
+        LOG ("The gateway could not open its ports at %u baud, they are not bridged.", GATEWAY_BAUD);
+    }
+#endif
+
     /* Create 4 handles for our 4 tasks. */
     TaskHandle_t First_Handle, Second_Handle; // Third_Handle, Fourth_Handle;
 
@@ -276,6 +1057,15 @@ int main (void)
     xTaskCreate(vTask1, "Task_UART_RECEIVE",  STACK_SIZE_TASK_1, NULL, 2, &First_Handle);
     xTaskCreate(vTask2, "Task_LEDS_COLOUR",   STACK_SIZE_TASK_2, NULL, 1, &Second_Handle);
 
+    /* The latency test only runs when t is entered, until then its tasks stay blocked. */
+    Latency_Init ();
+
+    /* Same for the task the kernel benchmark switches to, entered with k. */
+    Bench_Init ();
+
+    /* The governor runs at the highest priority so the load is sampled on time, it only runs once per period. */
+    xTaskCreate(Governor_Task, "Task_GOVERNOR", STACK_SIZE_GOVERNOR, NULL, configMAX_PRIORITIES - 1, NULL);
+
     /*
     xTaskCreate(vTask3, "Task_BUTTON_TOGGLE", STACK_SIZE_TASK_3, NULL, 3, &Third_Handle);
     xTaskCreate(vTask4, "Task_BUTTON_OFF",    STACK_SIZE_TASK_4, NULL, 4, &Fourth_Handle);
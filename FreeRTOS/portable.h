@@ -150,6 +150,15 @@ typedef struct xHeapStats
     size_t xNumberOfSuccessfulFrees;            /* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+/* Used to pass the use of each heap region out of uxPortGetHeapRegionStats(). */
+typedef struct xHeapRegionStats
+{
+    uint8_t * pucStartAddress;                  /* The start of the region once aligned. */
+    size_t xSizeInBytes;                        /* The bytes of the region the blocks can use, the alignment and the end marker taken off. */
+    size_t xAvailableHeapSpaceInBytes;          /* The sum of the free blocks of the region. */
+    size_t xSizeOfLargestFreeBlockInBytes;      /* The largest block that can be allocated from the region. */
+} HeapRegionStats_t;
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -169,6 +178,14 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+/*
+ * Fill pxRegionStats with the use of up to uxMaxRegions of the regions given
+ * to vPortDefineHeapRegions(), in the same order, returns the number filled.
+ * Only heap_5.c implements it.
+ */
+UBaseType_t uxPortGetHeapRegionStats( HeapRegionStats_t * pxRegionStats,
+                                      UBaseType_t uxMaxRegions ) PRIVILEGED_FUNCTION;
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -178,6 +195,38 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * With configUSE_HEAP_TAGS set to 1 every allocated block also records the
+ * task that allocated it and the file and line of the pvPortMalloc() call, at
+ * the cost of a larger block header.  Only heap_2.c and heap_5.c implement it.
+ */
+#if ( configUSE_HEAP_TAGS == 1 )
+    /* Used to pass the heap in use, summed by owner and call site, out of
+     * uxPortGetHeapTags(). */
+    typedef struct xHeapTag
+    {
+        void * pvOwner;     /* The handle of the task that allocated the blocks, NULL if they were allocated before the scheduler started. */
+        const char * pcFile;
+        uint32_t ulLine;
+        size_t xBytes;      /* The bytes in use, block headers included. */
+        size_t xBlocks;
+    } HeapTag_t;
+
+    void * pvPortMallocFrom( size_t xSize,
+                             const char * pcFile,
+                             uint32_t ulLine ) PRIVILEGED_FUNCTION;
+    #define pvPortMalloc( xSize )    pvPortMallocFrom( ( xSize ), __FILE__, __LINE__ )
+
+/*
+ * Fill pxTags with up to uxMaxTags different owner and call site pairs that
+ * hold memory, returns the number filled.  Blocks that do not fit once the
+ * array is full are not counted.  The owner of a block allocated by a task
+ * that has since been deleted is a stale handle.
+ */
+    UBaseType_t uxPortGetHeapTags( HeapTag_t * pxTags,
+                                   UBaseType_t uxMaxTags ) PRIVILEGED_FUNCTION;
+#endif
+
 #if( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
     void *pvPortMallocStack( size_t xSize ) PRIVILEGED_FUNCTION;
     void vPortFreeStack( void *pv ) PRIVILEGED_FUNCTION;
@@ -76,6 +76,61 @@
     #define portBYTE_ALIGNMENT    8
 /*-----------------------------------------------------------*/
 
+/* Compiler specifics.  The port is written against the TI compiler
+ * intrinsics, when it is built with GCC instead (see gcc/Makefile) these stand
+ * in for them. */
+    #ifndef __TI_ARM__
+        static inline __attribute__( ( always_inline ) ) uint32_t _set_interrupt_priority( uint32_t ulNewMaskValue )
+        {
+            uint32_t ulOriginalBASEPRI;
+
+            __asm volatile
+            (
+                "	mrs %0, basepri	\n"
+                "	msr basepri, %1	\n"
+                : "=&r" ( ulOriginalBASEPRI ) : "r" ( ulNewMaskValue ) : "memory"
+            );
+
+            return ulOriginalBASEPRI;
+        }
+
+        #define __clz( x )          __builtin_clz( x )
+
+/* The exclusive loads and stores the TI compiler has as intrinsics. */
+        static inline __attribute__( ( always_inline ) ) uint32_t __ldrex( volatile void * pvAddress )
+        {
+            uint32_t ulValue;
+
+            __asm volatile ( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pvAddress ) : "memory" );
+
+            return ulValue;
+        }
+
+        static inline __attribute__( ( always_inline ) ) uint32_t __strex( uint32_t ulValue,
+                                                                             volatile void * pvAddress )
+        {
+            uint32_t ulFailed;
+
+            __asm volatile ( "strex %0, %1, [%2]" : "=&r" ( ulFailed ) : "r" ( ulValue ), "r" ( pvAddress ) : "memory" );
+
+            return ulFailed;
+        }
+
+/* vTaskSwitchContext() is only called from the assembly of
+ * xPortPendSVHandler(), keep link time optimisation from removing it. */
+        #define portDONT_DISCARD    __attribute__( ( used ) )
+        #define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
+
+        #define portMEMORY_BARRIER()     __asm volatile ( "dmb" ::: "memory" )
+        #define portCLEAR_EXCLUSIVE()    __asm volatile ( "clrex" ::: "memory" )
+    #else
+        #define portFORCE_INLINE         inline
+
+        #define portMEMORY_BARRIER()     __asm( "	dmb" )
+        #define portCLEAR_EXCLUSIVE()    __asm( "	clrex" )
+    #endif /* __TI_ARM__ */
+/*-----------------------------------------------------------*/
+
 /* Scheduler utilities. */
     #define portYIELD()                                 \
     {                                                   \
@@ -118,6 +173,8 @@
 /* Critical section management. */
     extern void vPortEnterCritical( void );
     extern void vPortExitCritical( void );
+    extern void vPortEnterCriticalFrom( const char * pcFile,
+                                        uint32_t ulLine );
 
     #define portDISABLE_INTERRUPTS()                                     \
     {                                                                    \
@@ -127,12 +184,81 @@
     }
 
     #define portENABLE_INTERRUPTS()                   _set_interrupt_priority( 0 )
-    #define portENTER_CRITICAL()                      vPortEnterCritical()
+
+/* With the critical section statistics of critstats.h, each critical section
+ * is charged to the file and line that entered it. */
+    #if ( configUSE_CRITICAL_STATS == 1 )
+        #define portENTER_CRITICAL()                  vPortEnterCriticalFrom( __FILE__, __LINE__ )
+    #else
+        #define portENTER_CRITICAL()                  vPortEnterCritical()
+    #endif
     #define portEXIT_CRITICAL()                       vPortExitCritical()
     #define portSET_INTERRUPT_MASK_FROM_ISR()         _set_interrupt_priority( configMAX_SYSCALL_INTERRUPT_PRIORITY ); __asm( "	dsb" ); __asm( "	isb")
     #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    _set_interrupt_priority( x )
 /*-----------------------------------------------------------*/
 
+/* Recompute the SysTick reload after the core clock frequency has changed. */
+    extern void vPortRetuneTimerInterrupt( void );
+/*-----------------------------------------------------------*/
+
+/* Exclusive access, for atomic.h and the fast mutexes of fastmutex.h.  Each
+ * operation is an ldrex/strex loop inlined where it is used, so it neither
+ * masks interrupts nor costs a call.  A strex fails if an interrupt or a
+ * context switch came in since its ldrex, as exception entry and return clear
+ * the exclusive monitor, and the loop then starts over.  The dmb on each side
+ * orders the accesses around them like a critical section would. */
+    #define portHAS_EXCLUSIVE_ACCESS    1
+
+/* Store ulNew in *pulDestination only if it still holds ulExpected.  Returns
+ * pdTRUE if it was stored. */
+    static portFORCE_INLINE BaseType_t xPortCompareAndSwap( volatile uint32_t * pulDestination,
+                                                            uint32_t ulExpected,
+                                                            uint32_t ulNew )
+    {
+        portMEMORY_BARRIER();
+
+        do
+        {
+            if( ( uint32_t ) __ldrex( ( void * ) pulDestination ) != ulExpected )
+            {
+                portCLEAR_EXCLUSIVE();
+                return pdFALSE;
+            }
+        } while( __strex( ulNew, ( void * ) pulDestination ) != 0 );
+
+        portMEMORY_BARRIER();
+
+        return pdTRUE;
+    }
+
+/* The other operations of atomic.h, each returns the value *pulDestination
+ * held before. */
+    #define portATOMIC_OPERATION( xName, xNewValue )                                   \
+    static portFORCE_INLINE uint32_t xName( volatile uint32_t * pulDestination,      \
+                                            uint32_t ulValue )                       \
+    {                                                                                \
+        uint32_t ulOld;                                                              \
+                                                                                     \
+        portMEMORY_BARRIER();                                                        \
+                                                                                     \
+        do                                                                           \
+        {                                                                            \
+            ulOld = ( uint32_t ) __ldrex( ( void * ) pulDestination );               \
+        } while( __strex( ( xNewValue ), ( void * ) pulDestination ) != 0 );         \
+                                                                                     \
+        portMEMORY_BARRIER();                                                        \
+                                                                                     \
+        return ulOld;                                                                \
+    }
+
+    portATOMIC_OPERATION( ulPortAtomicSwap, ulValue )
+    portATOMIC_OPERATION( ulPortAtomicAdd, ulOld + ulValue )
+    portATOMIC_OPERATION( ulPortAtomicOR, ulOld | ulValue )
+    portATOMIC_OPERATION( ulPortAtomicAND, ulOld & ulValue )
+    portATOMIC_OPERATION( ulPortAtomicNAND, ~( ulOld & ulValue ) )
+    portATOMIC_OPERATION( ulPortAtomicXOR, ulOld ^ ulValue )
+/*-----------------------------------------------------------*/
+
 /* Tickless idle/low power functionality. */
     #ifndef portSUPPRESS_TICKS_AND_SLEEP
         extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
@@ -141,6 +267,29 @@
 
 /*-----------------------------------------------------------*/
 
+/* Per task FPU attributes.  A task that never uses the FPU can drop its
+ * floating point access so it cannot accidentally acquire a floating point
+ * context (it takes a usage fault instead), which keeps its context switches
+ * free of the s16-s31 save and restore.  The attribute values are the CP10 and
+ * CP11 access bits of the CPACR.
+ *
+ * The CPACR is not switched on exception entry, so an interrupt that comes in
+ * while a task without FPU access runs has none either.  Such an interrupt
+ * handler must not use the FPU, not even through a function it calls: its
+ * first floating point instruction raises a NOCP UsageFault.  Handlers that
+ * need floats can only be used with every task keeping its FPU access. */
+    #define portFPU_ATTRIBUTE_NONE    ( 0x00000000UL )
+    #define portFPU_ATTRIBUTE_FULL    ( 0x00f00000UL )
+
+    extern void vPortTaskSetFPUAttribute( uint32_t ulAttribute );
+    extern void vPortResetFPUContext( void );
+
+    #define portTASK_USES_FLOATING_POINT()             vPortTaskSetFPUAttribute( portFPU_ATTRIBUTE_FULL )
+    #define portTASK_DOES_NOT_USE_FLOATING_POINT()     vPortTaskSetFPUAttribute( portFPU_ATTRIBUTE_NONE )
+    #define portRESET_FPU_CONTEXT()                    vPortResetFPUContext()
+
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
  * not necessary for to use this port.  They are defined so the common demo files
  * (which build with all the ports) will build. */
@@ -156,6 +305,11 @@
 /* portNOP() is not required by this port. */
     #define portNOP()
 
+/* The functions on the context switch, tick and receive interrupt paths are
+ * linked into .hot_text, so the linker command file can run them from SRAM
+ * instead of from flash, which needs wait states at 80 MHz. */
+    #define portHOT_FUNCTION    __attribute__( ( section( ".hot_text" ) ) )
+
 /*-----------------------------------------------------------*/
 
     #ifdef __cplusplus
@@ -0,0 +1,530 @@
+/*
+ * Formatted output for the tasks, see print.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+/* Header Files Includes.  */
+#include "print.h"
+
+/* TivaWare includes.  */
+#include "driverlib/uart.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "fastmutex.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define PRINT_LEFT          0x01
+#define PRINT_ZERO          0x02
+#define PRINT_PLUS          0x04
+
+/* Enough for the 10 digits of a 32 bit number, a point and 9 decimals of %q. */
+#define PRINT_DIGITS_SIZE   24
+#define PRINT_Q_MAX         9
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    char *pcBuffer;
+    uint32_t ui32Size;
+    uint32_t ui32Used;
+    /* Characters of the whole output, those cut off by Print_snprintf() included. */
+    uint32_t ui32Total;
+    /* NULL when formatting to a string, which is then cut at ui32Size. */
+    Print_Sink *psSink;
+    bool bLocked;
+} Print_Out;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* Every number below 100 as two digits, so a decimal number takes one division for two of them. */
+static const char pcPrintPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char pcPrintHexLower[] = "0123456789abcdef";
+static const char pcPrintHexUpper[] = "0123456789ABCDEF";
+
+static const uint32_t ui32PrintPow10[PRINT_Q_MAX + 1] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/*****************************************************************************/
+/*                                Output Functions                           */
+/*****************************************************************************/
+
+/* Hand what was formatted to the sink, taking its mutex on the first write of the call. */
+static void Print_flush (Print_Out *psOut)
+{
+    if ((psOut->psSink == NULL) || (psOut->ui32Used == 0))
+    {
+        return;
+    }
+
+    /* Before the scheduler starts there is only main() to print, and no mutex can be taken. */
+    if ((psOut->bLocked == false) && (xTaskGetSchedulerState () == taskSCHEDULER_RUNNING))
+    {
+        xFastMutexTake (&psOut->psSink->xLock, portMAX_DELAY);
+        psOut->bLocked = true;
+    }
+
+    psOut->psSink->pfnWrite (psOut->psSink->pvContext, psOut->pcBuffer, psOut->ui32Used);
+    psOut->ui32Used = 0;
+}
+
+static void Print_put (Print_Out *psOut, const char *pcData, uint32_t ui32Length)
+{
+    uint32_t i;
+
+    psOut->ui32Total += ui32Length;
+
+    for (i = 0; i < ui32Length; i++)
+    {
+        if (psOut->ui32Used == psOut->ui32Size)
+        {
+            if (psOut->psSink == NULL)
+            {
+                return;
+            }
+            Print_flush (psOut);
+        }
+        psOut->pcBuffer[psOut->ui32Used++] = pcData[i];
+    }
+}
+
+static void Print_pad (Print_Out *psOut, char cPad, int32_t i32Count)
+{
+    while (i32Count > 0)
+    {
+        Print_put (psOut, &cPad, 1);
+        i32Count--;
+    }
+}
+
+/* Write pcDigits, with the sign if there is one, padded to i32Width. i32Precision is the least number
+ * of digits of an integer, made up with zeros, which replaces the '0' flag as in printf(), and
+ * a precision of 0 prints no digit for a value of 0. It is -1 when there is none, and for the
+ * conversions that are not integers. */
+static void Print_field (Print_Out *psOut, const char *pcDigits, uint32_t ui32Length, char cSign,
+                         uint32_t ui32Flags, int32_t i32Width, int32_t i32Precision)
+{
+    int32_t i32Zeros = 0;
+    int32_t i32Pad;
+
+    if (i32Precision >= 0)
+    {
+        ui32Flags &= ~PRINT_ZERO;
+        if ((i32Precision == 0) && (ui32Length == 1) && (pcDigits[0] == '0'))
+        {
+            ui32Length = 0;
+        }
+        if (i32Precision > (int32_t) ui32Length)
+        {
+            i32Zeros = i32Precision - (int32_t) ui32Length;
+        }
+    }
+
+    i32Pad = i32Width - (int32_t) ui32Length - i32Zeros - ((cSign != 0) ? 1 : 0);
+
+    if ((ui32Flags & (PRINT_LEFT | PRINT_ZERO)) == 0)
+    {
+        Print_pad (psOut, ' ', i32Pad);
+    }
+    if (cSign != 0)
+    {
+        Print_put (psOut, &cSign, 1);
+    }
+    if ((ui32Flags & (PRINT_LEFT | PRINT_ZERO)) == PRINT_ZERO)
+    {
+        Print_pad (psOut, '0', i32Pad);
+    }
+
+    Print_pad (psOut, '0', i32Zeros);
+    Print_put (psOut, pcDigits, ui32Length);
+
+    if ((ui32Flags & PRINT_LEFT) != 0)
+    {
+        Print_pad (psOut, ' ', i32Pad);
+    }
+}
+
+/*****************************************************************************/
+/*                              Number Functions                             */
+/*****************************************************************************/
+
+/* The digits are written backwards, ending just before pcEnd, and the first one is returned. */
+
+static char *Print_decimal (char *pcEnd, uint32_t ui32Value)
+{
+    uint32_t ui32Pair;
+
+    while (ui32Value >= 100)
+    {
+        ui32Pair = (ui32Value % 100) * 2;
+        ui32Value /= 100;
+        *--pcEnd = pcPrintPairs[ui32Pair + 1];
+        *--pcEnd = pcPrintPairs[ui32Pair];
+    }
+
+    if (ui32Value >= 10)
+    {
+        *--pcEnd = pcPrintPairs[(ui32Value * 2) + 1];
+        *--pcEnd = pcPrintPairs[ui32Value * 2];
+    }
+    else
+    {
+        *--pcEnd = '0' + ui32Value;
+    }
+
+    return pcEnd;
+}
+
+static char *Print_hex (char *pcEnd, uint32_t ui32Value, const char *pcDigits, uint32_t ui32MinDigits)
+{
+    do
+    {
+        *--pcEnd = pcDigits[ui32Value & 0xF];
+        ui32Value >>= 4;
+        if (ui32MinDigits != 0)
+        {
+            ui32MinDigits--;
+        }
+    } while ((ui32Value != 0) || (ui32MinDigits != 0));
+
+    return pcEnd;
+}
+
+/* ui32Value counts units of 10^-ui32Places. */
+static char *Print_fixed (char *pcEnd, uint32_t ui32Value, uint32_t ui32Places)
+{
+    uint32_t ui32Scale = ui32PrintPow10[ui32Places];
+    char *pcFraction = pcEnd - ui32Places;
+    char *pcStart;
+
+    if (ui32Places == 0)
+    {
+        return Print_decimal (pcEnd, ui32Value);
+    }
+
+    /* The decimals with their leading zeros, then the point and the integer part. */
+    pcStart = Print_decimal (pcEnd, ui32Value % ui32Scale);
+    while (pcStart > pcFraction)
+    {
+        *--pcStart = '0';
+    }
+    *--pcStart = '.';
+
+    return Print_decimal (pcStart, ui32Value / ui32Scale);
+}
+
+/*****************************************************************************/
+/*                              Format Functions                             */
+/*****************************************************************************/
+
+static void Print_format (Print_Out *psOut, const char *pcFormat, va_list xArgs)
+{
+    char pcDigits[PRINT_DIGITS_SIZE];
+    char *pcEnd = &pcDigits[PRINT_DIGITS_SIZE];
+    const char *pcStart;
+    const char *pcString;
+    char *pcNumber;
+    uint32_t ui32Flags, ui32Value, ui32Length;
+    int32_t i32Width, i32Precision, i32Value;
+    char cSign;
+
+    while (*pcFormat != '\0')
+    {
+        /* Copy the text up to the next conversion in one go. */
+        pcStart = pcFormat;
+        while ((*pcFormat != '\0') && (*pcFormat != '%'))
+        {
+            pcFormat++;
+        }
+        Print_put (psOut, pcStart, pcFormat - pcStart);
+
+        if (*pcFormat == '\0')
+        {
+            break;
+        }
+        pcFormat++;
+
+        /* Flags. */
+        ui32Flags = 0;
+        while (1)
+        {
+            if (*pcFormat == '-')
+            {
+                ui32Flags |= PRINT_LEFT;
+            }
+            else if (*pcFormat == '0')
+            {
+                ui32Flags |= PRINT_ZERO;
+            }
+            else if (*pcFormat == '+')
+            {
+                ui32Flags |= PRINT_PLUS;
+            }
+            else
+            {
+                break;
+            }
+            pcFormat++;
+        }
+
+        /* Width and precision. */
+        i32Width = 0;
+        if (*pcFormat == '*')
+        {
+            i32Width = va_arg (xArgs, int32_t);
+            if (i32Width < 0)
+            {
+                ui32Flags |= PRINT_LEFT;
+                i32Width = -i32Width;
+            }
+            pcFormat++;
+        }
+        while ((*pcFormat >= '0') && (*pcFormat <= '9'))
+        {
+            i32Width = (i32Width * 10) + (*pcFormat++ - '0');
+        }
+
+        i32Precision = -1;
+        if (*pcFormat == '.')
+        {
+            pcFormat++;
+            i32Precision = 0;
+            if (*pcFormat == '*')
+            {
+                /* A negative one is taken as none, as in printf(). */
+                i32Precision = va_arg (xArgs, int32_t);
+                if (i32Precision < 0)
+                {
+                    i32Precision = -1;
+                }
+                pcFormat++;
+            }
+            while ((*pcFormat >= '0') && (*pcFormat <= '9'))
+            {
+                i32Precision = (i32Precision * 10) + (*pcFormat++ - '0');
+            }
+        }
+
+        /* Every argument is 32 bits already. */
+        while ((*pcFormat == 'l') || (*pcFormat == 'h'))
+        {
+            pcFormat++;
+        }
+
+        cSign = 0;
+
+        switch (*pcFormat)
+        {
+        case 'd':
+        case 'i':
+        case 'q':
+            i32Value = va_arg (xArgs, int32_t);
+            if (i32Value < 0)
+            {
+                cSign = '-';
+                ui32Value = 0 - (uint32_t) i32Value;
+            }
+            else
+            {
+                cSign = ((ui32Flags & PRINT_PLUS) != 0) ? '+' : 0;
+                ui32Value = (uint32_t) i32Value;
+            }
+            if (*pcFormat == 'q')
+            {
+                if (i32Precision > PRINT_Q_MAX)
+                {
+                    i32Precision = PRINT_Q_MAX;
+                }
+                pcNumber = Print_fixed (pcEnd, ui32Value, (i32Precision < 0) ? 0 : i32Precision);
+                /* The precision of %q is its decimals, not a number of digits. */
+                i32Precision = -1;
+            }
+            else
+            {
+                pcNumber = Print_decimal (pcEnd, ui32Value);
+            }
+            Print_field (psOut, pcNumber, pcEnd - pcNumber, cSign, ui32Flags, i32Width, i32Precision);
+            break;
+        case 'u':
+            pcNumber = Print_decimal (pcEnd, va_arg (xArgs, uint32_t));
+            Print_field (psOut, pcNumber, pcEnd - pcNumber, 0, ui32Flags, i32Width, i32Precision);
+            break;
+        case 'x':
+        case 'X':
+            pcNumber = Print_hex (pcEnd, va_arg (xArgs, uint32_t), (*pcFormat == 'x') ? pcPrintHexLower : pcPrintHexUpper, 0);
+            Print_field (psOut, pcNumber, pcEnd - pcNumber, 0, ui32Flags, i32Width, i32Precision);
+            break;
+        case 'p':
+            pcNumber = Print_hex (pcEnd, (uint32_t) va_arg (xArgs, void *), pcPrintHexLower, 8);
+            *--pcNumber = 'x';
+            *--pcNumber = '0';
+            Print_field (psOut, pcNumber, pcEnd - pcNumber, 0, ui32Flags & PRINT_LEFT, i32Width, -1);
+            break;
+        case 'c':
+            pcDigits[0] = (char) va_arg (xArgs, int32_t);
+            Print_field (psOut, pcDigits, 1, 0, ui32Flags & PRINT_LEFT, i32Width, -1);
+            break;
+        case 's':
+            pcString = va_arg (xArgs, const char *);
+            if (pcString == NULL)
+            {
+                pcString = "(null)";
+            }
+            /* The precision is the most characters taken from the string. */
+            for (ui32Length = 0; pcString[ui32Length] != '\0'; ui32Length++)
+            {
+                if ((i32Precision >= 0) && (ui32Length == (uint32_t) i32Precision))
+                {
+                    break;
+                }
+            }
+            Print_field (psOut, pcString, ui32Length, 0, ui32Flags & PRINT_LEFT, i32Width, -1);
+            break;
+        case '%':
+            Print_put (psOut, "%", 1);
+            break;
+        case '\0':
+            /* A lone % at the end. */
+            return;
+        default:
+            /* Not a conversion this knows, print it as it is. */
+            Print_put (psOut, pcFormat - 1, 2);
+            break;
+        }
+
+        pcFormat++;
+    }
+}
+
+/*****************************************************************************/
+/*                                 Main Functions                            */
+/*****************************************************************************/
+
+void Print_SinkInit (Print_Sink *psSink, Print_Write pfnWrite, void *pvContext)
+{
+    psSink->pfnWrite = pfnWrite;
+    psSink->pvContext = pvContext;
+    vFastMutexInit (&psSink->xLock);
+}
+
+void Print_UARTWrite (void *pvContext, const char *pcData, uint32_t ui32Length)
+{
+    uint32_t i;
+
+    for (i = 0; i < ui32Length; i++)
+    {
+        UARTCharPut ((uint32_t) pvContext, pcData[i]);
+    }
+}
+
+void Print_write (Print_Sink *psSink, const char *pcData, uint32_t ui32Length)
+{
+    Print_Out xOut = {(char *) pcData, ui32Length, ui32Length, ui32Length, psSink, false};
+
+    Print_flush (&xOut);
+
+    if (xOut.bLocked == true)
+    {
+        xFastMutexGive (&psSink->xLock);
+    }
+}
+
+void Print_lock (Print_Sink *psSink)
+{
+    if (xTaskGetSchedulerState () == taskSCHEDULER_RUNNING)
+    {
+        xFastMutexTake (&psSink->xLock, portMAX_DELAY);
+    }
+}
+
+void Print_unlock (Print_Sink *psSink)
+{
+    if (xTaskGetSchedulerState () == taskSCHEDULER_RUNNING)
+    {
+        xFastMutexGive (&psSink->xLock);
+    }
+}
+
+uint32_t Print_vprintf (Print_Sink *psSink, const char *pcFormat, va_list xArgs)
+{
+    char pcBuffer[PRINT_BUFFER_SIZE];
+    Print_Out xOut = {pcBuffer, PRINT_BUFFER_SIZE, 0, 0, psSink, false};
+
+    Print_format (&xOut, pcFormat, xArgs);
+    Print_flush (&xOut);
+
+    if (xOut.bLocked == true)
+    {
+        xFastMutexGive (&psSink->xLock);
+    }
+
+    return xOut.ui32Total;
+}
+
+uint32_t Print_printf (Print_Sink *psSink, const char *pcFormat, ...)
+{
+    va_list xArgs;
+    uint32_t ui32Total;
+
+    va_start (xArgs, pcFormat);
+    ui32Total = Print_vprintf (psSink, pcFormat, xArgs);
+    va_end (xArgs);
+
+    return ui32Total;
+}
+
+uint32_t Print_vsnprintf (char *pcBuffer, uint32_t ui32Size, const char *pcFormat, va_list xArgs)
+{
+    Print_Out xOut = {pcBuffer, (ui32Size == 0) ? 0 : (ui32Size - 1), 0, 0, NULL, false};
+
+    Print_format (&xOut, pcFormat, xArgs);
+
+    if (ui32Size != 0)
+    {
+        pcBuffer[xOut.ui32Used] = '\0';
+    }
+
+    return xOut.ui32Total;
+}
+
+uint32_t Print_snprintf (char *pcBuffer, uint32_t ui32Size, const char *pcFormat, ...)
+{
+    va_list xArgs;
+    uint32_t ui32Total;
+
+    va_start (xArgs, pcFormat);
+    ui32Total = Print_vsnprintf (pcBuffer, ui32Size, pcFormat, xArgs);
+    va_end (xArgs);
+
+    return ui32Total;
+}
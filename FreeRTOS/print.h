@@ -0,0 +1,93 @@
+/*
+ * Formatted output for the tasks, in place of UARTprintf() of utils/uartstdio,
+ * which keeps its state in globals and cannot be called from two tasks.
+ *
+ * Nothing is allocated and nothing is shared while formatting: every call
+ * formats into a buffer on the stack of the calling task, and only hands full
+ * buffers to a sink. A sink is a write function with a mutex around it, held
+ * from the first write of a call to its end, so the lines printed by
+ * different tasks never mix. The mutex is a fast one, see fastmutex.h, as it
+ * is almost never contended and is taken for every line printed.
+ * Print_UARTWrite() makes any UART a sink, another driver only needs a
+ * function of the same type.
+ *
+ * The conversions supported, with the flags '-', '0' and '+', a width and a
+ * precision, both of which can be '*':
+ *  - %d %i %u, decimal, two digits per division,
+ *  - %x %X, hexadecimal, from shifts only,
+ *    the precision of both is the least number of digits, as in printf(),
+ *  - %c %s %p %%,
+ *  - %.Nq, a fixed point number, the integer argument counts units of 10^-N,
+ *    so %.3q prints 1234 as 1.234, without any float.
+ * The arguments are 32 bits, l and h are accepted and ignored.
+ */
+
+#ifndef PRINT_H
+#define PRINT_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "fastmutex.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Bytes formatted on the stack of the calling task before they are written to the sink,
+ * a line of the console fits in one write. */
+#define PRINT_BUFFER_SIZE   80
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+/* Write ui32Length bytes of pcData, called with the mutex of the sink held. */
+typedef void (*Print_Write) (void *pvContext, const char *pcData, uint32_t ui32Length);
+
+typedef struct
+{
+    Print_Write pfnWrite;
+    void *pvContext;
+    FastMutex_t xLock;
+} Print_Sink;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Set up the sink and its mutex, nothing is allocated. */
+void Print_SinkInit (Print_Sink *psSink, Print_Write pfnWrite, void *pvContext);
+
+/* A Print_Write for a UART of driverlib, pvContext is its base address. */
+void Print_UARTWrite (void *pvContext, const char *pcData, uint32_t ui32Length);
+
+/* Write ui32Length bytes as they are, in one go under the mutex of the sink, from tasks only,
+ * or from main() before the scheduler starts. For the binary frames and records sent between
+ * the lines of text. */
+void Print_write (Print_Sink *psSink, const char *pcData, uint32_t ui32Length);
+
+/* Keep the other tasks from writing to the sink, while its UART changes rate for instance. The mutex
+ * is not recursive, nothing can be printed to the sink by the task holding it. */
+void Print_lock (Print_Sink *psSink);
+void Print_unlock (Print_Sink *psSink);
+
+/* Format to the sink, from tasks only, or from main() before the scheduler starts.
+ * Return the number of characters written. */
+uint32_t Print_printf (Print_Sink *psSink, const char *pcFormat, ...);
+uint32_t Print_vprintf (Print_Sink *psSink, const char *pcFormat, va_list xArgs);
+
+/* Format to pcBuffer, cut at ui32Size - 1 characters and always terminated. Can be called from
+ * anywhere, interrupts included. Return the number of characters the whole output needs. */
+uint32_t Print_snprintf (char *pcBuffer, uint32_t ui32Size, const char *pcFormat, ...);
+uint32_t Print_vsnprintf (char *pcBuffer, uint32_t ui32Size, const char *pcFormat, va_list xArgs);
+
+#endif /* PRINT_H */
@@ -0,0 +1,321 @@
+/*
+ * Framed binary command protocol, see proto.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "proto.h"
+#include "cobs.h"
+#include "crc.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define PROTO_CRC_SIZE          (PROTO_CRC_BITS / 8)
+#define PROTO_ENCODED_MAX       COBS_ENCODED_MAX (PROTO_FRAME_MAX)
+
+/* Id, status and length in front of the reply of every command. */
+#define PROTO_REPLY_HEADER      3
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static const Proto_Command *psProtoCommands;
+static uint32_t ui32ProtoCommandCount;
+static Print_Sink *psProtoSink;
+
+/* The frame being received, still encoded, then decoded in place. */
+static uint8_t ui8ProtoRx[PROTO_ENCODED_MAX];
+static uint32_t ui32ProtoRxLength;
+static bool bProtoOverflow;
+
+/* Whether the bytes received are frames or console characters, and when the last one came. */
+static bool bProtoFraming = false;
+static TickType_t xProtoLastByte;
+
+/* The reply being built, and the last one encoded with its delimiters, kept to send it again,
+ * with the sequence and the CRC of the request it answers. */
+static uint8_t ui8ProtoReply[PROTO_FRAME_MAX];
+static uint8_t ui8ProtoTx[PROTO_ENCODED_MAX + 2];
+static uint32_t ui32ProtoTxLength = 0;
+static uint8_t ui8ProtoLastSequence;
+static uint32_t ui32ProtoLastCrc;
+
+static Proto_Stats xProtoStats;
+
+/*****************************************************************************/
+/*                              Frame Functions                              */
+/*****************************************************************************/
+
+static uint32_t Proto_crc (const uint8_t *pui8Data, uint32_t ui32Length)
+{
+#if (PROTO_CRC_BITS == 32)
+    return Crc_32 (CRC32_INIT, pui8Data, ui32Length);
+#else
+    return Crc_16 (CRC16_INIT, pui8Data, ui32Length);
+#endif
+}
+
+static void Proto_putWord (uint8_t *pui8Data, uint32_t ui32Value, uint32_t ui32Bytes)
+{
+    uint32_t i;
+
+    for (i = 0; i < ui32Bytes; i++)
+    {
+        pui8Data[i] = (uint8_t) (ui32Value >> (8 * i));
+    }
+}
+
+static uint32_t Proto_getWord (const uint8_t *pui8Data, uint32_t ui32Bytes)
+{
+    uint32_t ui32Value = 0;
+    uint32_t i;
+
+    for (i = 0; i < ui32Bytes; i++)
+    {
+        ui32Value |= (uint32_t) pui8Data[i] << (8 * i);
+    }
+
+    return ui32Value;
+}
+
+static uint8_t Proto_ping (const uint8_t *pui8Args, uint32_t ui32Length, uint8_t *pui8Reply, uint32_t *pui32ReplyLength)
+{
+    uint32_t i;
+
+    if (ui32Length > *pui32ReplyLength)
+    {
+        *pui32ReplyLength = 0;
+        return PROTO_TRUNCATED;
+    }
+
+    for (i = 0; i < ui32Length; i++)
+    {
+        pui8Reply[i] = pui8Args[i];
+    }
+    *pui32ReplyLength = ui32Length;
+
+    return PROTO_OK;
+}
+
+static uint8_t Proto_stats (const uint8_t *pui8Args, uint32_t ui32Length, uint8_t *pui8Reply, uint32_t *pui32ReplyLength)
+{
+    const uint32_t *pui32Stats = (const uint32_t *) &xProtoStats;
+    uint32_t i;
+
+    if (*pui32ReplyLength < sizeof(Proto_Stats))
+    {
+        *pui32ReplyLength = 0;
+        return PROTO_TRUNCATED;
+    }
+
+    for (i = 0; i < (sizeof(Proto_Stats) / sizeof(uint32_t)); i++)
+    {
+        Proto_putWord (&pui8Reply[4 * i], pui32Stats[i], 4);
+    }
+    *pui32ReplyLength = sizeof(Proto_Stats);
+
+    return PROTO_OK;
+}
+
+static Proto_Handler Proto_find (uint8_t ui8Id)
+{
+    uint32_t i;
+
+    switch (ui8Id)
+    {
+    case PROTO_CMD_PING:
+        return Proto_ping;
+    case PROTO_CMD_STATS:
+        return Proto_stats;
+    }
+
+    for (i = 0; i < ui32ProtoCommandCount; i++)
+    {
+        if (psProtoCommands[i].ui8Id == ui8Id)
+        {
+            return psProtoCommands[i].pfnHandler;
+        }
+    }
+
+    return NULL;
+}
+
+/* A whole frame is in ui8ProtoRx, check it, run its commands and send the reply. */
+static void Proto_frame (void)
+{
+    uint32_t ui32Length, ui32In, ui32Out, ui32ArgLength, ui32ReplyLength, ui32Room, ui32Crc;
+    uint8_t ui8Sequence, ui8Id, ui8Status;
+    Proto_Handler pfnHandler;
+
+    ui32Length = Cobs_decode (ui8ProtoRx, ui32ProtoRxLength);
+    if ((bProtoOverflow == true) || (ui32Length < (1 + PROTO_CRC_SIZE)))
+    {
+        xProtoStats.ui32FramingErrors++;
+        return;
+    }
+
+    ui32Length -= PROTO_CRC_SIZE;
+    ui32Crc = Proto_crc (ui8ProtoRx, ui32Length);
+    if (ui32Crc != Proto_getWord (&ui8ProtoRx[ui32Length], PROTO_CRC_SIZE))
+    {
+        xProtoStats.ui32CrcErrors++;
+        return;
+    }
+
+    xProtoStats.ui32Frames++;
+    ui8Sequence = ui8ProtoRx[0];
+
+    if (ui32ProtoTxLength != 0)
+    {
+        /* The host did not get the reply to the last frame, send it again rather than run the commands twice.
+         * Only the same frame is, a host that started again at the same sequence sends other commands. */
+        if ((ui8Sequence == ui8ProtoLastSequence) && (ui32Crc == ui32ProtoLastCrc))
+        {
+            xProtoStats.ui32Repeats++;
+            Print_write (psProtoSink, (const char *) ui8ProtoTx, ui32ProtoTxLength);
+            return;
+        }
+        if (ui8Sequence != ui8ProtoLastSequence)
+        {
+            xProtoStats.ui32SequenceGaps += (uint8_t) (ui8Sequence - ui8ProtoLastSequence - 1);
+        }
+    }
+
+    ui8ProtoReply[0] = ui8Sequence;
+    ui32Out = 1;
+    ui32In = 1;
+
+    while ((ui32In < ui32Length) && ((ui32Out + PROTO_REPLY_HEADER) <= (PROTO_FRAME_MAX - PROTO_CRC_SIZE)))
+    {
+        ui8Id = ui8ProtoRx[ui32In];
+        ui32ReplyLength = 0;
+
+        if (((ui32In + 2) > ui32Length) || ((ui32In + 2 + ui8ProtoRx[ui32In + 1]) > ui32Length))
+        {
+            /* Nothing after this one can be trusted either. */
+            ui8Status = PROTO_TRUNCATED;
+            ui32In = ui32Length;
+        }
+        else
+        {
+            ui32ArgLength = ui8ProtoRx[ui32In + 1];
+            ui32Room = PROTO_FRAME_MAX - PROTO_CRC_SIZE - ui32Out - PROTO_REPLY_HEADER;
+            ui32ReplyLength = (ui32Room > 0xFF) ? 0xFF : ui32Room;
+
+            pfnHandler = Proto_find (ui8Id);
+            if (pfnHandler == NULL)
+            {
+                ui8Status = PROTO_UNKNOWN;
+                ui32ReplyLength = 0;
+            }
+            else
+            {
+                ui8Status = pfnHandler (&ui8ProtoRx[ui32In + 2], ui32ArgLength,
+                                        &ui8ProtoReply[ui32Out + PROTO_REPLY_HEADER], &ui32ReplyLength);
+            }
+
+            xProtoStats.ui32Commands++;
+            ui32In += 2 + ui32ArgLength;
+        }
+
+        ui8ProtoReply[ui32Out] = ui8Id;
+        ui8ProtoReply[ui32Out + 1] = ui8Status;
+        ui8ProtoReply[ui32Out + 2] = (uint8_t) ui32ReplyLength;
+        ui32Out += PROTO_REPLY_HEADER + ui32ReplyLength;
+    }
+
+    Proto_putWord (&ui8ProtoReply[ui32Out], Proto_crc (ui8ProtoReply, ui32Out), PROTO_CRC_SIZE);
+    ui32Out += PROTO_CRC_SIZE;
+
+    /* A 0 on both sides, so the host finds the frame even after console text. */
+    ui8ProtoTx[0] = 0;
+    ui32ProtoTxLength = Cobs_encode (ui8ProtoReply, ui32Out, &ui8ProtoTx[1]) + 2;
+    ui8ProtoTx[ui32ProtoTxLength - 1] = 0;
+    ui8ProtoLastSequence = ui8Sequence;
+    ui32ProtoLastCrc = ui32Crc;
+
+    Print_write (psProtoSink, (const char *) ui8ProtoTx, ui32ProtoTxLength);
+}
+
+/*****************************************************************************/
+/*                                 Main Functions                            */
+/*****************************************************************************/
+
+void Proto_Init (const Proto_Command *psCommands, uint32_t ui32Count, Print_Sink *psSink)
+{
+    psProtoCommands = psCommands;
+    ui32ProtoCommandCount = ui32Count;
+    psProtoSink = psSink;
+}
+
+bool Proto_Receive (uint8_t ui8Byte)
+{
+    TickType_t xNow = xTaskGetTickCount ();
+
+    /* The host went quiet, what comes next is typed on the console, and a frame left half way is lost.
+     * So is the reply kept, the next frame is from a new session, which may start at the same sequence. */
+    if ((bProtoFraming == true) && ((TickType_t) (xNow - xProtoLastByte) > pdMS_TO_TICKS (PROTO_IDLE_MS)))
+    {
+        bProtoFraming = false;
+        ui32ProtoTxLength = 0;
+        if (ui32ProtoRxLength != 0)
+        {
+            xProtoStats.ui32FramingErrors++;
+        }
+    }
+    xProtoLastByte = xNow;
+
+    if (bProtoFraming == false)
+    {
+        if (ui8Byte != 0)
+        {
+            return false;
+        }
+        bProtoFraming = true;
+        ui32ProtoRxLength = 0;
+        bProtoOverflow = false;
+        return true;
+    }
+
+    if (ui8Byte != 0)
+    {
+        if (ui32ProtoRxLength < PROTO_ENCODED_MAX)
+        {
+            ui8ProtoRx[ui32ProtoRxLength++] = ui8Byte;
+        }
+        else
+        {
+            bProtoOverflow = true;
+        }
+        return true;
+    }
+
+    /* Two 0 in a row are only the delimiters on both sides of a frame. */
+    if (ui32ProtoRxLength != 0)
+    {
+        Proto_frame ();
+    }
+    ui32ProtoRxLength = 0;
+    bProtoOverflow = false;
+
+    return true;
+}
+
+void Proto_getStats (Proto_Stats *psStats)
+{
+    *psStats = xProtoStats;
+}
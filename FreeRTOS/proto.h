@@ -0,0 +1,106 @@
+/*
+ * Framed binary command protocol on the console UART, next to the one
+ * character commands.
+ *
+ * A frame is COBS encoded, see cobs.h, and sent between two 0 bytes. A 0
+ * received among the characters of the console switches to frames, and it
+ * goes back to characters after PROTO_IDLE_MS without anything received, so
+ * both can share the UART. Decoded, a request frame is:
+ *
+ *   sequence, then per command: id, length, length bytes of arguments,
+ *   then the CRC-16 or CRC-32 of all of it, little endian,
+ *
+ * and the reply frame has the same sequence, then per command: id, status,
+ * length, length bytes of reply, then the CRC. A frame can carry as many
+ * commands as fit in PROTO_FRAME_MAX. A frame with a bad CRC gets no reply,
+ * the host sends it again with the same sequence, and the reply to the last
+ * frame is sent again without running its commands twice, if it comes with
+ * the same sequence and CRC before PROTO_IDLE_MS ends the session. The host
+ * starts every session at a random sequence.
+ *
+ * The frame is decoded in place in the receive buffer, and the handlers get
+ * their arguments and their reply space right in the frames, nothing is
+ * copied on the way. They run in the task that calls Proto_Receive(), and
+ * pass the commands on to the other tasks with their queues and notifications.
+ */
+
+#ifndef PROTO_H
+#define PROTO_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "print.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Decoded bytes of a frame, the sequence and the CRC included. */
+#define PROTO_FRAME_MAX         256
+
+/* 16 or 32, proto_client.py has to be told with --crc32. */
+#define PROTO_CRC_BITS          16
+
+/* Back to the one character commands after this long without a byte, and the reply kept is dropped,
+ * the host has to send a frame again sooner than that, proto_client.py does after --timeout. */
+#define PROTO_IDLE_MS           500
+
+/* Commands Proto_Receive() handles itself, the application ones start at PROTO_CMD_USER. */
+#define PROTO_CMD_PING          0x01    /* Reply with the arguments. */
+#define PROTO_CMD_STATS         0x02    /* Reply with Proto_Stats, as little endian words. */
+#define PROTO_CMD_USER          0x10
+
+/* Status of a command in the reply. */
+#define PROTO_OK                0x00
+#define PROTO_UNKNOWN           0x01    /* No handler for the id. */
+#define PROTO_BAD_ARGS          0x02    /* The arguments were not what the command takes. */
+#define PROTO_BUSY              0x03    /* The task it goes to could not take it now. */
+#define PROTO_TRUNCATED         0x04    /* The command went past the end of the frame, or its reply did. */
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+/* Run one command. pui8Reply is where its reply goes in the reply frame, with room for
+ * *pui32ReplyLength bytes, which the handler sets to what it wrote. Returns the status. */
+typedef uint8_t (*Proto_Handler) (const uint8_t *pui8Args, uint32_t ui32Length,
+                                  uint8_t *pui8Reply, uint32_t *pui32ReplyLength);
+
+typedef struct
+{
+    uint8_t ui8Id;
+    Proto_Handler pfnHandler;
+} Proto_Command;
+
+typedef struct
+{
+    uint32_t ui32Frames;
+    uint32_t ui32Commands;
+    /* Frames dropped: bad COBS or too long, then bad CRC. */
+    uint32_t ui32FramingErrors;
+    uint32_t ui32CrcErrors;
+    /* Sequence numbers skipped, frames lost on the way, and frames received twice. */
+    uint32_t ui32SequenceGaps;
+    uint32_t ui32Repeats;
+} Proto_Stats;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Take the commands of psCommands, and send the replies to psSink. */
+void Proto_Init (const Proto_Command *psCommands, uint32_t ui32Count, Print_Sink *psSink);
+
+/* Feed a byte received, returns false if it is a console character, for the caller to handle. */
+bool Proto_Receive (uint8_t ui8Byte);
+
+void Proto_getStats (Proto_Stats *psStats);
+
+#endif /* PROTO_H */
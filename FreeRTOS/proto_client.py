@@ -0,0 +1,445 @@
+#!/usr/bin/env python3
+#
+# Host side of the framed command protocol of proto.h. Sends commands to the
+# board, and benchmarks the protocol by keeping a window of frames of ping
+# commands in flight, so the UART is kept busy in both directions.
+#
+#   proto_client.py --port /dev/ttyACM0 led r
+#   proto_client.py --port /dev/ttyACM0 bench --frames 2000 --batch 4 --size 16 --window 4
+#   proto_client.py --tcp localhost:5555 stats
+#   proto_client.py --tcp localhost:5555 reconnect
+#   proto_client.py --port /dev/ttyACM0 baud 0
+#   proto_client.py --port /dev/ttyACM0 --baud 921600 --sync bench
+#   proto_client.py --exec "qemu-system-arm -machine lm3s6965evb -cpu cortex-m4 -display none \
+#                           -monitor none -serial stdio -kernel build/qemu/FreeRTOS/FreeRTOS.elf" bench
+#
+# --port needs pyserial, for the 128000 baud of the board. --tcp talks to QEMU
+# started with -serial tcp::5555,server, --exec to anything with the UART on
+# its standard input and output. The console text and the LOG() records the
+# board sends between the frames are skipped.
+#
+# baud switches the console to another rate, 0 for the fastest the board makes
+# at its clock up to CONSOLE_BAUD_MAX, and confirms it with a frame at the new
+# rate, the board goes back to the old one without it. --sync sends U
+# characters first, the board takes their rate when it listens for them, for
+# CONSOLE_AUTOBAUD_MS after a reset.
+#
+
+import argparse
+import queue
+import random
+import socket
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+PROTO_FRAME_MAX = 256
+PROTO_IDLE_MS = 500
+
+PROTO_CMD_PING = 0x01
+PROTO_CMD_STATS = 0x02
+CMD_LED = 0x10
+CMD_LATENCY = 0x11
+CMD_BAUD = 0x12
+
+STATUS = {0: "ok", 1: "unknown command", 2: "bad arguments", 3: "busy", 4: "truncated"}
+STATS = ("frames", "commands", "framing errors", "CRC errors", "sequence gaps", "repeats")
+
+
+# --------------------------------------------------------------------------- #
+#                             Framing, see cobs.c                             #
+# --------------------------------------------------------------------------- #
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code = 0
+    run = 1
+    for i, byte in enumerate(data):
+        if byte != 0:
+            out.append(byte)
+            run += 1
+        if byte == 0 or (run == 0xFF and i != len(data) - 1):
+            out[code] = run
+            code = len(out)
+            out.append(0)
+            run = 1
+    out[code] = run
+    return bytes(out)
+
+
+def cobs_decode(block):
+    out = bytearray()
+    i = 0
+    while i < len(block):
+        code = block[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(block):
+            return None
+        out += block[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i != len(block):
+            out.append(0)
+    return bytes(out)
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def crc32(data):
+    import zlib
+    return zlib.crc32(data) & 0xFFFFFFFF
+
+
+class Codec:
+    def __init__(self, use_crc32):
+        self.crc, self.crc_size = (crc32, 4) if use_crc32 else (crc16, 2)
+
+    def request(self, sequence, commands):
+        """The frame, delimiters included, of (id, arguments) commands."""
+        body = bytearray([sequence])
+        for ident, args in commands:
+            body += bytes([ident, len(args)]) + args
+        body += self.crc(body).to_bytes(self.crc_size, "little")
+        if len(body) > PROTO_FRAME_MAX:
+            raise ValueError("frame of %d bytes, at most %d" % (len(body), PROTO_FRAME_MAX))
+        return b"\0" + cobs_encode(bytes(body)) + b"\0"
+
+    def reply(self, block):
+        """(sequence, [(id, status, data)]) of an encoded reply, None if it is not one."""
+        body = cobs_decode(block)
+        if body is None or len(body) < 1 + self.crc_size:
+            return None
+        payload, crc = body[:-self.crc_size], body[-self.crc_size:]
+        if self.crc(payload) != int.from_bytes(crc, "little"):
+            return None
+        results = []
+        i = 1
+        while i + 3 <= len(payload):
+            ident, status, length = payload[i:i + 3]
+            results.append((ident, status, payload[i + 3:i + 3 + length]))
+            i += 3 + length
+        return payload[0], results
+
+
+# --------------------------------------------------------------------------- #
+#                                 Transports                                  #
+# --------------------------------------------------------------------------- #
+
+class Link:
+    """Bytes from the board come in through a thread, so every transport reads the same way."""
+
+    def __init__(self):
+        self.incoming = queue.Queue()
+        self.bytes_in = 0
+        self.bytes_out = 0
+        threading.Thread(target=self._reader, daemon=True).start()
+
+    def _reader(self):
+        while True:
+            data = self._read()
+            if not data:
+                self.incoming.put(None)
+                return
+            self.incoming.put(data)
+
+    def send(self, data):
+        self.bytes_out += len(data)
+        self._write(data)
+
+    def set_baud(self, baud):
+        pass
+
+    def receive(self, timeout):
+        try:
+            data = self.incoming.get(timeout=timeout)
+        except queue.Empty:
+            return b""
+        if data is None:
+            raise EOFError("the board went away")
+        self.bytes_in += len(data)
+        return data
+
+
+class SerialLink(Link):
+    def __init__(self, port, baud):
+        import serial
+        self.serial = serial.Serial(port, baud, timeout=0.1)
+        Link.__init__(self)
+
+    def _read(self):
+        while True:
+            data = self.serial.read(max(1, self.serial.in_waiting))
+            if data:
+                return data
+
+    def _write(self, data):
+        self.serial.write(data)
+
+    def set_baud(self, baud):
+        self.serial.baudrate = baud
+
+
+class TcpLink(Link):
+    def __init__(self, address):
+        host, port = address.rsplit(":", 1)
+        self.socket = socket.create_connection((host, int(port)))
+        self.socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        Link.__init__(self)
+
+    def _read(self):
+        return self.socket.recv(4096)
+
+    def _write(self, data):
+        self.socket.sendall(data)
+
+
+class ExecLink(Link):
+    def __init__(self, command):
+        self.process = subprocess.Popen(command, shell=True, stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+        Link.__init__(self)
+
+    def _read(self):
+        return self.process.stdout.read1(4096)
+
+    def _write(self, data):
+        self.process.stdin.write(data)
+        self.process.stdin.flush()
+
+
+# --------------------------------------------------------------------------- #
+#                                   Client                                    #
+# --------------------------------------------------------------------------- #
+
+class Client:
+    def __init__(self, link, codec, timeout, retries, sequence=None):
+        self.link = link
+        self.codec = codec
+        self.timeout = timeout
+        self.retries = retries
+        # A random start, so the first frame of a run is not taken for one the board has just answered.
+        self.sequence = random.randrange(256) if sequence is None else sequence
+        self.pending = b""
+        self.retransmits = 0
+
+    def next_sequence(self):
+        sequence = self.sequence
+        self.sequence = (self.sequence + 1) & 0xFF
+        return sequence
+
+    def replies(self, timeout):
+        """The replies received within timeout, what is between the frames is dropped."""
+        data = self.link.receive(timeout)
+        self.pending += data
+        blocks = self.pending.split(b"\0")
+        self.pending = blocks.pop()
+        return [r for r in (self.codec.reply(b) for b in blocks if b) if r is not None]
+
+    def call(self, commands):
+        """Send one frame and wait for its reply, sending it again on a timeout."""
+        sequence = self.next_sequence()
+        frame = self.codec.request(sequence, commands)
+        for _ in range(self.retries + 1):
+            self.link.send(frame)
+            deadline = time.monotonic() + self.timeout
+            while time.monotonic() < deadline:
+                for reply_sequence, results in self.replies(deadline - time.monotonic()):
+                    if reply_sequence == sequence:
+                        return results
+            self.retransmits += 1
+        raise TimeoutError("no reply to frame %d" % sequence)
+
+    def bench(self, frames, batch, size, window):
+        """Keep window frames of batch pings of size bytes in flight, returns the round trip of each frame."""
+        in_flight = {}
+        times = []
+        sent = 0
+        payload = bytes((i * 7 + 1) & 0xFF for i in range(size))
+        commands = [(PROTO_CMD_PING, payload)] * batch
+
+        while len(times) < frames:
+            while sent < frames and len(in_flight) < window:
+                sequence = self.next_sequence()
+                frame = self.codec.request(sequence, commands)
+                in_flight[sequence] = (frame, time.monotonic())
+                self.link.send(frame)
+                sent += 1
+
+            for sequence, results in self.replies(self.timeout / 10):
+                if sequence not in in_flight:
+                    continue
+                _, start = in_flight.pop(sequence)
+                times.append(time.monotonic() - start)
+                if len(results) != batch or any(s != 0 or d != payload for _, s, d in results):
+                    raise RuntimeError("frame %d came back wrong: %r" % (sequence, results))
+
+            # The oldest frame has waited too long, it or its reply was lost.
+            now = time.monotonic()
+            for sequence, (frame, start) in list(in_flight.items()):
+                if now - start > self.timeout:
+                    if now - start > self.timeout * (self.retries + 1):
+                        raise TimeoutError("no reply to frame %d" % sequence)
+                    self.link.send(frame)
+                    self.retransmits += 1
+                    in_flight[sequence] = (frame, start - self.timeout / 2)
+        return times
+
+
+# --------------------------------------------------------------------------- #
+#                                  Commands                                   #
+# --------------------------------------------------------------------------- #
+
+def sync(link, timeout=2.0):
+    """Send U characters in bursts until the board answers, it waits for a pause to turn its UART back on."""
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        link.send(b"U" * 16)
+        if link.receive(0.05):
+            while link.receive(0.1):
+                pass
+            return
+    raise TimeoutError("no answer to the sync characters, the board only listens for them after a reset")
+
+
+def reconnect(link, codec, timeout, retries):
+    """Start sessions at the same sequence, as runs of the client did before they started at a random
+    one, and check each gets the replies to its own frames, not the reply the board kept for the last
+    frame of the session before. Returns what went wrong, nothing if all went right."""
+    failures = []
+    sequence = random.randrange(256)
+
+    def frames(client):
+        (_, status, data), = client.call([(PROTO_CMD_STATS, b"")])
+        return struct.unpack_from("<I", data)[0]
+
+    # Straight after the other, other commands with the same sequence.
+    Client(link, codec, timeout, retries, sequence).call([(PROTO_CMD_PING, b"first")])
+    (_, _, data), = Client(link, codec, timeout, retries, sequence).call([(PROTO_CMD_PING, b"second")])
+    if data != b"second":
+        failures.append("a new session straight after got %r back for its ping" % data)
+
+    # After the board went idle, the same frame again, its reply has to be a new one.
+    before = frames(Client(link, codec, timeout, retries, sequence))
+    time.sleep(PROTO_IDLE_MS * 1.5 / 1000)
+    after = frames(Client(link, codec, timeout, retries, sequence))
+    if after <= before:
+        failures.append("a new session after the idle time got the old stats, frames %d then %d" % (before, after))
+
+    return failures
+
+
+def show(results):
+    for ident, status, data in results:
+        print("command 0x%02x: %s%s" % (ident, STATUS.get(status, "status %d" % status),
+                                       (", " + data.hex()) if data else ""))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Drive the framed command protocol of the board.")
+    link = parser.add_mutually_exclusive_group(required=True)
+    link.add_argument("--port", help="serial port of the board, needs pyserial")
+    link.add_argument("--tcp", help="host:port of a QEMU -serial tcp:: socket")
+    link.add_argument("--exec", dest="command", help="program with the UART on its standard input and output")
+    parser.add_argument("--baud", type=int, default=128000, help="baud rate of --port, and of the line rate (default 128000)")
+    parser.add_argument("--crc32", action="store_true", help="the board was built with PROTO_CRC_BITS 32")
+    parser.add_argument("--timeout", type=float, default=0.2,
+                        help="seconds before a frame is sent again, under the PROTO_IDLE_MS of the board (default 0.2)")
+    parser.add_argument("--retries", type=int, default=3, help="times a frame is sent again (default 3)")
+    parser.add_argument("--sync", action="store_true", help="send U characters first, for the board to take --baud after a reset")
+
+    sub = parser.add_subparsers(dest="action", required=True)
+    ping = sub.add_parser("ping", help="send bytes and check they come back")
+    ping.add_argument("data", nargs="?", default="ping")
+    led = sub.add_parser("led", help="change the LEDS, like the characters")
+    led.add_argument("color", choices="rgbo")
+    sub.add_parser("latency", help="the latency last/max of the l command")
+    sub.add_parser("stats", help="the counters of the protocol")
+    sub.add_parser("reconnect", help="check sessions that start at the same sequence get their own replies")
+    baud = sub.add_parser("baud", help="switch the console to another rate")
+    baud.add_argument("rate", type=int, help="0 for the fastest the board takes")
+    bench = sub.add_parser("bench", help="throughput and latency with frames of ping commands")
+    bench.add_argument("--frames", type=int, default=1000)
+    bench.add_argument("--batch", type=int, default=4, help="commands per frame (default 4)")
+    bench.add_argument("--size", type=int, default=16, help="bytes per command (default 16)")
+    bench.add_argument("--window", type=int, default=4, help="frames in flight (default 4)")
+    args = parser.parse_args()
+    if args.timeout >= PROTO_IDLE_MS / 1000:
+        parser.error("--timeout has to be under %d ms, the board drops the reply it kept after that" % PROTO_IDLE_MS)
+
+    if args.port:
+        link = SerialLink(args.port, args.baud)
+    elif args.tcp:
+        link = TcpLink(args.tcp)
+    else:
+        link = ExecLink(args.command)
+
+    client = Client(link, Codec(args.crc32), args.timeout, args.retries)
+
+    if args.sync:
+        sync(link)
+
+    if args.action == "ping":
+        show(client.call([(PROTO_CMD_PING, args.data.encode())]))
+    elif args.action == "led":
+        show(client.call([(CMD_LED, args.color.encode())]))
+    elif args.action == "latency":
+        (_, status, data), = client.call([(CMD_LATENCY, b"")])
+        if status != 0:
+            sys.exit("latency: %s" % STATUS.get(status, status))
+        print("Latency cycles last/max %d/%d" % struct.unpack("<II", data))
+    elif args.action == "baud":
+        (_, status, data), = client.call([(CMD_BAUD, struct.pack("<I", args.rate))])
+        if status != 0:
+            sys.exit("baud: %s" % STATUS.get(status, status))
+        rate, error = struct.unpack("<Ii", data)
+        # The board switches once the reply is out, and keeps the rate if a frame comes in at it.
+        time.sleep(0.05)
+        link.set_baud(rate)
+        client.call([(PROTO_CMD_PING, b"")])
+        print("Console at %d baud, %+d ppm off on the board, use --baud %d from now on" % (rate, error, rate))
+    elif args.action == "stats":
+        (_, status, data), = client.call([(PROTO_CMD_STATS, b"")])
+        if status != 0:
+            sys.exit("stats: %s" % STATUS.get(status, status))
+        for name, value in zip(STATS, struct.unpack("<%dI" % (len(data) // 4), data)):
+            print("%-15s %d" % (name, value))
+    elif args.action == "reconnect":
+        failures = reconnect(link, client.codec, args.timeout, args.retries)
+        for failure in failures:
+            print(failure)
+        if failures:
+            sys.exit("reconnect: %d of 2 failed" % len(failures))
+        print("reconnect: ok")
+    else:
+        # Make sure the board is in frame mode and answering before the clock starts.
+        client.call([(PROTO_CMD_PING, b"")])
+        in_before, out_before = link.bytes_in, link.bytes_out
+        start = time.monotonic()
+        times = client.bench(args.frames, args.batch, args.size, args.window)
+        elapsed = time.monotonic() - start
+        wire_in, wire_out = link.bytes_in - in_before, link.bytes_out - out_before
+
+        times.sort()
+        commands = args.frames * args.batch
+        line = args.baud / 10.0
+        print("%d frames of %d x %d bytes, window %d, in %.3f s" % (args.frames, args.batch, args.size, args.window, elapsed))
+        print("commands/s %.0f, payload bytes/s each way %.0f" % (commands / elapsed, commands * args.size / elapsed))
+        print("wire bytes/s out %.0f, in %.0f, %.0f%%/%.0f%% of %d baud"
+              % (wire_out / elapsed, wire_in / elapsed, 100 * wire_out / elapsed / line, 100 * wire_in / elapsed / line, args.baud))
+        print("round trip ms min/median/p99/max %.2f/%.2f/%.2f/%.2f, retransmits %d"
+              % (times[0] * 1e3, times[len(times) // 2] * 1e3, times[int(len(times) * 0.99)] * 1e3, times[-1] * 1e3,
+                 client.retransmits))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -126,6 +126,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         struct QueueDefinition * pxQueueSetContainer;
     #endif
 
+    #if ( configUSE_QUEUE_SELECT == 1 )
+        TaskHandle_t xSelectTask; /*< The task registered with vQueueSelectAdd(), NULL if there is none. */
+        uint32_t ulSelectBits;    /*< The bits set in the notification value of xSelectTask on each send. */
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
@@ -212,6 +217,34 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_SELECT == 1 )
+
+/*
+ * Sets the bits of the queue in the notification value of the task
+ * registered with vQueueSelectAdd(), if any.  Called after every item is
+ * sent, there is nothing to copy, and the notification does not touch the
+ * event lists of the queue so it does not matter whether it is locked.
+ */
+    #define prvNotifyQueueSelect( pxQueue )                                                                                   \
+    {                                                                                                                         \
+        if( ( pxQueue )->xSelectTask != NULL )                                                                                \
+        {                                                                                                                     \
+            ( void ) xTaskNotifyIndexed( ( pxQueue )->xSelectTask, configQUEUE_SELECT_INDEX, ( pxQueue )->ulSelectBits, eSetBits ); \
+        }                                                                                                                     \
+    }
+
+    #define prvNotifyQueueSelectFromISR( pxQueue, pxHigherPriorityTaskWoken )                                                                                      \
+    {                                                                                                                                                              \
+        if( ( pxQueue )->xSelectTask != NULL )                                                                                                                     \
+        {                                                                                                                                                          \
+            ( void ) xTaskNotifyIndexedFromISR( ( pxQueue )->xSelectTask, configQUEUE_SELECT_INDEX, ( pxQueue )->ulSelectBits, eSetBits, pxHigherPriorityTaskWoken ); \
+        }                                                                                                                                                          \
+    }
+#else
+    #define prvNotifyQueueSelect( pxQueue )
+    #define prvNotifyQueueSelectFromISR( pxQueue, pxHigherPriorityTaskWoken )
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -502,6 +535,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
         }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_QUEUE_SELECT == 1 )
+        {
+            pxNewQueue->xSelectTask = NULL;
+            pxNewQueue->ulSelectBits = 0U;
+        }
+    #endif /* configUSE_QUEUE_SELECT */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -930,6 +970,8 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                     }
                 #endif /* configUSE_QUEUE_SETS */
 
+                prvNotifyQueueSelect( pxQueue );
+
                 taskEXIT_CRITICAL();
                 return pdPASS;
             }
@@ -1063,6 +1105,8 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
              *  the scheduler is suspended before accessing the ready lists. */
             ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
+            prvNotifyQueueSelectFromISR( pxQueue, pxHigherPriorityTaskWoken );
+
             /* The event list is not altered if the queue is locked.  This will
              * be done when the queue is unlocked later. */
             if( cTxLock == queueUNLOCKED )
@@ -1241,6 +1285,8 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
              * messages (semaphores) available. */
             pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
 
+            prvNotifyQueueSelectFromISR( pxQueue, pxHigherPriorityTaskWoken );
+
             /* The event list is not altered if the queue is locked.  This will
              * be done when the queue is unlocked later. */
             if( cTxLock == queueUNLOCKED )
@@ -3072,3 +3118,77 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SELECT == 1 )
+
+    void vQueueSelectAdd( QueueHandle_t xQueue,
+                          uint32_t ulBits )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( ulBits != 0U );
+
+        taskENTER_CRITICAL();
+        {
+            pxQueue->xSelectTask = xTaskGetCurrentTaskHandle();
+            pxQueue->ulSelectBits = ulBits;
+
+            /* Items sent before the task was registered did not notify it. */
+            if( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 )
+            {
+                ( void ) xTaskNotifyIndexed( pxQueue->xSelectTask, configQUEUE_SELECT_INDEX, ulBits, eSetBits );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_SELECT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SELECT == 1 )
+
+    void vQueueSelectRemove( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            pxQueue->xSelectTask = NULL;
+            pxQueue->ulSelectBits = 0U;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_SELECT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SELECT == 1 )
+
+    uint32_t ulQueueSelect( TickType_t xTicksToWait )
+    {
+        uint32_t ulBits = 0U;
+
+        /* Every object sets its own bits in the same notification value, so
+         * one wait covers all of them, and all the bits are cleared on exit so
+         * each send is reported once. */
+        if( xTaskNotifyWaitIndexed( configQUEUE_SELECT_INDEX, 0U, 0xffffffffUL, &ulBits, xTicksToWait ) == pdFALSE )
+        {
+            ulBits = 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ulBits;
+    }
+
+#endif /* configUSE_QUEUE_SELECT */
@@ -1701,6 +1701,53 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * vQueueSelectAdd() registers the calling task on a queue or semaphore, so
+ * that every send to (or give of) it sets ulBits in the notification value at
+ * index configQUEUE_SELECT_INDEX of the task.  ulQueueSelect() then blocks on
+ * that one notification until any of the registered objects is ready and
+ * returns the bits of those that were.  Unlike a queue set nothing is copied
+ * on each send, the cost is one notification, and any other task, timer
+ * callback or interrupt can wake the same wait by setting its own bits with
+ * xTaskNotifyIndexed( xTask, configQUEUE_SELECT_INDEX, ulBits, eSetBits ).
+ *
+ * configUSE_QUEUE_SELECT must be set to 1 in FreeRTOSConfig.h for these
+ * functions to be available.
+ *
+ * Note 1:  The bits only say something was sent since the last call to
+ * ulQueueSelect(), so every object reported ready should be read with a zero
+ * block time until it is empty, an item left behind is not reported again.
+ *
+ * Note 2:  An object can only be registered to one task at a time, a second
+ * call to vQueueSelectAdd() replaces the first.
+ *
+ * Note 3:  The notification index is shared by all the objects registered to
+ * the task, so it must not be used for anything else by that task.
+ *
+ * @param xQueue The queue or semaphore to register the calling task on.
+ *
+ * @param ulBits The bits set in the notification value of the calling task
+ * when an item is sent to xQueue.  If xQueue already holds items when it is
+ * registered the bits are set straight away.
+ */
+void vQueueSelectAdd( QueueHandle_t xQueue,
+                      uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stop a send to xQueue from notifying the task registered with
+ * vQueueSelectAdd().
+ */
+void vQueueSelectRemove( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block until any of the objects registered with vQueueSelectAdd() by the
+ * calling task is sent to, or until xTicksToWait expires.
+ *
+ * @return The bits of the objects that were sent to, cleared on return, or 0
+ * if the block time expired first.
+ */
+uint32_t ulQueueSelect( TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
                                      TickType_t xTicksToWait,
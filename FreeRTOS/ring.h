@@ -0,0 +1,190 @@
+/*
+ * Lock-free single producer single consumer byte ring, to pass data from an
+ * interrupt to a task without any critical section. The producer only ever
+ * writes the head and the consumer only ever writes the tail, so neither
+ * has to mask interrupts, the barriers only order the data and the index.
+ */
+
+#ifndef RING_H
+#define RING_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Make sure the data is written before the index that publishes it, and the
+ * index is read before the data it covers. */
+#if defined(__TI_ARM__)
+#define RING_BARRIER()    __asm("	dmb")
+#elif defined(__arm__)
+/* GCC also needs to be told not to move memory accesses across it. */
+#define RING_BARRIER()    __asm volatile ("dmb" ::: "memory")
+#else
+/* The host build of gcc/host. */
+#define RING_BARRIER()    __sync_synchronize ()
+#endif
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    /* Free running indexes, they only wrap around at 2^32, so Head - Tail is always the count. */
+    volatile uint32_t ui32Head;
+    volatile uint32_t ui32Tail;
+    /* Size of the buffer, must be a power of 2. */
+    uint32_t ui32Size;
+    uint8_t *pui8Buffer;
+    /* Task notified when the ring goes from empty to not empty, set by Ring_Wait() or Ring_SelectAdd(),
+     * with the bits and on the notification index it waits on. */
+    volatile TaskHandle_t xConsumer;
+    UBaseType_t uxNotifyIndex;
+    uint32_t ui32NotifyBits;
+} Ring_t;
+
+/*****************************************************************************/
+/*                                 Main Functions                            */
+/*****************************************************************************/
+
+/* Start the ring empty, ui32Size must be a power of 2. */
+static inline void Ring_Init (Ring_t *pxRing, uint8_t *pui8Buffer, uint32_t ui32Size)
+{
+    configASSERT ((ui32Size != 0) && ((ui32Size & (ui32Size - 1)) == 0));
+
+    pxRing->ui32Head = 0;
+    pxRing->ui32Tail = 0;
+    pxRing->ui32Size = ui32Size;
+    pxRing->pui8Buffer = pui8Buffer;
+    pxRing->xConsumer = NULL;
+    pxRing->uxNotifyIndex = 0;
+    pxRing->ui32NotifyBits = 1;
+}
+
+/* Number of bytes waiting, can be called from both sides. */
+static inline uint32_t Ring_Count (const Ring_t *pxRing)
+{
+    return pxRing->ui32Head - pxRing->ui32Tail;
+}
+
+/* Producer side, copy up to ui32Length bytes in, returns how many fitted. */
+static inline uint32_t Ring_Write (Ring_t *pxRing, const uint8_t *pui8Data, uint32_t ui32Length)
+{
+    uint32_t ui32Head = pxRing->ui32Head;
+    uint32_t ui32Free = pxRing->ui32Size - (ui32Head - pxRing->ui32Tail);
+    uint32_t i;
+
+    if (ui32Length > ui32Free)
+    {
+        ui32Length = ui32Free;
+    }
+
+    for (i = 0; i < ui32Length; i++)
+    {
+        pxRing->pui8Buffer[(ui32Head + i) & (pxRing->ui32Size - 1)] = pui8Data[i];
+    }
+
+    /* Only publish the bytes once they are in the buffer. */
+    RING_BARRIER();
+    pxRing->ui32Head = ui32Head + ui32Length;
+
+    return ui32Length;
+}
+
+/* Consumer side, copy up to ui32Length bytes out, returns how many there were. */
+static inline uint32_t Ring_Read (Ring_t *pxRing, uint8_t *pui8Data, uint32_t ui32Length)
+{
+    uint32_t ui32Tail = pxRing->ui32Tail;
+    uint32_t ui32Count = pxRing->ui32Head - ui32Tail;
+    uint32_t i;
+
+    /* Do not read the bytes before the head that covers them. */
+    RING_BARRIER();
+
+    if (ui32Length > ui32Count)
+    {
+        ui32Length = ui32Count;
+    }
+
+    for (i = 0; i < ui32Length; i++)
+    {
+        pui8Data[i] = pxRing->pui8Buffer[(ui32Tail + i) & (pxRing->ui32Size - 1)];
+    }
+
+    /* Only give the space back once the bytes are out of it. */
+    RING_BARRIER();
+    pxRing->ui32Tail = ui32Tail + ui32Length;
+
+    return ui32Length;
+}
+
+/* Producer side from an interrupt, same as Ring_Write() but also wakes the consumer
+ * blocked in Ring_Wait(), only when the ring goes from empty to not empty. */
+static inline uint32_t Ring_WriteFromISR (Ring_t *pxRing, const uint8_t *pui8Data, uint32_t ui32Length,
+                                          BaseType_t *pxHigherPriorityTaskWoken)
+{
+    bool bWasEmpty = (Ring_Count (pxRing) == 0);
+    TaskHandle_t xConsumer = pxRing->xConsumer;
+
+    ui32Length = Ring_Write (pxRing, pui8Data, ui32Length);
+
+    if ((bWasEmpty == true) && (ui32Length != 0) && (xConsumer != NULL))
+    {
+        xTaskNotifyIndexedFromISR (xConsumer, pxRing->uxNotifyIndex, pxRing->ui32NotifyBits, eSetBits, pxHigherPriorityTaskWoken);
+    }
+
+    return ui32Length;
+}
+
+/* Consumer side, block until there is something to read or xTicksToWait expires.
+ * Returns the number of bytes waiting, 0 on timeout. */
+static inline uint32_t Ring_Wait (Ring_t *pxRing, TickType_t xTicksToWait)
+{
+    /* Register first, so a write that comes right after the check below notifies us. */
+    pxRing->xConsumer = xTaskGetCurrentTaskHandle ();
+
+    while (Ring_Count (pxRing) == 0)
+    {
+        /* A notification left over from bytes already read only costs one more check. */
+        if (ulTaskNotifyTakeIndexed (pxRing->uxNotifyIndex, pdTRUE, xTicksToWait) == 0)
+        {
+            break;
+        }
+    }
+
+    return Ring_Count (pxRing);
+}
+
+#if (configUSE_QUEUE_SELECT == 1)
+/* Consumer side, wake ulQueueSelect() of the calling task with ui32Bits instead of Ring_Wait(),
+ * so the ring can be waited on together with queues and semaphores. Use one or the other. */
+static inline void Ring_SelectAdd (Ring_t *pxRing, uint32_t ui32Bits)
+{
+    pxRing->uxNotifyIndex = configQUEUE_SELECT_INDEX;
+    pxRing->ui32NotifyBits = ui32Bits;
+
+    /* The index and bits have to be in place before the interrupt can see the consumer. */
+    RING_BARRIER();
+    pxRing->xConsumer = xTaskGetCurrentTaskHandle ();
+
+    /* Bytes written before the consumer was registered did not notify it. */
+    if (Ring_Count (pxRing) != 0)
+    {
+        xTaskNotifyIndexed (pxRing->xConsumer, configQUEUE_SELECT_INDEX, ui32Bits, eSetBits);
+    }
+}
+#endif
+
+#endif /* RING_H */
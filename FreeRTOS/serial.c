@@ -0,0 +1,318 @@
+/*
+ * UART service for several ports at once, see serial.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "serial.h"
+#include "ring.h"
+#include "clock.h"
+#include "vectors.h"
+
+/* TivaWare includes.  */
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "driverlib/interrupt.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#if (configUSE_QUEUE_SELECT != 1)
+#error "serial.c waits on the ports with ulQueueSelect(), set configUSE_QUEUE_SELECT to 1"
+#endif
+
+/* Depth of the FIFOs of the UART. */
+#define SERIAL_FIFO_SIZE        16
+
+/* Error bits of a character read from the data register: framing, parity, break and overrun. */
+#define SERIAL_DATA_ERRORS      0xF00
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    uint32_t ui32Base;
+    uint32_t ui32Periph;
+    uint32_t ui32Interrupt;
+    void (*pfnHandler) (void);
+} Serial_Hardware;
+
+typedef struct
+{
+    /* The handler writes xRx and reads xTx, the tasks the other way around. */
+    Ring_t xRx;
+    Ring_t xTx;
+    bool bOpen;
+    /* Task registered with Serial_SelectAdd(), and what it waits for. */
+    volatile TaskHandle_t xSelectTask;
+    volatile uint32_t ui32Events;
+    /* Only written by the handler. */
+    volatile Serial_Stats xStats;
+} Serial_Port;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static const Serial_Hardware xSerialHardware[SERIAL_PORTS] =
+{
+    { UART0_BASE, SYSCTL_PERIPH_UART0, INT_UART0, Serial_UART0IntHandler },
+    { UART1_BASE, SYSCTL_PERIPH_UART1, INT_UART1, Serial_UART1IntHandler },
+    { UART2_BASE, SYSCTL_PERIPH_UART2, INT_UART2, Serial_UART2IntHandler },
+    { UART3_BASE, SYSCTL_PERIPH_UART3, INT_UART3, Serial_UART3IntHandler },
+    { UART4_BASE, SYSCTL_PERIPH_UART4, INT_UART4, Serial_UART4IntHandler },
+    { UART5_BASE, SYSCTL_PERIPH_UART5, INT_UART5, Serial_UART5IntHandler },
+    { UART6_BASE, SYSCTL_PERIPH_UART6, INT_UART6, Serial_UART6IntHandler },
+    { UART7_BASE, SYSCTL_PERIPH_UART7, INT_UART7, Serial_UART7IntHandler }
+};
+
+static Serial_Port xSerialPorts[SERIAL_PORTS];
+
+/*****************************************************************************/
+/*                                Serial Functions                           */
+/*****************************************************************************/
+
+bool Serial_Open (uint32_t ui32Port, uint32_t ui32Baud, uint32_t ui32Config,
+                  uint8_t *pui8RxBuffer, uint32_t ui32RxSize, uint8_t *pui8TxBuffer, uint32_t ui32TxSize)
+{
+    const Serial_Hardware *psHardware;
+    Serial_Port *psPort;
+
+    if ((ui32Port >= SERIAL_PORTS) || (xSerialPorts[ui32Port].bOpen == true))
+    {
+        return false;
+    }
+    psHardware = &xSerialHardware[ui32Port];
+    psPort = &xSerialPorts[ui32Port];
+
+    SysCtlPeripheralEnable (psHardware->ui32Periph);
+    while (!SysCtlPeripheralReady (psHardware->ui32Periph)) {}
+
+    /* The rings have to exist before the first interrupt. */
+    Ring_Init (&psPort->xRx, pui8RxBuffer, ui32RxSize);
+    Ring_Init (&psPort->xTx, pui8TxBuffer, ui32TxSize);
+    psPort->xSelectTask = NULL;
+    psPort->ui32Events = 0;
+
+    /* Registered with the clock, so the divisor follows the governor. */
+    if (Clock_UARTConfigSet (psHardware->ui32Base, ui32Baud, ui32Config) == false)
+    {
+        return false;
+    }
+
+    /* Receive interrupts at half full, so there are still 8 characters of time left to empty the FIFO,
+     * and transmit interrupts at a quarter full, so it does not run dry before it is filled up again. */
+    UARTFIFOLevelSet (psHardware->ui32Base, UART_FIFO_TX2_8, UART_FIFO_RX4_8);
+    UARTEnable (psHardware->ui32Base);
+
+    /* The handler uses the kernel, so its priority must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+    psPort->bOpen = true;
+    UARTIntEnable (psHardware->ui32Base, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+    IntPrioritySet (psHardware->ui32Interrupt, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+#if (VECTORS_RUNTIME_REGISTER == 1)
+    IntRegister (psHardware->ui32Interrupt, psHardware->pfnHandler);
+#endif
+    IntEnable (psHardware->ui32Interrupt);
+
+    return true;
+}
+
+uint32_t Serial_Read (uint32_t ui32Port, uint8_t *pui8Data, uint32_t ui32Length)
+{
+    return Ring_Read (&xSerialPorts[ui32Port].xRx, pui8Data, ui32Length);
+}
+
+uint32_t Serial_Write (uint32_t ui32Port, const uint8_t *pui8Data, uint32_t ui32Length)
+{
+    ui32Length = Ring_Write (&xSerialPorts[ui32Port].xTx, pui8Data, ui32Length);
+
+    /* Only the handler reads the ring, so it is the one that starts sending. The transmit
+     * interrupt only comes when the FIFO drains, an idle UART needs it made pending. */
+    if (ui32Length != 0)
+    {
+        IntPendSet (xSerialHardware[ui32Port].ui32Interrupt);
+    }
+
+    return ui32Length;
+}
+
+uint32_t Serial_Available (uint32_t ui32Port)
+{
+    return Ring_Count (&xSerialPorts[ui32Port].xRx);
+}
+
+uint32_t Serial_Space (uint32_t ui32Port)
+{
+    Ring_t *pxTx = &xSerialPorts[ui32Port].xTx;
+
+    return pxTx->ui32Size - Ring_Count (pxTx);
+}
+
+void Serial_SelectAdd (uint32_t ui32Port, uint32_t ui32Events)
+{
+    Serial_Port *psPort = &xSerialPorts[ui32Port];
+
+    /* The events first, the handler only looks at them once it sees the task. */
+    psPort->ui32Events = ui32Events;
+    psPort->xSelectTask = xTaskGetCurrentTaskHandle ();
+
+    if ((ui32Events & SERIAL_EVENT_RX) != 0)
+    {
+        Ring_SelectAdd (&psPort->xRx, SERIAL_SELECT_RX (ui32Port));
+    }
+    else
+    {
+        psPort->xRx.xConsumer = NULL;
+    }
+}
+
+/* Ports of the calling task ready now: bytes to read, or half the transmit ring free. */
+static uint32_t Serial_ready (TaskHandle_t xTask)
+{
+    Serial_Port *psPort;
+    uint32_t ui32Ready = 0;
+    uint32_t i;
+
+    for (i = 0; i < SERIAL_PORTS; i++)
+    {
+        psPort = &xSerialPorts[i];
+        if (psPort->xSelectTask != xTask)
+        {
+            continue;
+        }
+
+        if (((psPort->ui32Events & SERIAL_EVENT_RX) != 0) && (Ring_Count (&psPort->xRx) != 0))
+        {
+            ui32Ready |= SERIAL_SELECT_RX (i);
+        }
+        if (((psPort->ui32Events & SERIAL_EVENT_TX) != 0) && (Ring_Count (&psPort->xTx) <= (psPort->xTx.ui32Size / 2)))
+        {
+            ui32Ready |= SERIAL_SELECT_TX (i);
+        }
+    }
+
+    return ui32Ready;
+}
+
+uint32_t Serial_Select (TickType_t xTicksToWait)
+{
+    TaskHandle_t xTask = xTaskGetCurrentTaskHandle ();
+    uint32_t ui32Ready = Serial_ready (xTask);
+    uint32_t ui32Bits;
+
+    /* The notifications are edges, a port left ready by the last call did not give a new one, so the
+     * rings are looked at first, and only waited on when none is ready. Whatever changes between
+     * the look and the wait notifies, and ends the wait at once. */
+    ui32Bits = ulQueueSelect ((ui32Ready != 0) ? 0 : xTicksToWait);
+    if (ui32Ready == 0)
+    {
+        ui32Ready = Serial_ready (xTask);
+    }
+
+    return ui32Ready | (ui32Bits & ~SERIAL_SELECT_MASK);
+}
+
+void Serial_getStats (uint32_t ui32Port, Serial_Stats *psStats)
+{
+    /* Each count is read in one go, they may be from slightly different times. */
+    psStats->ui32Received = xSerialPorts[ui32Port].xStats.ui32Received;
+    psStats->ui32Sent = xSerialPorts[ui32Port].xStats.ui32Sent;
+    psStats->ui32Dropped = xSerialPorts[ui32Port].xStats.ui32Dropped;
+    psStats->ui32Errors = xSerialPorts[ui32Port].xStats.ui32Errors;
+    psStats->ui32Interrupts = xSerialPorts[ui32Port].xStats.ui32Interrupts;
+}
+
+/*****************************************************************************/
+/*                            Interrupt Handlers                             */
+/*****************************************************************************/
+
+/* Empty the Rx FIFO into the receive ring and fill the Tx FIFO from the transmit ring, both in one go. */
+static void Serial_IntHandler (uint32_t ui32Port)
+{
+    const uint32_t ui32Base = xSerialHardware[ui32Port].ui32Base;
+    Serial_Port *psPort = &xSerialPorts[ui32Port];
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8_t ui8Data[SERIAL_FIFO_SIZE];
+    uint32_t ui32Count = 0;
+    uint32_t ui32Sent = 0;
+    uint32_t ui32Status, ui32Written, ui32Pending, ui32Half;
+    TaskHandle_t xSelectTask;
+    int32_t i32Character;
+
+    ui32Status = UARTIntStatus (ui32Base, true);
+    UARTIntClear (ui32Base, ui32Status);
+    psPort->xStats.ui32Interrupts++;
+
+    /* The Rx FIFO is only emptied when it is half full or has timed out. Emptying it on every transmit
+     * interrupt as well would pass the bytes on one or two at a time, and wake the task for each of them. */
+    if ((ui32Status & (UART_INT_RX | UART_INT_RT)) != 0)
+    {
+        /* A character with an error is dropped rather than passed on as if it were right. */
+        while ((UARTCharsAvail (ui32Base) == true) && (ui32Count < SERIAL_FIFO_SIZE))
+        {
+            i32Character = UARTCharGetNonBlocking (ui32Base);
+            if ((i32Character & SERIAL_DATA_ERRORS) != 0)
+            {
+                psPort->xStats.ui32Errors++;
+            }
+            else
+            {
+                ui8Data[ui32Count++] = (uint8_t) i32Character;
+            }
+        }
+    }
+
+    if (ui32Count != 0)
+    {
+        /* Characters that do not fit in the ring are dropped, the UART has no flow control to hold them back. */
+        ui32Written = Ring_WriteFromISR (&psPort->xRx, ui8Data, ui32Count, &xHigherPriorityTaskWoken);
+        psPort->xStats.ui32Received += ui32Written;
+        psPort->xStats.ui32Dropped += ui32Count - ui32Written;
+    }
+
+    /* As many as the FIFO takes, the ring only tells how many it has left to send. */
+    ui32Pending = Ring_Count (&psPort->xTx);
+    while ((UARTSpaceAvail (ui32Base) == true) && (Ring_Read (&psPort->xTx, ui8Data, 1) == 1))
+    {
+        UARTCharPutNonBlocking (ui32Base, ui8Data[0]);
+        ui32Sent++;
+    }
+    psPort->xStats.ui32Sent += ui32Sent;
+
+    /* The task waiting for room is woken once, when the ring gets down to half full. */
+    ui32Half = psPort->xTx.ui32Size / 2;
+    xSelectTask = psPort->xSelectTask;
+    if ((ui32Pending > ui32Half) && ((ui32Pending - ui32Sent) <= ui32Half) &&
+        (xSelectTask != NULL) && ((psPort->ui32Events & SERIAL_EVENT_TX) != 0))
+    {
+        xTaskNotifyIndexedFromISR (xSelectTask, configQUEUE_SELECT_INDEX, SERIAL_SELECT_TX (ui32Port), eSetBits, &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR (xHigherPriorityTaskWoken);
+}
+
+void Serial_UART0IntHandler (void) { Serial_IntHandler (0); }
+void Serial_UART1IntHandler (void) { Serial_IntHandler (1); }
+void Serial_UART2IntHandler (void) { Serial_IntHandler (2); }
+void Serial_UART3IntHandler (void) { Serial_IntHandler (3); }
+void Serial_UART4IntHandler (void) { Serial_IntHandler (4); }
+void Serial_UART5IntHandler (void) { Serial_IntHandler (5); }
+void Serial_UART6IntHandler (void) { Serial_IntHandler (6); }
+void Serial_UART7IntHandler (void) { Serial_IntHandler (7); }
@@ -0,0 +1,107 @@
+/*
+ * UART service for several ports at once, UART0 to UART7. Every port opened
+ * with Serial_Open() has a receive ring and a transmit ring, see ring.h. Its
+ * interrupt handler moves the bytes between the rings and the FIFOs of the
+ * UART, and tasks only ever touch the rings, without blocking.
+ *
+ * Serial_Select() is one wait for all the ports: a task registers the ports
+ * it serves with Serial_SelectAdd(), and is woken when any of them has bytes
+ * to read, or room to write when it asked for it, so one task can bridge
+ * ports in both directions. The wait goes through ulQueueSelect(), so the
+ * same task can also wait on the queues and semaphores it registered with
+ * vQueueSelectAdd(), with bits below SERIAL_SELECT_SHIFT.
+ *
+ * Each ring has a single reader and a single writer, so every port is read
+ * by one task and written by one task. The pins are the caller's to set up,
+ * they depend on the board.
+ */
+
+#ifndef SERIAL_H
+#define SERIAL_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define SERIAL_PORTS                8
+
+/* Bits of Serial_Select() for a port with bytes to read, and for a port with room to write, the
+ * ones below SERIAL_SELECT_SHIFT are left to the other objects of ulQueueSelect(). */
+#define SERIAL_SELECT_SHIFT         16
+#define SERIAL_SELECT_RX(ui32Port)  (1UL << (SERIAL_SELECT_SHIFT + (ui32Port)))
+#define SERIAL_SELECT_TX(ui32Port)  (1UL << (SERIAL_SELECT_SHIFT + SERIAL_PORTS + (ui32Port)))
+#define SERIAL_SELECT_MASK          (0xFFFFUL << SERIAL_SELECT_SHIFT)
+
+/* What Serial_SelectAdd() waits for on a port. Room to write is half the transmit ring free, so a
+ * task waiting for it is woken once per half ring sent rather than once per byte. */
+#define SERIAL_EVENT_RX             0x01
+#define SERIAL_EVENT_TX             0x02
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    uint32_t ui32Received;
+    uint32_t ui32Sent;
+    /* Bytes received with the receive ring full, and with a framing, parity, break or overrun error. */
+    uint32_t ui32Dropped;
+    uint32_t ui32Errors;
+    /* Interrupts taken. */
+    uint32_t ui32Interrupts;
+} Serial_Stats;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Enable UART ui32Port at ui32Baud through Clock_UARTConfigSet(), with its rings, both sizes powers
+ * of 2, and its interrupt. Returns false if the port does not exist or the rate cannot be made. */
+bool Serial_Open (uint32_t ui32Port, uint32_t ui32Baud, uint32_t ui32Config,
+                  uint8_t *pui8RxBuffer, uint32_t ui32RxSize, uint8_t *pui8TxBuffer, uint32_t ui32TxSize);
+
+/* Copy up to ui32Length bytes received, returns how many there were. */
+uint32_t Serial_Read (uint32_t ui32Port, uint8_t *pui8Data, uint32_t ui32Length);
+
+/* Queue up to ui32Length bytes to send, returns how many fitted. */
+uint32_t Serial_Write (uint32_t ui32Port, const uint8_t *pui8Data, uint32_t ui32Length);
+
+/* Bytes waiting to be read, and room left to write. */
+uint32_t Serial_Available (uint32_t ui32Port);
+uint32_t Serial_Space (uint32_t ui32Port);
+
+/* Register the calling task for the SERIAL_EVENT_RX and SERIAL_EVENT_TX of ui32Events on a port, called
+ * again to change them, such as to wait for room only while there is something the port could not take. */
+void Serial_SelectAdd (uint32_t ui32Port, uint32_t ui32Events);
+
+/* Block until a port registered by the calling task is ready or xTicksToWait expires. Returns the
+ * SERIAL_SELECT_RX() and SERIAL_SELECT_TX() bits of the ports ready, with the bits of the other
+ * objects of ulQueueSelect() that were given meanwhile, 0 on timeout. A port is reported for as long
+ * as it is ready, not only once. */
+uint32_t Serial_Select (TickType_t xTicksToWait);
+
+void Serial_getStats (uint32_t ui32Port, Serial_Stats *psStats);
+
+/* Interrupt handlers of the ports, in vectors.h for the ports that are opened. */
+void Serial_UART0IntHandler (void);
+void Serial_UART1IntHandler (void);
+void Serial_UART2IntHandler (void);
+void Serial_UART3IntHandler (void);
+void Serial_UART4IntHandler (void);
+void Serial_UART5IntHandler (void);
+void Serial_UART6IntHandler (void);
+void Serial_UART7IntHandler (void);
+
+#endif /* SERIAL_H */
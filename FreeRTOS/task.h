@@ -1363,6 +1363,14 @@ void vTaskEndScheduler( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
 
+/* With the critical section statistics of critstats.h, each suspension of the
+ * scheduler is charged to the file and line that suspended it. */
+#if ( configUSE_CRITICAL_STATS == 1 )
+    void vTaskSuspendAllFrom( const char * pcFile,
+                              uint32_t ulLine ) PRIVILEGED_FUNCTION;
+    #define vTaskSuspendAll()    vTaskSuspendAllFrom( __FILE__, __LINE__ )
+#endif
+
 /**
  * task. h
  * <pre>
@@ -2168,12 +2176,12 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
  * \defgroup xTaskNotifyIndexedFromISR xTaskNotifyIndexedFromISR
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
-                                      UBaseType_t uxIndexToNotify,
-                                      uint32_t ulValue,
-                                      eNotifyAction eAction,
-                                      uint32_t * pulPreviousNotificationValue,
-                                      BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+portHOT_FUNCTION BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
+                                                       UBaseType_t uxIndexToNotify,
+                                                       uint32_t ulValue,
+                                                       eNotifyAction eAction,
+                                                       uint32_t * pulPreviousNotificationValue,
+                                                       BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) \
     xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
 #define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) \
@@ -2866,7 +2874,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
  *   + Time slicing is in use and there is a task of equal priority to the
  *     currently running task.
  */
-BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
+portHOT_FUNCTION BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
@@ -2956,7 +2964,7 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  * Sets the pointer to the current TCB to the TCB of the highest priority task
  * that is ready to run.
  */
-portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+portDONT_DISCARD portHOT_FUNCTION void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
@@ -3048,6 +3056,14 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Decrement the mutex held count of the calling task
+ * when it gives a mutex nobody waits for, without a critical section.  Returns
+ * pdTRUE, leaving the count alone, if the task runs at an inherited priority
+ * and has to call xTaskPriorityDisinherit() instead.
+ */
+BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
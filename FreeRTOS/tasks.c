@@ -41,6 +41,10 @@
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configUSE_CRITICAL_STATS == 1 )
+    #include "critstats.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -2124,7 +2128,9 @@ void vTaskEndScheduler( void )
 }
 /*----------------------------------------------------------*/
 
-void vTaskSuspendAll( void )
+/* The name is in brackets so the vTaskSuspendAll() macro of task.h, defined
+ * when configUSE_CRITICAL_STATS is 1, does not replace it. */
+void ( vTaskSuspendAll )( void )
 {
     /* A critical section is not required as the variable is of type
      * BaseType_t.  Please read Richard Barry's reply in the following link to a
@@ -2145,6 +2151,25 @@ void vTaskSuspendAll( void )
 }
 /*----------------------------------------------------------*/
 
+#if ( configUSE_CRITICAL_STATS == 1 )
+
+    void vTaskSuspendAllFrom( const char * pcFile,
+                              uint32_t ulLine )
+    {
+        ( vTaskSuspendAll )();
+
+        /* Nested suspensions are part of the outermost one.  No other task
+         * can run until it ends, so the site can be noted without a critical
+         * section. */
+        if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+        {
+            vCritStatsEnter( critstatsSUSPEND, pcFile, ulLine );
+        }
+    }
+
+#endif /* configUSE_CRITICAL_STATS */
+/*----------------------------------------------------------*/
+
 #if ( configUSE_TICKLESS_IDLE != 0 )
 
     static TickType_t prvGetExpectedIdleTime( void )
@@ -2224,6 +2249,15 @@ BaseType_t xTaskResumeAll( void )
      * tasks from this list into their appropriate ready list. */
     taskENTER_CRITICAL();
     {
+        #if ( configUSE_CRITICAL_STATS == 1 )
+            {
+                if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+                {
+                    vCritStatsExit( critstatsSUSPEND );
+                }
+            }
+        #endif
+
         --uxSchedulerSuspended;
 
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
@@ -4690,6 +4724,32 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+    BaseType_t xTaskDecrementMutexHeldCount( void )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* Other tasks only ever read the count of the running task, so it can
+         * be decremented without a critical section.  An inherited priority
+         * has to be given back by xTaskPriorityDisinherit() instead, which
+         * decrements the count itself. */
+        if( pxCurrentTCB->uxPriority != pxCurrentTCB->uxBasePriority )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            configASSERT( pxCurrentTCB->uxMutexesHeld );
+            ( pxCurrentTCB->uxMutexesHeld )--;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
@@ -24,6 +24,14 @@ MEMORY
 /* --stack_size=256                                                          */
 /* --library=rtsv7M4_T_le_eabi.lib                                           */
 
+/* 1 to run the context switch, tick and receive interrupt paths, the        */
+/* functions marked portHOT_FUNCTION, from SRAM without flash wait states.   */
+/* They are loaded in flash and copied to SRAM at boot through the binit     */
+/* copy table. It can also be set with --define=HOT_PATHS_IN_SRAM=1.         */
+#ifndef HOT_PATHS_IN_SRAM
+#define HOT_PATHS_IN_SRAM 0
+#endif
+
 /* Section allocation in memory */
 
 SECTIONS
@@ -34,12 +42,36 @@ SECTIONS
     .cinit  :   > FLASH
     .pinit  :   > FLASH
     .init_array : > FLASH
+    .binit  :   > FLASH
+
+    /* The LOG() format strings, kept in the output file for log_decode.py   */
+    /* but never loaded, at 0 so the address of each string is its ID.       */
+    .logstr :   > 0x00000000, type = COPY
 
     .vtable :   > 0x20000000
-    .data   :   > SRAM
-    .bss    :   > SRAM
-    .sysmem :   > SRAM
-    .stack  :   > SRAM
+
+    /* Keep the variables together at the bottom of SRAM and the stack at    */
+    /* the top, so all the SRAM in between is one piece. main() gives it to  */
+    /* heap_5.c, from __HEAP_START to __HEAP_END, so the FreeRTOS heap grows */
+    /* and shrinks with the variables instead of being a fixed size array.   */
+    GROUP
+    {
+        .data
+        .bss
+        .sysmem
+    } > SRAM, END(__HEAP_START)
+
+#if HOT_PATHS_IN_SRAM
+    /* The hot code runs just below the stack, out of the way of the heap.   */
+    GROUP
+    {
+        .hot_text : load = FLASH, table(BINIT)
+        .stack
+    } run = SRAM (HIGH), START(__HEAP_END)
+#else
+    .hot_text : > FLASH
+    .stack  :   > SRAM (HIGH), RUN_START(__HEAP_END)
+#endif
 }
 
 __STACK_TOP = __stack + 512;
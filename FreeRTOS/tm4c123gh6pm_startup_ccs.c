@@ -24,6 +24,8 @@
 
 #include <stdint.h>
 
+#include "vectors.h"
+
 //*****************************************************************************
 //
 // Forward declaration of the default fault handlers.
@@ -54,10 +56,13 @@ extern uint32_t __STACK_TOP;
 
 //*****************************************************************************
 //
-// External declarations for the interrupt handlers used by the application.
+// External declarations for the interrupt handlers used by the application,
+// one for each VECTOR() of vectors.h.
 //
 //*****************************************************************************
-// To be added by user
+#define VECTOR_DECLARE(ui32Interrupt, pfnHandler)                             \
+    extern void pfnHandler(void);
+VECTORS(VECTOR_DECLARE)
 
 //*****************************************************************************
 //
@@ -224,7 +229,16 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // PWM 1 Generator 1
     IntDefaultHandler,                      // PWM 1 Generator 2
     IntDefaultHandler,                      // PWM 1 Generator 3
-    IntDefaultHandler                       // PWM 1 Fault
+    IntDefaultHandler,                      // PWM 1 Fault
+
+    //
+    // The handlers of vectors.h, each one replaces the default handler in the
+    // slot of its interrupt number above, so they are bound at compile time
+    // and nothing has to be copied to the SRAM table of IntRegister().
+    //
+#define VECTOR_BIND(ui32Interrupt, pfnHandler)                                \
+    [ui32Interrupt] = pfnHandler,
+    VECTORS(VECTOR_BIND)
 };
 
 //*****************************************************************************
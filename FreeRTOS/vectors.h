@@ -0,0 +1,38 @@
+/*
+ * Interrupt handlers of the application, bound at compile time. Every
+ * VECTOR (interrupt, handler) line declares the handler in
+ * tm4c123gh6pm_startup_ccs.c and puts it in the slot of the interrupt number
+ * of inc/hw_ints.h in the flash vector table, in place of IntDefaultHandler.
+ * Binding a handler here instead of with IntRegister() or GPIOIntRegister()
+ * keeps the vector table out of SRAM: those copy all of it to the .vtable
+ * section at 0x20000000, 620 bytes, the first time they are called.
+ */
+
+#ifndef VECTORS_H
+#define VECTORS_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* TivaWare includes.  */
+#include "inc/hw_ints.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* 1 to register the handlers at run time with GPIOIntRegister() as well, which moves the vector table
+ * to SRAM, so handlers can then be swapped while running. */
+#define VECTORS_RUNTIME_REGISTER 0
+
+#define VECTORS(VECTOR)                                                       \
+    VECTOR (INT_UART0,   UART0IntHandler)                                     \
+    VECTOR (INT_TIMER0A, Timer0AIntHandler)                                   \
+    VECTOR (INT_GPIOF,   GPIOFIntHandler)                                     \
+    VECTOR (INT_UART1,   Serial_UART1IntHandler)                              \
+    VECTOR (INT_UART3,   Serial_UART3IntHandler)                              \
+    VECTOR (INT_UART4,   Serial_UART4IntHandler)                              \
+    VECTOR (INT_UART7,   Serial_UART7IntHandler)
+
+#endif /* VECTORS_H */
@@ -3,12 +3,13 @@
 
 /* Here is a good place to include header files that are required across
 your application. */
+#include "clock.h"
 
 
 #define configUSE_PREEMPTION                    1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #define configUSE_TICKLESS_IDLE                 0
-#define configCPU_CLOCK_HZ                      80000000
+#define configCPU_CLOCK_HZ                      ( Clock_getFrequency() ) /* Set up by Clock_Init, the SysTick reload is derived from it when the scheduler starts. */
 #define configTICK_RATE_HZ                      1000
 #define configMAX_PRIORITIES                    5
 #define configMINIMAL_STACK_SIZE                128
@@ -63,6 +64,10 @@ your application. */
 /* Define to trap errors during development. */
 #define configASSERT(x)
 
+/* FPU context related definitions. */
+#define configTASK_DEFAULT_USES_FPU             1
+#define configFPU_LAZY_STACKING                 1
+
 /* FreeRTOS MPU specific definitions. */
 #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS 0
 
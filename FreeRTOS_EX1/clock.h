@@ -0,0 +1,71 @@
+/*
+ * System clock configuration, keeps the core clock, the FreeRTOS tick
+ * and the UART baud rate divisors consistent with each other.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Frequency of the external crystal on the LaunchPad, and of the MCU after reset. */
+#define CLOCK_XTAL_HZ          16000000
+
+/* Frequency we run the MCU at, 400 MHz PLL / 2 / 2.5. */
+#define CLOCK_PLL_HZ           80000000
+
+/* Maximum number of UART modules whose divisors follow the system clock. */
+#define CLOCK_MAX_UARTS        8
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+/* Clock levels the MCU can be switched between at run time, all of them derived
+ * from the PLL so switching does not have to wait for it to lock again. */
+typedef enum
+{
+    CLOCK_LEVEL_80MHZ,
+    CLOCK_LEVEL_40MHZ,
+    CLOCK_LEVEL_16MHZ,
+    CLOCK_LEVELS
+} Clock_Level;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Run the MCU at CLOCK_PLL_HZ from the PLL, returns the frequency actually in use. */
+uint32_t Clock_Init (void);
+
+/* Frequency the MCU is running at right now, used as configCPU_CLOCK_HZ. */
+uint32_t Clock_getFrequency (void);
+
+/* Check that the PLL is locked and the hardware agrees with Clock_getFrequency(). */
+bool Clock_verify (void);
+
+/* Configure a UART from the current clock, and keep its divisors right if the clock changes.
+ * Returns false, and leaves the UART as it was, if the rate is not within the tolerance of baud.h. */
+bool Clock_UARTConfigSet (uint32_t ui32Base, uint32_t ui32Baud, uint32_t ui32Config);
+
+/* Switch the MCU to another clock level, retuning the SysTick and the UARTs atomically.
+ * Returns false if the PLL is not in use, or a UART could not keep its rate at that level. */
+bool Clock_setLevel (Clock_Level eLevel);
+
+/* Clock level the MCU is running at right now. */
+Clock_Level Clock_getLevel (void);
+
+/* Frequency of a given clock level. */
+uint32_t Clock_getLevelFrequency (Clock_Level eLevel);
+
+#endif /* CLOCK_H */
@@ -12,6 +12,8 @@
 #include <stdbool.h>
 
 /* Header Files Includes.  */
+#include "clock.h"
+#include "vectors.h"
 
 
 
@@ -22,6 +24,7 @@
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
 #include "driverlib/uart.h"
+#include "driverlib/interrupt.h"
 #include "utils/uartstdio.h"
 
 /* FreeRTOS includes. */
@@ -143,8 +146,13 @@ void PORTF_Init (void)
     GPIOPadConfigSet(GPIO_PORTF_BASE, PINS, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
     /* Enable interrupt on the enable pins. */
     GPIOIntEnable(GPIO_PORTF_BASE, PINS);
+#if (VECTORS_RUNTIME_REGISTER == 1)
     /* Determine which Interrupt Handler to use upon Interrupt. */
     GPIOIntRegister(GPIO_PORTF_BASE, GPIOFIntHandler);
+#else
+    /* GPIOFIntHandler is already in the flash vector table, see vectors.h, so only enable the interrupt. */
+    IntEnable(INT_GPIOF);
+#endif
     /* Determine Interrupt to occur on falling edge. */
     GPIOIntTypeSet(GPIO_PORTF_BASE, PINS, GPIO_FALLING_EDGE);
     /* Enable Interrupts for both pins (PF0, PF4). */
@@ -167,7 +175,7 @@ void UART0_Init (void)
     GPIOPinTypeUART  (GPIO_PORTA_BASE, PINS);
     /* Initialize the UART, by choosing UART0, baud rate as 128000,
      * 8 bits mode, 1 stop bit, and no parity bit. */
-    UARTConfigSetExpClk (UART0_BASE, SysCtlClockGet(), 128000, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |UART_CONFIG_PAR_NONE));
+    Clock_UARTConfigSet (UART0_BASE, 128000, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |UART_CONFIG_PAR_NONE));
     /* Finalize the initialization process by enabling the module to transmit and receive FIFOs. / */
     UARTEnable(UART0_BASE);
 }
@@ -296,8 +304,8 @@ void vTask2 (void * pvParameters)
 
 int main (void)
 {
-    /* Initialize Clock with 80 Mhz. */
-    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    /* Initialize Clock with 80 Mhz from the PLL, the kernel tick and the UART divisors are derived from it. */
+    Clock_Init ();
 
     /* Initialize Switches and LEDS. */
     PORTF_Init ();
@@ -305,6 +313,12 @@ int main (void)
     /* Initialize UART with PC Communications. */
     UART0_Init ();
 
+    /* Make sure the clock the tick and the baud rate were computed from is the one actually running. */
+    if (Clock_verify () == false)
+    {
+        UART_sendString (UART0_BASE, "The system clock could not be verified at 80 MHz, timing may be inaccurate. \n\r");
+    }
+
     /* Create a dormant timer, to be used to toggle LEDS at different intervals. */
     xTimer = xTimerCreate("Toggle Timer", pdMS_TO_TICKS(milli_seconds[global_counter]), pdTRUE, (void *) 0, vTimerCallback);
 
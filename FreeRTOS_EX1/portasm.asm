@@ -31,17 +31,20 @@
 	.ref pxCurrentTCB
 	.ref vTaskSwitchContext
 	.ref ulMaxSyscallInterruptPriority
+	.ref ulPortTaskFPUAttribute
 
 	.def xPortPendSVHandler
 	.def ulPortGetIPSR
 	.def vPortSVCHandler
 	.def vPortStartFirstTask
 	.def vPortEnableVFP
+	.def vPortClearFPCA
 
 NVICOffsetConst:					.word 	0xE000ED08
 CPACRConst:							.word 	0xE000ED88
 pxCurrentTCBConst:					.word	pxCurrentTCB
 ulMaxSyscallInterruptPriorityConst: .word ulMaxSyscallInterruptPriority
+ulPortTaskFPUAttributeConst:		.word	ulPortTaskFPUAttribute
 
 ; -----------------------------------------------------------
 
@@ -62,13 +65,16 @@ vPortSetInterruptMask: .asmfunc
 	.endasmfunc
 ; -----------------------------------------------------------
 
+	;/* With the other functions on the context switch path, see
+	;portHOT_FUNCTION in portmacro.h. */
+	.sect ".hot_text"
 	.align 4
 xPortPendSVHandler: .asmfunc
 	mrs r0, psp
 	isb
 
 	;/* Get the location of the current TCB. */
-	ldr	r3, pxCurrentTCBConst
+	ldr	r3, pxCurrentTCBHotConst
 	ldr	r2, [r3]
 
 	;/* Is the task using the FPU context?  If so, push high vfp registers. */
@@ -76,14 +82,16 @@ xPortPendSVHandler: .asmfunc
 	it eq
 	vstmdbeq r0!, {s16-s31}
 
-	;/* Save the core registers. */
-	stmdb r0!, {r4-r11, r14}
+	;/* Save the core registers along with the FPU attribute of the task. */
+	ldr r1, ulPortTaskFPUAttributeHotConst
+	ldr r1, [r1]
+	stmdb r0!, {r1, r4-r11, r14}
 
 	;/* Save the new top of stack into the first member of the TCB. */
 	str r0, [r2]
 
 	stmdb sp!, {r0, r3}
-	ldr r0, ulMaxSyscallInterruptPriorityConst
+	ldr r0, ulMaxSyscallInterruptPriorityHotConst
 	ldr r1, [r0]
 	msr basepri, r1
 	dsb
@@ -97,9 +105,24 @@ xPortPendSVHandler: .asmfunc
 	ldr r1, [r3]
 	ldr r0, [r1]
 
-	;/* Pop the core registers. */
-	ldmia r0!, {r4-r11, r14}
+	;/* Pop the core registers and the FPU attribute of the task. */
+	ldmia r0!, {r1, r4-r11, r14}
+
+	;/* Only touch the CPACR when the FPU attribute actually changes. */
+	ldr r2, ulPortTaskFPUAttributeHotConst
+	ldr r3, [r2]
+	cmp r1, r3
+	beq xPortPendSVRestoreFPU
+	str r1, [r2]
+	ldr.w r2, CPACRHotConst
+	ldr r3, [r2]
+	bic r3, r3, #( 0xf << 20 )
+	orr r3, r3, r1
+	str r3, [r2]
+	dsb
+	isb
 
+xPortPendSVRestoreFPU:
 	;/* Is the task using the FPU context?  If so, pop the high vfp registers
 	;too. */
 	tst r14, #0x10
@@ -111,6 +134,16 @@ xPortPendSVHandler: .asmfunc
 	bx r14
 	.endasmfunc
 
+	;/* The literals xPortPendSVHandler loads pc relative have to be in
+	;.hot_text as well, to stay within reach wherever the section runs. */
+	.align 4
+CPACRHotConst:						.word 	0xE000ED88
+pxCurrentTCBHotConst:				.word	pxCurrentTCB
+ulMaxSyscallInterruptPriorityHotConst: .word ulMaxSyscallInterruptPriority
+ulPortTaskFPUAttributeHotConst:		.word	ulPortTaskFPUAttribute
+
+	.text
+
 ; -----------------------------------------------------------
 
 	.align 4
@@ -119,9 +152,18 @@ vPortSVCHandler: .asmfunc
 	ldr	r3, pxCurrentTCBConst
 	ldr r1, [r3]
 	ldr r0, [r1]
-	;/* Pop the core registers. */
-	ldmia r0!, {r4-r11, r14}
+	;/* Pop the core registers and the FPU attribute of the task. */
+	ldmia r0!, {r1, r4-r11, r14}
 	msr psp, r0
+	;/* Give the first task the FPU access its attribute asks for. */
+	ldr r2, ulPortTaskFPUAttributeConst
+	str r1, [r2]
+	ldr.w r2, CPACRConst
+	ldr r3, [r2]
+	bic r3, r3, #( 0xf << 20 )
+	orr r3, r3, r1
+	str r3, [r2]
+	dsb
 	isb
 	mov r0, #0
 	msr	basepri, r0
@@ -166,6 +208,20 @@ vPortEnableVFP: .asmfunc
 	bx	r14
 	.endasmfunc
 
+; -----------------------------------------------------------
+
+	.align 4
+vPortClearFPCA: .asmfunc
+	;/* Clear the bit that indicates the FPU is in use, so the current
+	;floating point register values are discarded and not saved by the next
+	;context switch. */
+	mrs r0, control
+	bic r0, r0, #4
+	msr control, r0
+	isb
+	bx r14
+	.endasmfunc
+
 	.end
 
 ; -----------------------------------------------------------
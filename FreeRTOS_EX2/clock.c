@@ -0,0 +1,223 @@
+/*
+ * System clock configuration, keeps the core clock, the FreeRTOS tick
+ * and the UART baud rate divisors consistent with each other.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "clock.h"
+#include "baud.h"
+
+/* TivaWare includes.  */
+#include "inc/hw_memmap.h"
+#include "inc/tm4c123gh6pm.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Needed #defines */
+#define PLL_LOCK_BIT       0x00000001
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* The MCU runs from the precision internal oscillator until Clock_Init is called. */
+static uint32_t ulClockHz = CLOCK_XTAL_HZ;
+
+/* Clock level selected by Clock_Init or Clock_setLevel. */
+static Clock_Level eClockLevel = CLOCK_LEVEL_80MHZ;
+
+/* Cleared if the PLL failed to lock at boot and the MCU fell back to the crystal. */
+static bool bClockPLLInUse = false;
+
+/* SysCtlClockSet configuration and frequency of every clock level, 400 MHz PLL / 2 / SYSDIV. */
+static const struct
+{
+    uint32_t ui32Config;
+    uint32_t ui32Hz;
+} xClockLevels [CLOCK_LEVELS] =
+{
+    { SYSCTL_SYSDIV_2_5  | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ, 80000000 },
+    { SYSCTL_SYSDIV_5    | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ, 40000000 },
+    { SYSCTL_SYSDIV_12_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ, 16000000 }
+};
+
+/* UART modules configured through Clock_UARTConfigSet, with the settings needed to reprogram them. */
+static struct
+{
+    uint32_t ui32Base;
+    uint32_t ui32Baud;
+    uint32_t ui32Config;
+} xClockUARTs [CLOCK_MAX_UARTS];
+
+static uint8_t ucClockUARTCount = 0;
+
+/*****************************************************************************/
+/*                                Clock Functions                            */
+/*****************************************************************************/
+
+uint32_t Clock_Init (void)
+{
+    /* Use the main oscillator with the 16MHz crystal to drive the PLL, and divide its 400 MHz output by 5. */
+    SysCtlClockSet(xClockLevels[CLOCK_LEVEL_80MHZ].ui32Config);
+
+    if ((SYSCTL_PLLSTAT_R & PLL_LOCK_BIT) == PLL_LOCK_BIT)
+    {
+        ulClockHz = CLOCK_PLL_HZ;
+        eClockLevel = CLOCK_LEVEL_80MHZ;
+        bClockPLLInUse = true;
+    }
+    else
+    {
+        /* The PLL did not lock, so run directly from the crystal instead of an unknown clock,
+         * the rest of the system still sees the right frequency through Clock_getFrequency. */
+        SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+        ulClockHz = CLOCK_XTAL_HZ;
+        bClockPLLInUse = false;
+    }
+
+    return ulClockHz;
+}
+
+uint32_t Clock_getFrequency (void)
+{
+    return ulClockHz;
+}
+
+bool Clock_verify (void)
+{
+    /* The PLL has to be locked, or we are only running from the fallback clock. */
+    if ((bClockPLLInUse == false) || ((SYSCTL_PLLSTAT_R & PLL_LOCK_BIT) != PLL_LOCK_BIT))
+    {
+        return false;
+    }
+
+    /* The divisors programmed in RCC/RCC2 must give the frequency everything else was computed from. */
+    if (SysCtlClockGet() != ulClockHz)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool Clock_UARTConfigSet (uint32_t ui32Base, uint32_t ui32Baud, uint32_t ui32Config)
+{
+    /* Counter Declaration to be used to look for the UART in the table. */
+    uint8_t i = 0;
+
+    /* Divisor and error of the rate at the clock we are running at. */
+    Baud_Setting xSetting;
+
+    /* The governor must not change the clock between the check and the divisors. */
+    vTaskSuspendAll ();
+
+    /* A rate the divisors cannot come close enough to would garble the characters, keep the UART as it is. */
+    if (Baud_compute (ulClockHz, ui32Baud, &xSetting) == false)
+    {
+        ( void ) xTaskResumeAll ();
+        return false;
+    }
+
+    /* Remember the settings, so the divisors can be recomputed if the clock changes. */
+    while ((i < ucClockUARTCount) && (xClockUARTs[i].ui32Base != ui32Base))
+    {
+        i++;
+    }
+
+    if (i < CLOCK_MAX_UARTS)
+    {
+        xClockUARTs[i].ui32Base   = ui32Base;
+        xClockUARTs[i].ui32Baud   = ui32Baud;
+        xClockUARTs[i].ui32Config = ui32Config;
+
+        if (i == ucClockUARTCount)
+        {
+            ucClockUARTCount++;
+        }
+    }
+
+    /* Compute the integer and fractional divisors from the clock we are actually running at. */
+    UARTConfigSetExpClk (ui32Base, ulClockHz, ui32Baud, ui32Config);
+    ( void ) xTaskResumeAll ();
+
+    return true;
+}
+
+bool Clock_setLevel (Clock_Level eLevel)
+{
+    /* Counter Declaration to be used to loop over the UARTs that follow the clock. */
+    uint8_t i;
+
+    /* Divisor and error of the rate of a UART at the new clock. */
+    Baud_Setting xSetting;
+
+    if ((eLevel >= CLOCK_LEVELS) || (bClockPLLInUse == false))
+    {
+        /* Unknown level, or the PLL never locked at boot. */
+        return false;
+    }
+
+    if (eLevel == eClockLevel)
+    {
+        return true;
+    }
+
+    /* A UART at a rate too fast for the new clock, such as 3 Mbaud at 16 MHz, keeps the MCU at this level. */
+    for (i = 0; i < ucClockUARTCount; i++)
+    {
+        if (Baud_compute (xClockLevels[eLevel].ui32Hz, xClockUARTs[i].ui32Baud, &xSetting) == false)
+        {
+            return false;
+        }
+    }
+
+    /* Keep other tasks from queueing more characters while the transmitters drain,
+     * a character on the line while the clock changes would be corrupted. */
+    vTaskSuspendAll ();
+    for (i = 0; i < ucClockUARTCount; i++)
+    {
+        while (UARTBusy (xClockUARTs[i].ui32Base)) {}
+    }
+
+    /* The clock, the tick and the baud rate divisors change together, so no interrupt
+     * that uses the kernel or the UARTs can run with a mix of old and new settings. */
+    taskENTER_CRITICAL ();
+    {
+        SysCtlClockSet(xClockLevels[eLevel].ui32Config);
+        ulClockHz = xClockLevels[eLevel].ui32Hz;
+        eClockLevel = eLevel;
+
+        vPortRetuneTimerInterrupt ();
+
+        for (i = 0; i < ucClockUARTCount; i++)
+        {
+            UARTConfigSetExpClk (xClockUARTs[i].ui32Base, ulClockHz, xClockUARTs[i].ui32Baud, xClockUARTs[i].ui32Config);
+        }
+    }
+    taskEXIT_CRITICAL ();
+    ( void ) xTaskResumeAll ();
+
+    return true;
+}
+
+Clock_Level Clock_getLevel (void)
+{
+    return eClockLevel;
+}
+
+uint32_t Clock_getLevelFrequency (Clock_Level eLevel)
+{
+    return xClockLevels[eLevel].ui32Hz;
+}
@@ -12,6 +12,7 @@
 #include <stdbool.h>
 
 /* Header Files Includes.  */
+#include "clock.h"
 
 
 /* TivaWare includes.  */
@@ -88,7 +89,7 @@ void UART0_Init (void)
     GPIOPinTypeUART  (GPIO_PORTA_BASE, PINS);
     /* Initialize the UART, by choosing UART0, baud rate as 128000,
      * 8 bits mode, 1 stop bit, and no parity bit. */
-    UARTConfigSetExpClk (UART0_BASE, SysCtlClockGet(), 128000, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |UART_CONFIG_PAR_NONE));
+    Clock_UARTConfigSet (UART0_BASE, 128000, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |UART_CONFIG_PAR_NONE));
     /* Finalize the initialization process by enabling the module to transmit and receive FIFOs. / */
     UARTEnable(UART0_BASE);
 }
@@ -184,8 +185,8 @@ static void MyIdleTask(void* pvParameters)
 /*****************************************************************************/
 int main (void)
 {
-    /* Enable Clock of MCU with no Pre-Scalar, use OSC, main oscillator source, 16MHz external crystal frequency*/
-    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    /* Initialize Clock with 80 Mhz from the PLL, the kernel tick and the UART divisors are derived from it. */
+    Clock_Init ();
 
     /* Initialize PORTF through PINS PF1, PF2 and PF3 to be used as LEDS. */
     PORTF_Init ();
@@ -193,6 +194,12 @@ int main (void)
     /* Initialize UART0 through PINS PA0 and PA2 as Rx and Tx. / */
     UART0_Init ();
 
+    /* Make sure the clock the tick and the baud rate were computed from is the one actually running. */
+    if (Clock_verify () == false)
+    {
+        UART_sendString (UART0_BASE, "The system clock could not be verified at 80 MHz, timing may be inaccurate. \n\r");
+    }
+
     /* Create Tasks that send string to UART. */
     xTaskCreate(MyIdleTask, "IdleTask", 100, NULL, 0, NULL);
     xTaskCreate(MyTask1, "Task1", 100, NULL, 1, NULL);
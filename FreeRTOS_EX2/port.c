@@ -34,7 +34,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
-#ifndef __TI_VFP_SUPPORT__
+#if !defined( __TI_VFP_SUPPORT__ ) && !defined( __ARM_FP )
     #error This port can only be used when the project options are configured to enable hardware floating point support.
 #endif
 
@@ -84,6 +84,34 @@
 /* Constants required to manipulate the VFP. */
 #define portFPCCR                             ( ( volatile uint32_t * ) 0xe000ef34 ) /* Floating point context control register. */
 #define portASPEN_AND_LSPEN_BITS              ( 0x3UL << 30UL )
+#define portASPEN_BIT                         ( 0x1UL << 31UL )
+#define portCPACR                             ( ( volatile uint32_t * ) 0xe000ed88 ) /* Coprocessor access control register. */
+#define portCPACR_CP10_CP11_BITS              ( 0xfUL << 20UL )
+
+/* By default every task is allowed to use the FPU, which matches the
+ * behaviour of the port before per task FPU attributes were added. */
+#ifndef configTASK_DEFAULT_USES_FPU
+    #define configTASK_DEFAULT_USES_FPU    1
+#endif
+
+/* Lazy stacking only reserves space for s0-s15 in the exception frame and
+ * defers the actual store until the handler touches the FPU.  Setting
+ * configFPU_LAZY_STACKING to 0 makes the hardware always store them. */
+#ifndef configFPU_LAZY_STACKING
+    #define configFPU_LAZY_STACKING    1
+#endif
+
+#if ( configFPU_LAZY_STACKING == 1 )
+    #define portFPCCR_STACKING_BITS    portASPEN_AND_LSPEN_BITS
+#else
+    #define portFPCCR_STACKING_BITS    portASPEN_BIT
+#endif
+
+#if ( configTASK_DEFAULT_USES_FPU == 1 )
+    #define portINITIAL_FPU_ATTRIBUTE    portFPU_ATTRIBUTE_FULL
+#else
+    #define portINITIAL_FPU_ATTRIBUTE    portFPU_ATTRIBUTE_NONE
+#endif
 
 /* Constants required to set up the initial stack. */
 #define portINITIAL_XPSR                      ( 0x01000000 )
@@ -109,9 +137,10 @@
 void vPortSetupTimerInterrupt( void );
 
 /*
- * Exception handlers.
+ * Exception handlers.  xPortPendSVHandler() in portasm.asm, or at the end of
+ * this file when built with GCC, is in .hot_text as well.
  */
-void xPortSysTickHandler( void );
+portHOT_FUNCTION void xPortSysTickHandler( void );
 
 /*
  * Start first task is a separate function so it can be tested in isolation.
@@ -123,6 +152,12 @@ extern void vPortStartFirstTask( void );
  */
 extern void vPortEnableVFP( void );
 
+/*
+ * Clear CONTROL.FPCA so the current task no longer has a floating point
+ * context to save on the next context switch.
+ */
+extern void vPortClearFPCA( void );
+
 /*
  * Used to catch tasks that attempt to return from their implementing function.
  */
@@ -134,6 +169,13 @@ static void prvTaskExitError( void );
  * setting. */
 const uint32_t ulMaxSyscallInterruptPriority = configMAX_SYSCALL_INTERRUPT_PRIORITY;
 
+/* The FPU attribute of the task that is currently running, held in the same
+ * CP10/CP11 bit format as the CPACR.  portasm.asm saves it as part of the task
+ * context and writes it back to the CPACR whenever it changes, so a task that
+ * has no FPU access takes a usage fault the moment it executes an FPU
+ * instruction. */
+uint32_t ulPortTaskFPUAttribute = portFPU_ATTRIBUTE_FULL;
+
 /* Each task maintains its own interrupt status in the critical nesting
  * variable. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
@@ -205,6 +247,10 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 
     pxTopOfStack -= 8; /* R11, R10, R9, R8, R7, R6, R5 and R4. */
 
+    /* The FPU attribute is saved below the core registers. */
+    pxTopOfStack--;
+    *pxTopOfStack = portINITIAL_FPU_ATTRIBUTE;
+
     return pxTopOfStack;
 }
 /*-----------------------------------------------------------*/
@@ -305,11 +351,14 @@ BaseType_t xPortStartScheduler( void )
     /* Initialise the critical nesting count ready for the first task. */
     uxCriticalNesting = 0;
 
-    /* Ensure the VFP is enabled - it should be anyway. */
+    /* Ensure the VFP is enabled - it should be anyway.  The CPACR is then
+     * rewritten with the FPU attribute of the first task when it starts. */
     vPortEnableVFP();
+    ulPortTaskFPUAttribute = portFPU_ATTRIBUTE_FULL;
 
-    /* Lazy save always. */
-    *( portFPCCR ) |= portASPEN_AND_LSPEN_BITS;
+    /* Lazy save unless configFPU_LAZY_STACKING says otherwise. */
+    *( portFPCCR ) &= ~portASPEN_AND_LSPEN_BITS;
+    *( portFPCCR ) |= portFPCCR_STACKING_BITS;
 
     /* Start the first task. */
     vPortStartFirstTask();
@@ -356,6 +405,39 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortTaskSetFPUAttribute( uint32_t ulAttribute )
+{
+    portENTER_CRITICAL();
+    {
+        if( ulAttribute == portFPU_ATTRIBUTE_NONE )
+        {
+            /* Discard any floating point context first, otherwise the next
+             * context switch would try to save it with the FPU disabled. */
+            vPortClearFPCA();
+        }
+
+        ulPortTaskFPUAttribute = ulAttribute;
+        *( portCPACR ) = ( *( portCPACR ) & ~portCPACR_CP10_CP11_BITS ) | ulAttribute;
+        __asm( "	dsb");
+        __asm( "	isb");
+    }
+    portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPortResetFPUContext( void )
+{
+    /* The registers are simply abandoned, so only call this once the floating
+     * point values held in them are no longer needed.  The task keeps its FPU
+     * attribute and will get a fresh context the next time it uses the FPU. */
+    portENTER_CRITICAL();
+    {
+        vPortClearFPCA();
+    }
+    portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
 void xPortSysTickHandler( void )
 {
     /* The SysTick runs at the lowest interrupt priority, so when this interrupt
@@ -378,7 +460,11 @@ void xPortSysTickHandler( void )
 
 #if ( configUSE_TICKLESS_IDLE == 1 )
 
-    #pragma WEAK( vPortSuppressTicksAndSleep )
+    #ifdef __TI_ARM__
+        #pragma WEAK( vPortSuppressTicksAndSleep )
+    #else
+        __attribute__( ( weak ) )
+    #endif
     void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
     {
         uint32_t ulReloadValue, ulCompleteTickPeriods, ulCompletedSysTickDecrements;
@@ -551,7 +637,11 @@ void xPortSysTickHandler( void )
  * Setup the systick timer to generate the tick interrupts at the required
  * frequency.
  */
-#pragma WEAK( vPortSetupTimerInterrupt )
+#ifdef __TI_ARM__
+    #pragma WEAK( vPortSetupTimerInterrupt )
+#else
+    __attribute__( ( weak ) )
+#endif
 void vPortSetupTimerInterrupt( void )
 {
     /* Calculate the constants required to configure the tick interrupt. */
@@ -573,6 +663,25 @@ void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortRetuneTimerInterrupt( void )
+{
+    /* Called from a critical section after the core clock has changed.  Only
+     * the reload value is updated, the SysTick is not stopped, so the tick
+     * period in progress finishes with whatever count is left and every
+     * following period uses the new clock.  At most one tick is stretched or
+     * shortened and no tick is lost. */
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+        {
+            ulTimerCountsForOneTick = ( configSYSTICK_CLOCK_HZ / configTICK_RATE_HZ );
+            xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
+            ulStoppedTimerCompensation = portMISSED_COUNTS_FACTOR / ( configCPU_CLOCK_HZ / configSYSTICK_CLOCK_HZ );
+        }
+    #endif /* configUSE_TICKLESS_IDLE */
+
+    portNVIC_SYSTICK_LOAD_REG = ( configSYSTICK_CLOCK_HZ / configTICK_RATE_HZ ) - 1UL;
+}
+/*-----------------------------------------------------------*/
+
 #if ( configASSERT_DEFINED == 1 )
 
     void vPortValidateInterruptPriority( void )
@@ -613,6 +722,9 @@ void vPortSetupTimerInterrupt( void )
              * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html
              * https://www.FreeRTOS.org/FAQHelp.html */
             configASSERT( ucCurrentPriority >= ucMaxSysCallPriority );
+
+            /* Prevent compiler warnings when configASSERT() is defined empty. */
+            ( void ) ucCurrentPriority;
         }
 
         /* Priority grouping:  The interrupt controller (NVIC) allows the bits
@@ -632,3 +744,167 @@ void vPortSetupTimerInterrupt( void )
     }
 
 #endif /* configASSERT_DEFINED */
+/*-----------------------------------------------------------*/
+
+/* The TI build takes the functions below from portasm.asm, which GCC cannot
+ * assemble, so the GCC build has them here instead, the same instruction for
+ * instruction. */
+#ifndef __TI_ARM__
+
+    uint32_t ulPortGetIPSR( void )
+    {
+        uint32_t ulIPSR;
+
+        __asm volatile ( "mrs %0, ipsr" : "=r" ( ulIPSR ) );
+
+        return ulIPSR;
+    }
+/*-----------------------------------------------------------*/
+
+    portHOT_FUNCTION __attribute__( ( naked ) ) void xPortPendSVHandler( void )
+    {
+        /* The literals are local to the function, so they follow it into
+         * .hot_text wherever that runs. */
+        __asm volatile
+        (
+            "	mrs r0, psp								\n"
+            "	isb										\n"
+            "											\n"
+            "	ldr	r3, pxCurrentTCBHotConst			\n" /* Get the location of the current TCB. */
+            "	ldr	r2, [r3]							\n"
+            "											\n"
+            "	tst r14, #0x10							\n" /* Is the task using the FPU context?  If so, push high vfp registers. */
+            "	it eq									\n"
+            "	vstmdbeq r0!, {s16-s31}					\n"
+            "											\n"
+            "	ldr r1, ulPortTaskFPUAttributeHotConst	\n" /* Save the core registers along with the FPU attribute of the task. */
+            "	ldr r1, [r1]							\n"
+            "	stmdb r0!, {r1, r4-r11, r14}			\n"
+            "											\n"
+            "	str r0, [r2]							\n" /* Save the new top of stack into the first member of the TCB. */
+            "											\n"
+            "	stmdb sp!, {r0, r3}						\n"
+            "	mov r0, %0								\n"
+            "	msr basepri, r0							\n"
+            "	dsb										\n"
+            "	isb										\n"
+            "	bl vTaskSwitchContext					\n"
+            "	mov r0, #0								\n"
+            "	msr basepri, r0							\n"
+            "	ldmia sp!, {r0, r3}						\n"
+            "											\n"
+            "	ldr r1, [r3]							\n" /* The first item in pxCurrentTCB is the task top of stack. */
+            "	ldr r0, [r1]							\n"
+            "											\n"
+            "	ldmia r0!, {r1, r4-r11, r14}			\n" /* Pop the core registers and the FPU attribute of the task. */
+            "											\n"
+            "	ldr r2, ulPortTaskFPUAttributeHotConst	\n" /* Only touch the CPACR when the FPU attribute actually changes. */
+            "	ldr r3, [r2]							\n"
+            "	cmp r1, r3								\n"
+            "	beq 1f									\n"
+            "	str r1, [r2]							\n"
+            "	ldr r2, CPACRHotConst					\n"
+            "	ldr r3, [r2]							\n"
+            "	bic r3, r3, #( 0xf << 20 )				\n"
+            "	orr r3, r3, r1							\n"
+            "	str r3, [r2]							\n"
+            "	dsb										\n"
+            "	isb										\n"
+            "											\n"
+            "1:											\n"
+            "	tst r14, #0x10							\n" /* Is the task using the FPU context?  If so, pop the high vfp registers too. */
+            "	it eq									\n"
+            "	vldmiaeq r0!, {s16-s31}					\n"
+            "											\n"
+            "	msr psp, r0								\n"
+            "	isb										\n"
+            "	bx r14									\n"
+            "											\n"
+            "	.align 4								\n"
+            "CPACRHotConst: .word 0xE000ED88			\n"
+            "pxCurrentTCBHotConst: .word pxCurrentTCB	\n"
+            "ulPortTaskFPUAttributeHotConst: .word ulPortTaskFPUAttribute	\n"
+            ::"i" ( configMAX_SYSCALL_INTERRUPT_PRIORITY )
+        );
+    }
+/*-----------------------------------------------------------*/
+
+    __attribute__( ( naked ) ) void vPortSVCHandler( void )
+    {
+        __asm volatile
+        (
+            "	ldr	r3, pxCurrentTCBConst				\n" /* Get the location of the current TCB. */
+            "	ldr r1, [r3]							\n"
+            "	ldr r0, [r1]							\n"
+            "	ldmia r0!, {r1, r4-r11, r14}			\n" /* Pop the core registers and the FPU attribute of the task. */
+            "	msr psp, r0								\n"
+            "	ldr r2, ulPortTaskFPUAttributeConst		\n" /* Give the first task the FPU access its attribute asks for. */
+            "	str r1, [r2]							\n"
+            "	ldr r2, CPACRConst						\n"
+            "	ldr r3, [r2]							\n"
+            "	bic r3, r3, #( 0xf << 20 )				\n"
+            "	orr r3, r3, r1							\n"
+            "	str r3, [r2]							\n"
+            "	dsb										\n"
+            "	isb										\n"
+            "	mov r0, #0								\n"
+            "	msr	basepri, r0							\n"
+            "	bx r14									\n"
+            "											\n"
+            "	.align 4								\n"
+            "CPACRConst: .word 0xE000ED88				\n"
+            "pxCurrentTCBConst: .word pxCurrentTCB		\n"
+            "ulPortTaskFPUAttributeConst: .word ulPortTaskFPUAttribute	\n"
+        );
+    }
+/*-----------------------------------------------------------*/
+
+    __attribute__( ( naked ) ) void vPortStartFirstTask( void )
+    {
+        __asm volatile
+        (
+            "	ldr r0, =0xE000ED08						\n" /* Use the NVIC offset register to locate the stack. */
+            "	ldr r0, [r0]							\n"
+            "	ldr r0, [r0]							\n"
+            "	msr msp, r0								\n" /* Set the msp back to the start of the stack. */
+            "	mov r0, #0								\n" /* Clear the bit that indicates the FPU is in use, see portasm.asm. */
+            "	msr control, r0							\n"
+            "	cpsie i									\n" /* Call SVC to start the first task. */
+            "	cpsie f									\n"
+            "	dsb										\n"
+            "	isb										\n"
+            "	svc 0									\n"
+            "	nop										\n"
+            "	.ltorg									\n"
+        );
+    }
+/*-----------------------------------------------------------*/
+
+    __attribute__( ( naked ) ) void vPortEnableVFP( void )
+    {
+        __asm volatile
+        (
+            "	ldr.w r0, =0xE000ED88					\n" /* The FPU enable bits are in the CPACR. */
+            "	ldr r1, [r0]							\n"
+            "											\n"
+            "	orr r1, r1, #( 0xf << 20 )				\n" /* Enable CP10 and CP11 coprocessors, then save back. */
+            "	str r1, [r0]							\n"
+            "	bx r14									\n"
+            "	.ltorg									\n"
+        );
+    }
+/*-----------------------------------------------------------*/
+
+    __attribute__( ( naked ) ) void vPortClearFPCA( void )
+    {
+        __asm volatile
+        (
+            "	mrs r0, control							\n" /* Clear the bit that indicates the FPU is in use. */
+            "	bic r0, r0, #4							\n"
+            "	msr control, r0							\n"
+            "	isb										\n"
+            "	bx r14									\n"
+        );
+    }
+
+#endif /* __TI_ARM__ */
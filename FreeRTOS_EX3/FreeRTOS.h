@@ -828,6 +828,10 @@
     #define portDONT_DISCARD
 #endif
 
+#ifndef portHOT_FUNCTION
+    #define portHOT_FUNCTION
+#endif
+
 #ifndef configUSE_TIME_SLICING
     #define configUSE_TIME_SLICING    1
 #endif
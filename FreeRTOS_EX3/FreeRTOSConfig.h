@@ -3,12 +3,13 @@
 
 /* Here is a good place to include header files that are required across
 your application. */
+#include "clock.h"
 
 
 #define configUSE_PREEMPTION                    1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
 #define configUSE_TICKLESS_IDLE                 0
-#define configCPU_CLOCK_HZ                      80000000
+#define configCPU_CLOCK_HZ                      ( Clock_getFrequency() ) /* Set up by Clock_Init, the SysTick reload is derived from it when the scheduler starts. */
 #define configTICK_RATE_HZ                      1000
 #define configMAX_PRIORITIES                    5
 #define configMINIMAL_STACK_SIZE                128
@@ -16,6 +17,7 @@ your application. */
 #define configUSE_16_BIT_TICKS                  1
 #define configIDLE_SHOULD_YIELD                 1
 #define configUSE_TASK_NOTIFICATIONS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   3 /* Index 0 for the default API, index 1 for the LED channels, index 2 for the channel benchmark. */
 #define configUSE_MUTEXES                       1
 #define configUSE_RECURSIVE_MUTEXES             1
 #define configUSE_COUNTING_SEMAPHORES           1
@@ -63,6 +65,10 @@ your application. */
 /* Define to trap errors during development. */
 #define configASSERT(x)
 
+/* FPU context related definitions. */
+#define configTASK_DEFAULT_USES_FPU             1
+#define configFPU_LAZY_STACKING                 1
+
 /* FreeRTOS MPU specific definitions. */
 #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS 0
 
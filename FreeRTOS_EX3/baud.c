@@ -0,0 +1,88 @@
+/*
+ * UART baud rates checked against the clock they are divided from, see baud.h.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "baud.h"
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* Rates the hosts set, the usual ones of the PC and the ones of the USB to serial bridges above 1 Mbaud. */
+static const uint32_t ui32BaudRates[] =
+{
+    9600, 14400, 19200, 38400, 57600, 115200, 128000, 230400, 256000, 460800, 500000,
+    921600, 1000000, 1500000, 2000000, 3000000, 4000000, 6000000
+};
+
+#define BAUD_RATES      (sizeof(ui32BaudRates) / sizeof(ui32BaudRates[0]))
+
+/*****************************************************************************/
+/*                                 Baud Functions                            */
+/*****************************************************************************/
+
+bool Baud_compute (uint32_t ui32ClockHz, uint32_t ui32Baud, Baud_Setting *psSetting)
+{
+    uint32_t ui32Oversample, ui32Divisor;
+    int64_t i64Error;
+
+    psSetting->ui32Baud = ui32Baud;
+    psSetting->ui32Actual = 0;
+    psSetting->i32ErrorPpm = 0;
+    psSetting->ui16Integer = 0;
+    psSetting->ui8Fraction = 0;
+
+    /* UARTConfigSetExpClk() only sets HSE when the rate is past the clock / 16. */
+    psSetting->bHighSpeed = (((uint64_t) ui32Baud * BAUD_OVERSAMPLE) > ui32ClockHz);
+    ui32Oversample = (psSetting->bHighSpeed == true) ? BAUD_OVERSAMPLE_HSE : BAUD_OVERSAMPLE;
+    psSetting->ui32TolerancePpm = BAUD_TOLERANCE_PPM (ui32Oversample);
+
+    if ((ui32Baud == 0) || (((uint64_t) ui32Baud * ui32Oversample) > ui32ClockHz))
+    {
+        return false;
+    }
+
+    /* In 64ths and rounded the same way, HSE divides by 16 from half the rate. */
+    ui32Divisor = (((ui32ClockHz * 8) / ((psSetting->bHighSpeed == true) ? (ui32Baud / 2) : ui32Baud)) + 1) / 2;
+    if ((ui32Divisor / 64) > 0xFFFF)
+    {
+        return false;
+    }
+
+    psSetting->ui16Integer = (uint16_t) (ui32Divisor / 64);
+    psSetting->ui8Fraction = (uint8_t) (ui32Divisor % 64);
+
+    /* The clock / (oversample x divisor / 64), which is 4 x the clock / divisor at 16 times a bit. */
+    psSetting->ui32Actual = (uint32_t) ((((uint64_t) ui32ClockHz * 64 / ui32Oversample) + (ui32Divisor / 2)) / ui32Divisor);
+    i64Error = (((int64_t) ui32ClockHz * 64 * 1000000) / ((int64_t) ui32Oversample * ui32Divisor)) - ((int64_t) ui32Baud * 1000000);
+    psSetting->i32ErrorPpm = (int32_t) (i64Error / ui32Baud);
+
+    return ((psSetting->i32ErrorPpm <= (int32_t) psSetting->ui32TolerancePpm) &&
+            (psSetting->i32ErrorPpm >= -(int32_t) psSetting->ui32TolerancePpm));
+}
+
+uint32_t Baud_fastest (uint32_t ui32ClockHz, uint32_t ui32Max)
+{
+    Baud_Setting xSetting;
+    uint32_t i = BAUD_RATES;
+
+    while (i > 0)
+    {
+        i--;
+        if ((ui32BaudRates[i] <= ui32Max) && (Baud_compute (ui32ClockHz, ui32BaudRates[i], &xSetting) == true))
+        {
+            return ui32BaudRates[i];
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * UART baud rates checked against the clock they are divided from.
+ *
+ * The UART divides the system clock by 16, or by 8 with the HSE bit of
+ * UARTCTL, times a divisor with a 6 bit fraction, so most baud rates are only
+ * approached. Baud_compute() works out the divisor the way
+ * UARTConfigSetExpClk() programs it, and the error it leaves. The receiver
+ * finds the start bit within one sample and takes the bit in the middle of
+ * three samples, so the clocks of both ends may drift apart by half a bit
+ * less two samples over the 9.5 bits up to the middle of the stop bit. Half
+ * of that is left to this end, the host has the other half.
+ */
+
+#ifndef BAUD_H
+#define BAUD_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Samples per bit, without and with the HSE bit. */
+#define BAUD_OVERSAMPLE          16
+#define BAUD_OVERSAMPLE_HSE      8
+
+/* Start bit, 8 data bits and the stop bit. */
+#define BAUD_FRAME_BITS          10
+
+/* Largest error in ppm left to this end at an oversampling: (1/2 - 2/oversample) / 9.5 bits / 2 ends. */
+#define BAUD_TOLERANCE_PPM(ui32Oversample)   \
+    ((500000 - (2000000 / (ui32Oversample))) / (2 * BAUD_FRAME_BITS - 1))
+
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    uint32_t ui32Baud;          /* Asked for. */
+    uint32_t ui32Actual;        /* What the divisor gives. */
+    int32_t i32ErrorPpm;        /* Of ui32Actual against ui32Baud. */
+    uint32_t ui32TolerancePpm;  /* Largest error allowed at the oversampling used. */
+    uint16_t ui16Integer;       /* UARTIBRD. */
+    uint8_t ui8Fraction;        /* UARTFBRD, in 64ths. */
+    bool bHighSpeed;            /* HSE set, sampled 8 times a bit. */
+} Baud_Setting;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Divisor of ui32Baud at ui32ClockHz, as UARTConfigSetExpClk() sets it. Returns false if the divisor
+ * is out of range, or its error past the tolerance, psSetting is filled in anyway. */
+bool Baud_compute (uint32_t ui32ClockHz, uint32_t ui32Baud, Baud_Setting *psSetting);
+
+/* Fastest rate of the table up to ui32Max that Baud_compute() accepts at ui32ClockHz, 0 if none. */
+uint32_t Baud_fastest (uint32_t ui32ClockHz, uint32_t ui32Max);
+
+#endif /* BAUD_H */
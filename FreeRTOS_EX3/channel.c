@@ -0,0 +1,103 @@
+/*
+ * Notification channels, a lighter replacement for binary semaphores
+ * that only ever have one task waiting on them. A channel is one index
+ * of the notification array of the task that takes it, so it costs no
+ * heap and no queue, and giving it is a single notification.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Header Files Includes.  */
+#include "channel.h"
+
+/* FreeRTOS includes. */
+#include "semphr.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* The DWT cycle counter, the run time stats are off in this project so it is started here. */
+#define CHANNEL_DEMCR              (*((volatile uint32_t *) 0xE000EDFC))
+#define CHANNEL_DEMCR_TRCENA       0x01000000
+#define CHANNEL_DWT_CTRL           (*((volatile uint32_t *) 0xE0001000))
+#define CHANNEL_DWT_CTRL_CYCCNTENA 0x00000001
+#define CHANNEL_DWT_CYCCNT         (*((volatile uint32_t *) 0xE0001004))
+
+/*****************************************************************************/
+/*                                 Main Functions                            */
+/*****************************************************************************/
+
+void Channel_Init (Channel_t *pxChannel, TaskHandle_t xTask, UBaseType_t uxIndex)
+{
+    configASSERT (xTask != NULL);
+    configASSERT ((uxIndex >= CHANNEL_FIRST_INDEX) && (uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES));
+
+    pxChannel->uxIndex = uxIndex;
+    pxChannel->xTask = xTask;
+}
+
+void Channel_Give (const Channel_t *pxChannel)
+{
+    /* The count is cleared by Channel_Take(), so giving it many times still counts as one. */
+    xTaskNotifyGiveIndexed (pxChannel->xTask, pxChannel->uxIndex);
+}
+
+void Channel_GiveFromISR (const Channel_t *pxChannel, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    /* The interrupt can come before main() got the task handle. */
+    if (pxChannel->xTask != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR (pxChannel->xTask, pxChannel->uxIndex, pxHigherPriorityTaskWoken);
+    }
+}
+
+bool Channel_Take (const Channel_t *pxChannel, TickType_t xTicksToWait)
+{
+    /* Only the task the notification index belongs to can wait on it. */
+    configASSERT (pxChannel->xTask == xTaskGetCurrentTaskHandle ());
+
+    /* Clear the count on exit, so the channel behaves as a binary semaphore. */
+    return (ulTaskNotifyTakeIndexed (pxChannel->uxIndex, pdTRUE, xTicksToWait) != 0);
+}
+
+void Channel_Bench (UBaseType_t uxIndex, uint32_t ui32Rounds, Channel_BenchResult *psResult)
+{
+    Channel_t xChannel;
+    SemaphoreHandle_t xSemaphore;
+    uint32_t ui32Start;
+    uint32_t i;
+
+    CHANNEL_DEMCR |= CHANNEL_DEMCR_TRCENA;
+    CHANNEL_DWT_CTRL |= CHANNEL_DWT_CTRL_CYCCNTENA;
+
+    /* Neither wait, the take always finds what the give before it gave. */
+    Channel_Init (&xChannel, xTaskGetCurrentTaskHandle (), uxIndex);
+    ui32Start = CHANNEL_DWT_CYCCNT;
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        Channel_Give (&xChannel);
+        Channel_Take (&xChannel, 0);
+    }
+    psResult->ui32ChannelCycles = (CHANNEL_DWT_CYCCNT - ui32Start) / ui32Rounds;
+
+    psResult->ui32SemaphoreCycles = 0;
+    xSemaphore = xSemaphoreCreateBinary ();
+    psResult->bSemaphore = (xSemaphore != NULL);
+    if (xSemaphore == NULL)
+    {
+        return;
+    }
+
+    ui32Start = CHANNEL_DWT_CYCCNT;
+    for (i = 0; i < ui32Rounds; i++)
+    {
+        xSemaphoreGive (xSemaphore);
+        xSemaphoreTake (xSemaphore, 0);
+    }
+    psResult->ui32SemaphoreCycles = (CHANNEL_DWT_CYCCNT - ui32Start) / ui32Rounds;
+
+    vSemaphoreDelete (xSemaphore);
+}
@@ -0,0 +1,72 @@
+/*
+ * Notification channels, a lighter replacement for binary semaphores
+ * that only ever have one task waiting on them. A channel is one index
+ * of the notification array of the task that takes it, so it costs no
+ * heap and no queue, and giving it is a single notification.
+ * Channel_Bench() times one against a binary semaphore.
+ */
+
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Index 0 is left to the plain xTaskNotify API and to the stream and message
+ * buffers, channels use the indexes from 1 to configTASK_NOTIFICATION_ARRAY_ENTRIES - 1. */
+#define CHANNEL_FIRST_INDEX    1
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+/* The task that takes the channel, and the notification index it waits on. */
+typedef struct
+{
+    TaskHandle_t xTask;
+    UBaseType_t uxIndex;
+} Channel_t;
+
+/* Average cycles of a give and of a take that finds it given, of a channel and of a binary semaphore. */
+typedef struct
+{
+    uint32_t ui32ChannelCycles;
+    uint32_t ui32SemaphoreCycles;
+    /* Whether the heap had room for the semaphore, the cycles of the semaphore are 0 if not. */
+    bool bSemaphore;
+} Channel_BenchResult;
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Tie the channel to the task that will take it, and to one of its notification indexes. */
+void Channel_Init (Channel_t *pxChannel, TaskHandle_t xTask, UBaseType_t uxIndex);
+
+/* Same as xSemaphoreGive() on a binary semaphore, giving an already given channel does nothing. */
+void Channel_Give (const Channel_t *pxChannel);
+
+/* Same as xSemaphoreGiveFromISR(), a channel that is not initialised yet is ignored. */
+void Channel_GiveFromISR (const Channel_t *pxChannel, BaseType_t *pxHigherPriorityTaskWoken);
+
+/* Same as xSemaphoreTake(), can only be called by the task the channel is tied to. */
+bool Channel_Take (const Channel_t *pxChannel, TickType_t xTicksToWait);
+
+/* Give and take ui32Rounds times a channel of the calling task at uxIndex, which nothing else may use,
+ * then a binary semaphore created for the time of it, timed with the DWT cycle counter. */
+void Channel_Bench (UBaseType_t uxIndex, uint32_t ui32Rounds, Channel_BenchResult *psResult);
+
+#endif /* CHANNEL_H */
@@ -12,6 +12,9 @@
 #include <stdbool.h>
 
 /* Header Files Includes.  */
+#include "clock.h"
+#include "channel.h"
+#include "vectors.h"
 
 
 /* TivaWare includes.  */
@@ -21,13 +24,13 @@
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
 #include "driverlib/uart.h"
+#include "driverlib/interrupt.h"
+#include "inc/hw_ints.h"
 #include "utils/uartstdio.h"
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
-#include "semphr.h"
 
 /* Main Code #defines */
 #define PINS     GPIO_PIN_0
@@ -41,8 +44,13 @@
 #define STACK_SIZE_TASK_1 200
 #define STACK_SIZE_TASK_2 200
 
-/* Semaphore used to synchronize turning LEDS ON and OFF. */
-SemaphoreHandle_t xBinarySemaphore;
+/* Notification index the LED tasks wait on, and the one LED_ON_Task times a channel on. */
+#define CHANNEL_LED       CHANNEL_FIRST_INDEX
+#define CHANNEL_BENCH     (CHANNEL_FIRST_INDEX + 1)
+#define BENCH_ROUNDS      1000
+
+/* Channels used to synchronize turning LEDS ON and OFF, the turn is passed from one task to the other. */
+Channel_t xLedOnChannel, xLedOffChannel;
 
 /* Handles for the tasks. */
 TaskHandle_t First_Handle, Second_Handle;
@@ -61,6 +69,7 @@ void GPIOFIntHandler (void);
 /*****************************************************************************/
 void UART_receiveString (uint32_t ui32Base, uint8_t *Str);
 void UART_sendString (uint32_t ui32Base, const uint8_t *Str);
+void UART_sendNumber (uint32_t ui32Base, uint32_t ui32Number);
 
 void PORTF_Init (void)
 {
@@ -79,8 +88,15 @@ void PORTF_Init (void)
     GPIOPadConfigSet(GPIO_PORTF_BASE, PINS, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
     /* Enable interrupt on the enable pins. */
     GPIOIntEnable(GPIO_PORTF_BASE, PINS);
+#if (VECTORS_RUNTIME_REGISTER == 1)
     /* Determine which Interrupt Handler to use upon Interrupt. */
     GPIOIntRegister(GPIO_PORTF_BASE, GPIOFIntHandler);
+#else
+    /* GPIOFIntHandler is already in the flash vector table, see vectors.h, so only enable the interrupt. */
+    IntEnable(INT_GPIOF);
+#endif
+    /* The handler gives a channel, so it must not be more urgent than configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+    IntPrioritySet(INT_GPIOF, configMAX_SYSCALL_INTERRUPT_PRIORITY);
     /* Determine Interrupt to occur on falling edge. */
     GPIOIntTypeSet(GPIO_PORTF_BASE, PINS, GPIO_FALLING_EDGE);
     /* Enable Interrupts for both pins (PF0, PF4). */
@@ -103,7 +119,7 @@ void UART0_Init (void)
     GPIOPinTypeUART  (GPIO_PORTA_BASE, PINS);
     /* Initialize the UART, by choosing UART0, baud rate as 128000,
      * 8 bits mode, 1 stop bit, and no parity bit. */
-    UARTConfigSetExpClk (UART0_BASE, SysCtlClockGet(), 128000, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |UART_CONFIG_PAR_NONE));
+    Clock_UARTConfigSet (UART0_BASE, 128000, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |UART_CONFIG_PAR_NONE));
     /* Finalize the initialization process by enabling the module to transmit and receive FIFOs. / */
     UARTEnable(UART0_BASE);
 }
@@ -111,9 +127,11 @@ void UART0_Init (void)
 void GPIOFIntHandler ()
 {
     volatile uint32_t status = GPIOIntStatus(GPIO_PORTF_BASE, true);
-    UART_sendString (UART0_BASE, "Semaphore is given. \n\r");
-    xSemaphoreGiveFromISR(xBinarySemaphore, (TickType_t) 0);
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UART_sendString (UART0_BASE, "Channel is given. \n\r");
+    Channel_GiveFromISR(&xLedOnChannel, &xHigherPriorityTaskWoken);
     GPIOIntClear(GPIO_PORTF_BASE, status);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 /*******************************************************************************
  *                            UART Functions Prototypes                        *
@@ -164,18 +182,45 @@ void UART_sendString(uint32_t ui32Base, const uint8_t *Str)
     }
 }
 
+void UART_sendNumber(uint32_t ui32Base, uint32_t ui32Number)
+{
+    /* The digits come out last first, so they are sent from the end of the buffer. */
+    uint8_t Digits[11];
+    uint8_t i = sizeof (Digits) - 1;
+
+    Digits[i] = '\0';
+    do
+    {
+        i--;
+        Digits[i] = '0' + (ui32Number % 10);
+        ui32Number /= 10;
+    } while (ui32Number != 0);
+
+    UART_sendString (ui32Base, &Digits[i]);
+}
+
 /*****************************************************************************/
 /*                              Task Definition                             */
 /*****************************************************************************/
 
 void LED_ON_Task (void *pvParameters)
 {
+    Channel_BenchResult xBench;
+
+    /* Time a channel against the binary semaphore it replaces, once, before the LEDs start. */
+    Channel_Bench (CHANNEL_BENCH, BENCH_ROUNDS, &xBench);
+    UART_sendString (UART0_BASE, "Give and take cycles channel/binary semaphore ");
+    UART_sendNumber (UART0_BASE, xBench.ui32ChannelCycles);
+    UART_sendString (UART0_BASE, "/");
+    UART_sendNumber (UART0_BASE, xBench.ui32SemaphoreCycles);
+    UART_sendString (UART0_BASE, (xBench.bSemaphore == true) ? " \n\r" : ", no heap for the semaphore \n\r");
+
     while (1)
     {
-        xSemaphoreTake(xBinarySemaphore, portMAX_DELAY);
+        Channel_Take(&xLedOnChannel, portMAX_DELAY);
         UART_sendString (UART0_BASE, "Inside LED_ON_Task. \n\r");
         GPIOPinWrite(GPIO_PORTF_BASE, LEDS, BLUE);
-        xSemaphoreGive(xBinarySemaphore);
+        Channel_Give(&xLedOffChannel);
         vTaskDelay(pdMS_TO_TICKS(500));
     }
 }
@@ -183,10 +228,10 @@ void LED_OFF_TASK (void *pvParameters)
 {
     while (1)
     {
-        xSemaphoreTake(xBinarySemaphore, portMAX_DELAY);
+        Channel_Take(&xLedOffChannel, portMAX_DELAY);
         UART_sendString (UART0_BASE, "Inside LED_OFF_Task. \n\r");
         GPIOPinWrite(GPIO_PORTF_BASE, LEDS, LEDS_OFF);
-        xSemaphoreGive(xBinarySemaphore);
+        Channel_Give(&xLedOnChannel);
         vTaskDelay(pdMS_TO_TICKS(500));
     }
 }
@@ -197,8 +242,8 @@ void LED_OFF_TASK (void *pvParameters)
 
 int main (void)
 {
-    /* Enable Clock of MCU with no Pre-Scalar, use OSC, main oscillator source, 16MHz external crystal frequency*/
-    SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    /* Initialize Clock with 80 Mhz from the PLL, the kernel tick and the UART divisors are derived from it. */
+    Clock_Init ();
 
     /* Initialize PORTF through PINS PF1, PF2 and PF3 to be used as LEDS. */
     PORTF_Init ();
@@ -206,18 +251,24 @@ int main (void)
     /* Initialize UART0 through PINS PA0 and PA2 as Rx and Tx. / */
     UART0_Init ();
 
-    /* Create a Semaphore to allow proper synchronization between two tasks. */
-    xBinarySemaphore = xSemaphoreCreateBinary();
-
-    if( xSemaphoreGive( xBinarySemaphore ) != pdTRUE )
+    /* Make sure the clock the tick and the baud rate were computed from is the one actually running. */
+    if (Clock_verify () == false)
     {
-        UART_sendString (UART0_BASE, "Failed to Give Semaphore. \n\r");
+        UART_sendString (UART0_BASE, "The system clock could not be verified at 80 MHz, timing may be inaccurate. \n\r");
     }
 
     /* Create Tasks that receives, filters, then, sets the specific needed LEDS. */
     xTaskCreate(LED_ON_Task,  "LED_ON_TASK" , STACK_SIZE_TASK_1, NULL, 1, &First_Handle);
     xTaskCreate(LED_OFF_TASK, "LED_OFF_TASK", STACK_SIZE_TASK_2, NULL, 1, &Second_Handle);
 
+    /* Create a channel for each task to allow proper synchronization between them,
+     * they are part of the tasks themselves so nothing is allocated for them. */
+    Channel_Init(&xLedOnChannel,  First_Handle,  CHANNEL_LED);
+    Channel_Init(&xLedOffChannel, Second_Handle, CHANNEL_LED);
+
+    /* The LED_ON task has the first turn. */
+    Channel_Give(&xLedOnChannel);
+
     vTaskStartScheduler();
 
     while (1)
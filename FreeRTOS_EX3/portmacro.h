@@ -76,6 +76,32 @@
     #define portBYTE_ALIGNMENT    8
 /*-----------------------------------------------------------*/
 
+/* Compiler specifics.  The port is written against the TI compiler
+ * intrinsics, when it is built with GCC instead (see gcc/Makefile) these stand
+ * in for them. */
+    #ifndef __TI_ARM__
+        static inline __attribute__( ( always_inline ) ) uint32_t _set_interrupt_priority( uint32_t ulNewMaskValue )
+        {
+            uint32_t ulOriginalBASEPRI;
+
+            __asm volatile
+            (
+                "	mrs %0, basepri	\n"
+                "	msr basepri, %1	\n"
+                : "=&r" ( ulOriginalBASEPRI ) : "r" ( ulNewMaskValue ) : "memory"
+            );
+
+            return ulOriginalBASEPRI;
+        }
+
+        #define __clz( x )          __builtin_clz( x )
+
+/* vTaskSwitchContext() is only called from the assembly of
+ * xPortPendSVHandler(), keep link time optimisation from removing it. */
+        #define portDONT_DISCARD    __attribute__( ( used ) )
+    #endif /* __TI_ARM__ */
+/*-----------------------------------------------------------*/
+
 /* Scheduler utilities. */
     #define portYIELD()                                 \
     {                                                   \
@@ -133,6 +159,10 @@
     #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    _set_interrupt_priority( x )
 /*-----------------------------------------------------------*/
 
+/* Recompute the SysTick reload after the core clock frequency has changed. */
+    extern void vPortRetuneTimerInterrupt( void );
+/*-----------------------------------------------------------*/
+
 /* Tickless idle/low power functionality. */
     #ifndef portSUPPRESS_TICKS_AND_SLEEP
         extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
@@ -141,6 +171,29 @@
 
 /*-----------------------------------------------------------*/
 
+/* Per task FPU attributes.  A task that never uses the FPU can drop its
+ * floating point access so it cannot accidentally acquire a floating point
+ * context (it takes a usage fault instead), which keeps its context switches
+ * free of the s16-s31 save and restore.  The attribute values are the CP10 and
+ * CP11 access bits of the CPACR.
+ *
+ * The CPACR is not switched on exception entry, so an interrupt that comes in
+ * while a task without FPU access runs has none either.  Such an interrupt
+ * handler must not use the FPU, not even through a function it calls: its
+ * first floating point instruction raises a NOCP UsageFault.  Handlers that
+ * need floats can only be used with every task keeping its FPU access. */
+    #define portFPU_ATTRIBUTE_NONE    ( 0x00000000UL )
+    #define portFPU_ATTRIBUTE_FULL    ( 0x00f00000UL )
+
+    extern void vPortTaskSetFPUAttribute( uint32_t ulAttribute );
+    extern void vPortResetFPUContext( void );
+
+    #define portTASK_USES_FLOATING_POINT()             vPortTaskSetFPUAttribute( portFPU_ATTRIBUTE_FULL )
+    #define portTASK_DOES_NOT_USE_FLOATING_POINT()     vPortTaskSetFPUAttribute( portFPU_ATTRIBUTE_NONE )
+    #define portRESET_FPU_CONTEXT()                    vPortResetFPUContext()
+
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
  * not necessary for to use this port.  They are defined so the common demo files
  * (which build with all the ports) will build. */
@@ -156,6 +209,11 @@
 /* portNOP() is not required by this port. */
     #define portNOP()
 
+/* The functions on the context switch, tick and receive interrupt paths are
+ * linked into .hot_text, so the linker command file can run them from SRAM
+ * instead of from flash, which needs wait states at 80 MHz. */
+    #define portHOT_FUNCTION    __attribute__( ( section( ".hot_text" ) ) )
+
 /*-----------------------------------------------------------*/
 
     #ifdef __cplusplus
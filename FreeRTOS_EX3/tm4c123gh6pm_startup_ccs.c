@@ -24,6 +24,8 @@
 
 #include <stdint.h>
 
+#include "vectors.h"
+
 //*****************************************************************************
 //
 // Forward declaration of the default fault handlers.
@@ -54,11 +56,14 @@ extern uint32_t __STACK_TOP;
 
 //*****************************************************************************
 //
-// External declarations for the interrupt handlers used by the application.
+// External declarations for the interrupt handlers used by the application,
+// one for each VECTOR() of vectors.h.
 //
 //*****************************************************************************
-// To be added by user
-extern void GPIOFIntHandler (void);
+#define VECTOR_DECLARE(ui32Interrupt, pfnHandler)                             \
+    extern void pfnHandler(void);
+VECTORS(VECTOR_DECLARE)
+
 //*****************************************************************************
 //
 // The vector table.  Note that the proper constructs must be placed on this to
@@ -116,7 +121,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // Analog Comparator 2
     IntDefaultHandler,                      // System Control (PLL, OSC, BO)
     IntDefaultHandler,                      // FLASH Control
-    GPIOFIntHandler,                      // GPIO Port F
+    IntDefaultHandler,                      // GPIO Port F
     IntDefaultHandler,                      // GPIO Port G
     IntDefaultHandler,                      // GPIO Port H
     IntDefaultHandler,                      // UART2 Rx and Tx
@@ -224,7 +229,16 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // PWM 1 Generator 1
     IntDefaultHandler,                      // PWM 1 Generator 2
     IntDefaultHandler,                      // PWM 1 Generator 3
-    IntDefaultHandler                       // PWM 1 Fault
+    IntDefaultHandler,                      // PWM 1 Fault
+
+    //
+    // The handlers of vectors.h, each one replaces the default handler in the
+    // slot of its interrupt number above, so they are bound at compile time
+    // and nothing has to be copied to the SRAM table of IntRegister().
+    //
+#define VECTOR_BIND(ui32Interrupt, pfnHandler)                                \
+    [ui32Interrupt] = pfnHandler,
+    VECTORS(VECTOR_BIND)
 };
 
 //*****************************************************************************
@@ -0,0 +1,44 @@
+#ifndef LOWPOWER_H
+#define LOWPOWER_H
+
+/* Needed Header Files. */
+#include <stdint.h>
+
+/* Wake sources that are counted separately. */
+#define WAKE_GPIOF      0
+#define WAKE_TIMER      1
+#define WAKE_SOURCES    2
+
+/* Number of times every wake source woke the core up. */
+extern volatile uint32_t WakeCount [WAKE_SOURCES];
+
+/* Cycles from entering an interrupt handler to its visible action (the LED write), last and worst case.
+   Only measured on the board, read them from the debugger: make qemu does not build this example as it
+   uses clock gating registers the LM3S6965 does not have, QEMU cannot press a switch while the core runs,
+   and its cycle counter does not count the cycles of a wake up or of an interrupt entry. */
+extern volatile uint32_t LatencyLast;
+extern volatile uint32_t LatencyMax;
+
+/* Start the DWT cycle counter and Timer0, which together measure the time spent awake and asleep. */
+void LowPower_Init (void);
+
+/* Sleep until the next interrupt, then return to the main loop. */
+void LowPower_Sleep (void);
+
+/* Let the interrupt handlers do all the work, the core goes back to sleep every time one of them returns. */
+void LowPower_SleepOnExit (void);
+
+/* To be called first thing in an interrupt handler that can wake the core up. */
+void LowPower_Wake (uint8_t Source);
+
+/* To be called right after the handler did what the user sees, e.g. wrote the LEDS. */
+void LowPower_Action (void);
+
+/* To be called last thing in the interrupt handler. */
+void LowPower_Done (void);
+
+/* Cycles spent awake and asleep since LowPower_Init. */
+uint64_t LowPower_AwakeCycles (void);
+uint64_t LowPower_AsleepCycles (void);
+
+#endif
@@ -1,6 +1,7 @@
 /* Needed Header Files. */
 #include <stdint.h>
 #include "tm4c123gh6pm.h"
+#include "lowpower.h"
 
 /* Needed #defines. */
 #define OFF       0x00
@@ -8,6 +9,9 @@
 #define BLUE      0x04
 #define GREEN     0x08
 
+/* Set to 1 to let the core sleep straight out of the interrupt handler, or 0 to return to a WFI main loop. */
+#define SLEEP_ON_EXIT 1
+
 /* This is a needed function declaration related to the startup code. */
 void SystemInit () {}
 	
@@ -47,36 +51,75 @@ void Init_PORTF ()
 	GPIO_PORTF_PUR_R = 0x11;
 }
 
+void Init_PORTF_Interrupt ()
+{
+	/* Both switches interrupt on both edges, as the LEDS follow the switches while they are held. */
+	GPIO_PORTF_IS_R  &= ~0x11;
+	GPIO_PORTF_IBE_R |= 0x11;
+
+	/* clear any prior interrupt, and then unmask the interrupt of both switches. */
+	GPIO_PORTF_ICR_R = 0x11;
+	GPIO_PORTF_IM_R |= 0x11;
+
+	/* enable interrupt in NVIC and set priority to 5 */
+	NVIC_PRI7_R = ((NVIC_PRI7_R & 0xFF00FFFF) | 0x00A00000);
+	NVIC_EN0_R = 0x40000000;
+}
+
+/* Update the LEDS every time a switch is pressed or released, the core sleeps the rest of the time. */
+void GPIOF_Handler (void)
+{
+	LowPower_Wake (WAKE_GPIOF);
+
+	/* clear the interrupt flags first, so an edge that comes while we are here is not lost. */
+	GPIO_PORTF_ICR_R = 0x11;
+
+	/* if SW1 is pressed only. */
+	if ((GPIO_PORTF_DATA_R & 0x11) == 0x01)
+	{
+		/* Turn on the RED LED only. */
+		GPIO_PORTF_DATA_R = RED;
+	}
+	/* if SW2 is pressed only. */
+	else if ((GPIO_PORTF_DATA_R & 0x11) == 0x10)
+	{
+		/* Turn on the BLUE LED only. */
+		GPIO_PORTF_DATA_R = BLUE;
+	}
+	/* if both SW1 and SW2 are pressed together. */
+	else if ((GPIO_PORTF_DATA_R & 0x11) == 0x00)
+	{
+		/* Turn on the GREEN LED only. */
+		GPIO_PORTF_DATA_R = GREEN;
+	}
+	else
+	{
+		/* Turn OFF all LEDS. */
+		GPIO_PORTF_DATA_R = OFF;
+	}
+
+	LowPower_Action ();
+	LowPower_Done ();
+}
+
 int main(void)
 {
 	/* Initialize the Input and Output pins in PORTF. */
 	Init_PORTF ();
-	
+
+	/* Start measuring the time spent awake and asleep. */
+	LowPower_Init ();
+
+	/* The switches are only looked at when one of them changes. */
+	Init_PORTF_Interrupt ();
+
+#if SLEEP_ON_EXIT
+	LowPower_SleepOnExit ();
+#else
 	while (1)
 	{
-		/* if SW1 is pressed only. */
-		if ((GPIO_PORTF_DATA_R & 0x11) == 0x01)
-		{
-			/* Turn on the RED LED only. */
-			GPIO_PORTF_DATA_R = RED;
-		}
-		/* if SW2 is pressed only. */
-		else if ((GPIO_PORTF_DATA_R & 0x11) == 0x10)
-		{
-		  /* Turn on the BLUE LED only. */
-			GPIO_PORTF_DATA_R = BLUE;
-		}
-		/* if both SW1 and SW2 are pressed together. */
-		else if ((GPIO_PORTF_DATA_R & 0x11) == 0x00)
-		{
-		  /* Turn on the GREEN LED only. */
-			GPIO_PORTF_DATA_R = GREEN;
-		}
-		else
-		{
-			/* Turn OFF all LEDS. */
-			GPIO_PORTF_DATA_R = OFF;
-		}
+		/* Nothing to do in the main loop, every change is handled in GPIOF_Handler. */
+		LowPower_Sleep ();
 	}
+#endif
 }
-
@@ -0,0 +1,155 @@
+/* Needed Header Files. */
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "lowpower.h"
+
+/* The DWT registers are not part of tm4c123gh6pm.h. */
+#define DWT_CTRL_R          (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT_R        (*((volatile uint32_t *)0xE0001004))
+#define DWT_CTRL_CYCCNTENA  0x00000001
+#define DEMCR_TRCENA        0x01000000
+
+/* Timer0 A is interrupt number 19. */
+#define TIMER0A_INT_BIT     (1<<19)
+
+volatile uint32_t WakeCount [WAKE_SOURCES];
+volatile uint32_t LatencyLast = 0;
+volatile uint32_t LatencyMax = 0;
+
+/* The cycle counter only runs while the core is awake, it is folded in here every time Timer0 wraps
+   so it can never wrap by itself. */
+static volatile uint64_t AwakeCycles = 0;
+
+/* Timer0 keeps counting while the core sleeps, the sleep periods are measured with it. */
+static volatile uint64_t AsleepCycles = 0;
+static volatile uint32_t SleepStart = 0;
+static volatile uint8_t  Asleep = 0;
+
+/* Cycle count when the current interrupt handler was entered. */
+static volatile uint32_t WakeStamp = 0;
+
+void LowPower_Init (void)
+{
+	/* create a dummy variable in order to provide delay till the clock is provided. */
+	volatile uint32_t delay;
+
+	/* Enable the trace block, then start the cycle counter from ZERO. */
+	NVIC_DBG_INT_R |= DEMCR_TRCENA;
+	DWT_CYCCNT_R = 0;
+	DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+
+	/* provide clock to Timer0, also in sleep mode in case automatic clock gating is turned on. */
+	SYSCTL_RCGCTIMER_R |= SYSCTL_RCGCTIMER_R0;
+	SYSCTL_SCGCTIMER_R |= SYSCTL_SCGCTIMER_S0;
+
+	/* the required delay so that no change would occur untill the clock is set. */
+	delay = 1;
+
+	/* Timer0 is a free running 32 bit up counter, it interrupts only when it wraps, every 268 seconds at 16 MHz. */
+	TIMER0_CTL_R   = 0;
+	TIMER0_CFG_R   = TIMER_CFG_32_BIT_TIMER;
+	TIMER0_TAMR_R  = TIMER_TAMR_TAMR_PERIOD | TIMER_TAMR_TACDIR;
+	TIMER0_TAILR_R = 0xFFFFFFFF;
+	TIMER0_ICR_R   = TIMER_ICR_TATOCINT;
+	TIMER0_IMR_R   = TIMER_IMR_TATOIM;
+
+	/* Lowest priority 7, so it never delays the button interrupts. */
+	NVIC_PRI4_R = (NVIC_PRI4_R & 0x1FFFFFFF) | 0xE0000000;
+	NVIC_EN0_R = TIMER0A_INT_BIT;
+
+	TIMER0_CTL_R = TIMER_CTL_TAEN;
+}
+
+void LowPower_Sleep (void)
+{
+	/* Interrupts are masked so the one that wakes us up runs only after the sleep start is recorded,
+	   a pending interrupt still wakes the core up even though it is masked. */
+	__disable_irq ();
+	SleepStart = TIMER0_TAV_R;
+	Asleep = 1;
+	__wfi ();
+	__enable_irq ();
+}
+
+void LowPower_SleepOnExit (void)
+{
+	SleepStart = TIMER0_TAV_R;
+	Asleep = 1;
+
+	/* From now on the core only wakes up to run interrupt handlers, and goes back to sleep when they return. */
+	NVIC_SYS_CTRL_R |= NVIC_SYS_CTRL_SLEEPEXIT;
+
+	while (1)
+	{
+		__wfi ();
+	}
+}
+
+void LowPower_Wake (uint8_t Source)
+{
+	uint32_t Now = TIMER0_TAV_R;
+
+	WakeStamp = DWT_CYCCNT_R;
+	WakeCount[Source]++;
+
+	if (Asleep)
+	{
+		/* Timer0 wakes us up every time it wraps, so a sleep period always fits in 32 bits. */
+		AsleepCycles += Now - SleepStart;
+		Asleep = 0;
+	}
+}
+
+void LowPower_Action (void)
+{
+	LatencyLast = DWT_CYCCNT_R - WakeStamp;
+
+	if (LatencyLast > LatencyMax)
+	{
+		LatencyMax = LatencyLast;
+	}
+}
+
+void LowPower_Done (void)
+{
+	/* With sleep on exit, the core goes back to sleep as soon as this handler returns. */
+	if (NVIC_SYS_CTRL_R & NVIC_SYS_CTRL_SLEEPEXIT)
+	{
+		SleepStart = TIMER0_TAV_R;
+		Asleep = 1;
+	}
+}
+
+uint64_t LowPower_AwakeCycles (void)
+{
+	uint64_t Cycles;
+
+	__disable_irq ();
+	Cycles = AwakeCycles + DWT_CYCCNT_R;
+	__enable_irq ();
+
+	return Cycles;
+}
+
+uint64_t LowPower_AsleepCycles (void)
+{
+	uint64_t Cycles;
+
+	__disable_irq ();
+	Cycles = AsleepCycles;
+	__enable_irq ();
+
+	return Cycles;
+}
+
+/* Timer0 wrapped around, fold the cycle counter into the total before it can wrap as well. */
+void TIMER0A_Handler (void)
+{
+	LowPower_Wake (WAKE_TIMER);
+
+	TIMER0_ICR_R = TIMER_ICR_TATOCINT;
+	AwakeCycles += DWT_CYCCNT_R;
+	DWT_CYCCNT_R = 0;
+
+	LowPower_Done ();
+}
@@ -1,6 +1,7 @@
 /* Needed Header Files. */
 #include <stdint.h>
 #include "tm4c123gh6pm.h"
+#include "lowpower.h"
 
 /* Needed #defines. */
 #define OFF       0x00
@@ -8,6 +9,9 @@
 #define BLUE      0x04
 #define GREEN     0x08
 
+/* Set to 1 to let the core sleep straight out of the interrupt handler, or 0 to return to a WFI main loop. */
+#define SLEEP_ON_EXIT 1
+
 /* This is a needed function declaration related to the startup code. */
 void SystemInit () {}
 	
@@ -63,24 +67,39 @@ int main(void)
 		NVIC_PRI7_R = ((NVIC_PRI7_R & 0xFF00FFFF) | 0x00A00000);
 		NVIC_EN0_R = 0x40000000;
     
+    /* Start measuring the time spent awake and asleep. */
+    LowPower_Init ();
+
+#if SLEEP_ON_EXIT
+    /* do nothing and sleep, the core only wakes up to run the interrupt handler. */
+    LowPower_SleepOnExit ();
+#else
     while(1)
     {
-			// do nothing and wait for the interrupt to occur
+			/* do nothing and sleep untill the interrupt occurs. */
+			LowPower_Sleep ();
     }
+#endif
 }
 
 /* SW1 is connected to PF4 pin, SW2 is connected to PF0. */
 /* Both of them trigger PORTF falling edge interrupt */
 void GPIOF_Handler(void)
 {	
+  LowPower_Wake (WAKE_GPIOF);
+
   if (GPIO_PORTF_MIS_R & 0x10) /* check if interrupt causes by PF4/SW1*/
     {   
       GPIO_PORTF_DATA_R |= (1<<3);
+      LowPower_Action ();
       GPIO_PORTF_ICR_R |= 0x10; /* clear the interrupt flag */
      } 
     else if (GPIO_PORTF_MIS_R & 0x01) /* check if interrupt causes by PF0/SW2 */
     {   
      GPIO_PORTF_DATA_R &= ~0x08;
+     LowPower_Action ();
      GPIO_PORTF_ICR_R |= 0x01; /* clear the interrupt flag */
     }
+
+  LowPower_Done ();
 }
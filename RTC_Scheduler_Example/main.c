@@ -0,0 +1,248 @@
+/*
+ * Use UART0 to PC Communication to control LEDs, the same application as the FreeRTOS project,
+ * but on a single stack run-to-completion scheduler (see scheduler.h) instead of the kernel.
+ *
+ * Benchmark against the FreeRTOS project, both print their measurements when l is entered:
+ *  - Latency: cycles from the character being read to the LED write, last and worst case.
+ *    Both read it in the UART interrupt, the FreeRTOS project then passes it to its task through
+ *    a lock-free ring, or through a queue when built with RX_USE_RING set to 0.
+ *  - RAM: the whole application runs on the 512 byte stack of startup_TM4C123.s plus the task
+ *    queues printed here, the FreeRTOS project prints what its tasks took from the heap.
+ *  - Flash: the Code and RO Data totals at the end of RTC_1.map, against the .text and .const
+ *    totals in FreeRTOS/Debug/FreeRTOS.map.
+ */
+
+/* Needed Header Files. */
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "scheduler.h"
+
+/* Needed #defines. */
+#define LEDS      0x0E
+#define OFF       0x00
+#define RED       0x02
+#define BLUE      0x04
+#define GREEN     0x08
+
+/* The MCU runs from the 16 MHz internal oscillator, which divides exactly to 128000 baud: 16 MHz / (16 * 128000) = 7 + 52/64. */
+#define UART_IBRD 7
+#define UART_FBRD 52
+
+/* The tasks are tied to the interrupts of the CAN modules, which are not used here. */
+#define IRQ_UART0           5
+#define IRQ_TASK_UART       39
+#define IRQ_TASK_LEDS       40
+
+/* The UART interrupt comes first, then the tasks in the same order as in the FreeRTOS project. */
+#define PRIORITY_UART0      1
+#define PRIORITY_TASK_UART  2
+#define PRIORITY_TASK_LEDS  3
+
+/* The DWT registers are not part of tm4c123gh6pm.h. */
+#define DWT_CTRL_R          (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT_R        (*((volatile uint32_t *)0xE0001004))
+#define DWT_CTRL_CYCCNTENA  0x00000001
+#define DEMCR_TRCENA        0x01000000
+
+/* This is a needed function declaration related to the startup code. */
+void SystemInit () {}
+
+/* The two tasks of the application. */
+static Sched_Task Task_Uart;
+static Sched_Task Task_Leds;
+
+/* Cycle count when the last character was read, and how long it took until the LEDS changed. */
+static volatile uint32_t EventStamp = 0;
+static volatile uint32_t LatencyLast = 0;
+static volatile uint32_t LatencyMax = 0;
+
+void Init_PORTF ()
+{
+	/* create a dummy variable in order to provide delay till the clock is provided. */
+	volatile uint32_t delay;
+
+	/* provide clock to the port. */
+	SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R5;
+
+	/* the required delay so that no change would occur untill the clock is set. */
+	delay = 1;
+
+	/* Declare PF1, PF2 and PF3 as Output Pins, with their digital functions enabled. */
+	GPIO_PORTF_DIR_R |= LEDS;
+	GPIO_PORTF_AMSEL_R &= ~LEDS;
+	GPIO_PORTF_AFSEL_R &= ~LEDS;
+	GPIO_PORTF_DEN_R |= LEDS;
+}
+
+void Init_UART0 ()
+{
+	/* create a dummy variable in order to provide delay till the clock is provided. */
+	volatile uint32_t delay;
+
+	/* provide clock to UART0 and to Port A. */
+	SYSCTL_RCGCUART_R |= SYSCTL_RCGCUART_R0;
+	SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R0;
+
+	/* the required delay so that no change would occur untill the clock is set. */
+	delay = 1;
+
+	/* PA0 is UART0 Rx and PA1 is UART0 Tx. */
+	GPIO_PORTA_AMSEL_R &= ~0x03;
+	GPIO_PORTA_AFSEL_R |= 0x03;
+	GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R & 0xFFFFFF00) | 0x00000011;
+	GPIO_PORTA_DEN_R |= 0x03;
+
+	/* 128000 baud, 8 bits mode, 1 stop bit, no parity bit, with the FIFOs enabled. */
+	UART0_CTL_R = 0;
+	UART0_IBRD_R = UART_IBRD;
+	UART0_FBRD_R = UART_FBRD;
+	UART0_LCRH_R = UART_LCRH_WLEN_8 | UART_LCRH_FEN;
+	UART0_CC_R = 0;
+
+	/* Interrupt when the Rx FIFO fills up, or when a character has been waiting in it for a while. */
+	UART0_ICR_R = UART_ICR_RXIC | UART_ICR_RTIC;
+	UART0_IM_R = UART_IM_RXIM | UART_IM_RTIM;
+	NVIC_PRI1_R = (NVIC_PRI1_R & 0xFFFF00FF) | (PRIORITY_UART0 << 13);
+	NVIC_EN0_R = 1 << IRQ_UART0;
+
+	UART0_CTL_R = UART_CTL_UARTEN | UART_CTL_TXE | UART_CTL_RXE;
+}
+
+/*****************************************************************************/
+/*                                 UART Functions                            */
+/*****************************************************************************/
+
+void UART_sendString (const char *Str)
+{
+	/* Counter Declaration to be used to loop until string is sent. */
+	uint8_t i = 0;
+
+	while (Str[i] != '\0')
+	{
+		/* Wait for room in the Tx FIFO, then send the characters one by one. */
+		while (UART0_FR_R & UART_FR_TXFF) {}
+		UART0_DR_R = Str[i];
+		i++;
+	}
+}
+
+void UART_sendNumber (uint32_t Number)
+{
+	/* Buffer big enough for the 10 digits of the largest 32 bit number and the NULL. */
+	char Digits[11];
+	uint8_t i = 10;
+
+	Digits[i] = '\0';
+
+	/* Fill the digits from the end, so they come out in the right order. */
+	do
+	{
+		i--;
+		Digits[i] = '0' + (Number % 10);
+		Number /= 10;
+	} while (Number != 0);
+
+	UART_sendString (&Digits[i]);
+}
+
+/* Hand every character received to the UART task, the interrupt does nothing else. */
+void UART0_Handler (void)
+{
+	uint32_t Stamp = DWT_CYCCNT_R;
+
+	UART0_ICR_R = UART_ICR_RXIC | UART_ICR_RTIC;
+
+	while ((UART0_FR_R & UART_FR_RXFE) == 0)
+	{
+		/* A character that does not fit in the queue of the UART task is dropped. */
+		EventStamp = Stamp;
+		Sched_Post (&Task_Uart, UART0_DR_R);
+	}
+}
+
+/*****************************************************************************/
+/*                                     Tasks                                 */
+/*****************************************************************************/
+
+/* Same as vTask1 of the FreeRTOS project, it decodes the characters received. */
+void Task_Uart_Handler (uint8_t ReceivedCharacter)
+{
+	switch (ReceivedCharacter)
+	{
+		case 'r':
+		case 'g':
+		case 'b':
+			if (Sched_Post (&Task_Leds, ReceivedCharacter) == 0)
+			{
+				UART_sendString ("The last color preference will be unable to be used. \n\r");
+			}
+			break;
+		case 'l':
+			/* Print the benchmark measurements. */
+			UART_sendString ("Latency cycles last/max ");
+			UART_sendNumber (LatencyLast);
+			UART_sendString ("/");
+			UART_sendNumber (LatencyMax);
+			UART_sendString (", task bytes ");
+			UART_sendNumber (sizeof (Task_Uart) + sizeof (Task_Leds));
+			UART_sendString ("\n\r");
+			break;
+	}
+}
+
+/* Same as vTask2 of the FreeRTOS project, it changes the LEDS. */
+void Task_Leds_Handler (uint8_t Leds_State)
+{
+	uint32_t Latency;
+
+	switch (Leds_State)
+	{
+		case 'r':
+			GPIO_PORTF_DATA_R = (GPIO_PORTF_DATA_R & ~LEDS) | RED;
+			break;
+		case 'b':
+			GPIO_PORTF_DATA_R = (GPIO_PORTF_DATA_R & ~LEDS) | BLUE;
+			break;
+		case 'g':
+			GPIO_PORTF_DATA_R = (GPIO_PORTF_DATA_R & ~LEDS) | GREEN;
+			break;
+	}
+
+	Latency = DWT_CYCCNT_R - EventStamp;
+	LatencyLast = Latency;
+	if (Latency > LatencyMax)
+	{
+		LatencyMax = Latency;
+	}
+}
+
+/* The interrupts the tasks are tied to. */
+void CAN0_Handler (void)
+{
+	Sched_Dispatch (&Task_Uart);
+}
+
+void CAN1_Handler (void)
+{
+	Sched_Dispatch (&Task_Leds);
+}
+
+int main(void)
+{
+	/* Enable the trace block, then start the cycle counter used for the latency. */
+	NVIC_DBG_INT_R |= DEMCR_TRCENA;
+	DWT_CYCCNT_R = 0;
+	DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+
+	Init_PORTF ();
+
+	Sched_Init (&Task_Uart, Task_Uart_Handler, IRQ_TASK_UART, PRIORITY_TASK_UART);
+	Sched_Init (&Task_Leds, Task_Leds_Handler, IRQ_TASK_LEDS, PRIORITY_TASK_LEDS);
+
+	Init_UART0 ();
+
+	UART_sendString ("Please enter r, g or b at any given moment to toggle the LED accordingly, or l for the benchmark: \n\r");
+
+	/* From here on everything happens in the interrupts. */
+	Sched_Run ();
+}
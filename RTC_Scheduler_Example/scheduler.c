@@ -0,0 +1,71 @@
+/* Needed Header Files. */
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+#include "scheduler.h"
+
+/* The NVIC priority registers can be accessed one byte per interrupt, only the top 3 bits are implemented. */
+#define NVIC_PRI_BYTES      ((volatile uint8_t *) &NVIC_PRI0_R)
+#define NVIC_EN_WORDS       ((volatile uint32_t *) &NVIC_EN0_R)
+
+/* The interrupt mask register, so Sched_Post can restore it instead of enabling the interrupts blindly. */
+register uint32_t PRIMASK __asm("primask");
+
+void Sched_Init (Sched_Task *Task, Sched_Handler Handler, uint8_t Irq, uint8_t Priority)
+{
+	Task->Handler = Handler;
+	Task->Irq     = Irq;
+	Task->Head    = 0;
+	Task->Tail    = 0;
+
+	/* Set the priority, then enable the interrupt, it only ever fires when it is triggered by Sched_Post. */
+	NVIC_PRI_BYTES [Irq] = Priority << 5;
+	NVIC_EN_WORDS [Irq >> 5] = 1 << (Irq & 31);
+}
+
+uint8_t Sched_Post (Sched_Task *Task, uint8_t Event)
+{
+	uint32_t Mask;
+	uint8_t Head;
+
+	/* Any task or interrupt can post, so the slot is taken with the interrupts masked. */
+	Mask = PRIMASK;
+	__disable_irq ();
+
+	Head = Task->Head;
+	if (((Head + 1) & (SCHED_EVENTS_MAX - 1)) == Task->Tail)
+	{
+		PRIMASK = Mask;
+		return 0;
+	}
+	Task->Events [Head] = Event;
+	Task->Head = (Head + 1) & (SCHED_EVENTS_MAX - 1);
+
+	PRIMASK = Mask;
+
+	/* Pend the interrupt of the task, it runs as soon as nothing more urgent is running. */
+	NVIC_SW_TRIG_R = Task->Irq;
+
+	return 1;
+}
+
+void Sched_Dispatch (Sched_Task *Task)
+{
+	uint8_t Tail = Task->Tail;
+
+	/* Events posted while the handler runs are picked up by the same loop. */
+	while (Tail != Task->Head)
+	{
+		Task->Handler (Task->Events [Tail]);
+		Tail = (Tail + 1) & (SCHED_EVENTS_MAX - 1);
+		Task->Tail = Tail;
+	}
+}
+
+void Sched_Run (void)
+{
+	while (1)
+	{
+		/* Every task is an interrupt, so there is nothing to check before going to sleep. */
+		__wfi ();
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+/* Needed Header Files. */
+#include <stdint.h>
+
+/* Number of events a task can have waiting, must be a power of 2. */
+#define SCHED_EVENTS_MAX    8
+
+/* Task priorities, the same as the NVIC ones: 0 is the most urgent and 7 the least. */
+#define SCHED_PRIORITY_MAX  0
+#define SCHED_PRIORITY_MIN  7
+
+/* Called once for every event posted to the task, it runs to completion on the one and only stack. */
+typedef void (*Sched_Handler) (uint8_t Event);
+
+/* A task is an interrupt that no peripheral uses, it is triggered from software whenever an event is posted
+   to it, so the NVIC does all the preemption between the tasks and the real interrupts. */
+typedef struct
+{
+	Sched_Handler Handler;
+	uint8_t Irq;
+	/* Head is only written by Sched_Post, and Tail only by Sched_Dispatch. */
+	volatile uint8_t Head;
+	volatile uint8_t Tail;
+	uint8_t Events [SCHED_EVENTS_MAX];
+} Sched_Task;
+
+/* Tie the task to interrupt number Irq, and give it the priority Priority. */
+void Sched_Init (Sched_Task *Task, Sched_Handler Handler, uint8_t Irq, uint8_t Priority);
+
+/* Queue an event to the task and trigger it, can be called from any task or interrupt.
+   Returns 0 if the queue of the task is full (SCHED_EVENTS_MAX - 1 events), 1 otherwise. */
+uint8_t Sched_Post (Sched_Task *Task, uint8_t Event);
+
+/* To be called from the interrupt handler the task is tied to, runs the handler for every waiting event. */
+void Sched_Dispatch (Sched_Task *Task);
+
+/* Nothing is left to do in the main loop, sleep and leave the rest to the tasks. */
+void Sched_Run (void);
+
+#endif
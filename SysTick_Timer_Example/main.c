@@ -8,8 +8,48 @@
 #define BLUE      0x04
 #define GREEN     0x08
 
+/* The MCU runs from the 16 MHz internal oscillator, so 16000 cycles make up 1 millisecond. */
+#define TICKS_PER_MS       16000
+
+/* Number of software timers the timer service can run at the same time. */
+#define TIMERS_MAX         2
+#define TIMER_SWITCHES     0
+#define TIMER_SEQUENCE     1
+
+/* How often the switches are sampled, and how long each step of the LED sequences lasts. */
+#define SWITCHES_PERIOD_MS 10
+#define SEQUENCE_PERIOD_MS 1000
+
+/* The switch combinations, as read from PF4 and PF0 (the switches are active low). */
+#define MODE_SW1           0x01
+#define MODE_SW2           0x10
+#define MODE_BOTH          0x00
+#define MODE_NONE          0x11
+
 /* This is a needed function declaration related to the startup code. */
 void SystemInit () {}
+
+/* Callback called from the main loop when a software timer expires. */
+typedef void (*Timer_Callback) (void);
+
+/* A software timer, it expires when the tick count reaches Deadline, and is restarted with Period if it is not ZERO. */
+typedef struct
+{
+	uint32_t Deadline;
+	uint32_t Period;
+	Timer_Callback Callback;
+} Soft_Timer;
+
+/* Milliseconds since the SysTick was started, only ever written by the SysTick interrupt. */
+static volatile uint32_t Ticks = 0;
+
+/* The software timers, a timer with no callback is stopped. */
+static Soft_Timer Timers [TIMERS_MAX];
+
+/* Switch combination that selected the running LED sequence, and the step the sequence is at. */
+static uint8_t Mode = MODE_NONE;
+static uint8_t Step = 0;
+
 void Init_PORTF ()
 {
 	/* create a dummy variable in order to provide delay till the clock is provided. */
@@ -46,64 +86,185 @@ void Init_PORTF ()
 	GPIO_PORTF_PUR_R = 0x11;
 }
 
-void SysTick_Timer (uint32_t delay)
+void SysTick_Init (void)
 {
 	/* Disable teh countting, untill the options of the systic timer is updated. */
 	NVIC_ST_CTRL_R = 0;
-	/* Set the number of ticks that the timer would need to reach to end the delay. */
-	NVIC_ST_RELOAD_R = delay - 1;     
-  /* Clear the control register, as to reset our count from ZERO. */	
+	/* Interrupt every 1 millisecond. */
+	NVIC_ST_RELOAD_R = TICKS_PER_MS - 1;
+	/* Clear the control register, as to reset our count from ZERO. */
 	NVIC_ST_CURRENT_R = 0;
-	/* Enable the systic timer, with no interrupt, and with use of System Clock */
-	NVIC_ST_CTRL_R |= 5; 
-	/* Wait untill the Count Flag is set. */
-	while((NVIC_ST_CTRL_R & 0x00010000) == 0) {}
+	/* Give the SysTick the lowest priority, 7, nothing here is more urgent than the rest. */
+	NVIC_SYS_PRI3_R = (NVIC_SYS_PRI3_R & 0x00FFFFFF) | 0xE0000000;
+	/* Enable the systic timer, with its interrupt, and with use of System Clock */
+	NVIC_ST_CTRL_R = 7;
 }
 
-int main(void)
+/* The only work done in the interrupt is counting, the callbacks run from the main loop. */
+void SysTick_Handler (void)
 {
-	Init_PORTF ();
-	while (1)
+	Ticks++;
+}
+
+/*****************************************************************************/
+/*                                Timer Service                              */
+/*****************************************************************************/
+
+/* Start (or restart) a timer that expires after Delay milliseconds, and then every Period milliseconds if Period is not ZERO. */
+void Timer_Start (uint8_t Id, uint32_t Delay, uint32_t Period, Timer_Callback Callback)
+{
+	Timers[Id].Deadline = Ticks + Delay;
+	Timers[Id].Period   = Period;
+	Timers[Id].Callback = Callback;
+}
+
+void Timer_Stop (uint8_t Id)
+{
+	Timers[Id].Callback = 0;
+}
+
+/* Run the callbacks of all the timers that expired, returns when none is left. */
+void Timer_Process (void)
+{
+	uint8_t i;
+	Timer_Callback Callback;
+
+	for (i = 0; i < TIMERS_MAX; i++)
 	{
-		/* if SW1 is pressed only. */
-		if ((GPIO_PORTF_DATA_R & 0x11) == 0x01)
+		/* The difference is taken as signed, so the comparison still works when Ticks wraps around. */
+		if ((Timers[i].Callback != 0) && ((int32_t) (Ticks - Timers[i].Deadline) >= 0))
 		{
+			Callback = Timers[i].Callback;
+
+			if (Timers[i].Period != 0)
+			{
+				/* Advance from the old deadline rather than from now, so the period does not drift. */
+				Timers[i].Deadline += Timers[i].Period;
+			}
+			else
+			{
+				Timers[i].Callback = 0;
+			}
+
+			Callback ();
+		}
+	}
+}
+
+/* Sleep until the next interrupt, interrupts are masked while checking so a tick can not be missed in between. */
+void Sleep (uint32_t LastTicks)
+{
+	__disable_irq ();
+	if (Ticks == LastTicks)
+	{
+		/* A pending interrupt still wakes the core up even though it is masked. */
+		__wfi ();
+	}
+	__enable_irq ();
+}
+
+/*****************************************************************************/
+/*                            LED State Machines                             */
+/*****************************************************************************/
+
+/* Called every SEQUENCE_PERIOD_MS, moves the sequence selected by the switches one step forward. */
+void Sequence_Step (void)
+{
+	switch (Mode)
+	{
+		case MODE_SW1:
 			/* Toggle All 3 LEDS: RED, GREEN and BLUE, every 1 second. */
 			GPIO_PORTF_DATA_R ^= 0x0E;
-			SysTick_Timer (16000000);	
-		}
-		/* if SW2 is pressed only. */
-		else if ((GPIO_PORTF_DATA_R & 0x11) == 0x10)
-		{
-			/* Toggle RED, wait 1 second, Toggle BLUE, wait 1 second, Toggle Green, 
+			break;
+
+		case MODE_SW2:
+			/* Toggle RED, wait 1 second, Toggle BLUE, wait 1 second, Toggle Green,
 			   and then wait also another 1 second. */
-			GPIO_PORTF_DATA_R ^= RED;
-			SysTick_Timer (16000000);
-			GPIO_PORTF_DATA_R ^= BLUE;
-			SysTick_Timer (16000000); 
-	    GPIO_PORTF_DATA_R ^= GREEN;
-			SysTick_Timer (16000000);
+			if (Step == 0)
+			{
+				GPIO_PORTF_DATA_R ^= RED;
+			}
+			else if (Step == 1)
+			{
+				GPIO_PORTF_DATA_R ^= BLUE;
+			}
+			else
+			{
+				GPIO_PORTF_DATA_R ^= GREEN;
+			}
+			Step = (Step + 1) % 3;
+			break;
+
+		case MODE_BOTH:
+			/* Toggle 1 LED for 1 second, and then toggle the next LED, with turning
+			OFF the previous LED, in a successive manner. */
+			if (Step == 0)
+			{
+				GPIO_PORTF_DATA_R = (GPIO_PORTF_DATA_R & ~0x0E) | RED;
+			}
+			else if (Step == 1)
+			{
+				GPIO_PORTF_DATA_R = (GPIO_PORTF_DATA_R & ~0x0E) | BLUE;
+			}
+			else
+			{
+				GPIO_PORTF_DATA_R = (GPIO_PORTF_DATA_R & ~0x0E) | GREEN;
+			}
+			Step = (Step + 1) % 3;
+			break;
+
+		default:
+			/* Turn OFF all LEDS, and keep it that way untill further information. */
+			GPIO_PORTF_DATA_R = OFF;
+			break;
+	}
+}
+
+/* Called every SWITCHES_PERIOD_MS, restarts the LED sequence as soon as the switches change. */
+void Switches_Poll (void)
+{
+	uint8_t NewMode = GPIO_PORTF_DATA_R & 0x11;
+
+	if (NewMode != Mode)
+	{
+		Mode = NewMode;
+		Step = 0;
+
+		if (Mode == MODE_BOTH)
+		{
+			/* This sequence only ever has one LED ON, so start from all of them OFF. */
+			GPIO_PORTF_DATA_R = OFF;
 		}
-		/* if both SW1 and SW2 are pressed together. */
-		else if ((GPIO_PORTF_DATA_R & 0x11) == 0x00)
+
+		/* Do the first step right away, then one step every second. */
+		Sequence_Step ();
+		if (Mode == MODE_NONE)
 		{
-			/* Toggle 1 LED for 1 second, and then toggle the next LED, with turning 
-			OFF the previous LED, in a successive manner. */
-			GPIO_PORTF_DATA_R ^= RED;
-			SysTick_Timer (16000000);
-			GPIO_PORTF_DATA_R ^= RED;
-			GPIO_PORTF_DATA_R ^= BLUE;
-			SysTick_Timer (16000000); 
-			GPIO_PORTF_DATA_R ^= BLUE;
-	    GPIO_PORTF_DATA_R ^= GREEN;
-			SysTick_Timer (16000000);
-			GPIO_PORTF_DATA_R ^= GREEN;
+			Timer_Stop (TIMER_SEQUENCE);
 		}
-		else 
+		else
 		{
-			/* Turn OFF all LEDS for 1 second, and keep it that way untill further information. */
-		  GPIO_PORTF_DATA_R = OFF;
-			SysTick_Timer (16000000);
+			Timer_Start (TIMER_SEQUENCE, SEQUENCE_PERIOD_MS, SEQUENCE_PERIOD_MS, Sequence_Step);
 		}
 	}
 }
+
+int main(void)
+{
+	uint32_t LastTicks;
+
+	Init_PORTF ();
+	SysTick_Init ();
+
+	/* The switches are sampled all the time, the LED sequences are started from there. */
+	Timer_Start (TIMER_SWITCHES, 0, SWITCHES_PERIOD_MS, Switches_Poll);
+
+	while (1)
+	{
+		LastTicks = Ticks;
+		Timer_Process ();
+
+		/* Nothing else to do untill the next tick. */
+		Sleep (LastTicks);
+	}
+}
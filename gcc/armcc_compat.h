@@ -0,0 +1,20 @@
+/*
+ * The armcc intrinsics the Keil bare metal examples use, for GCC. The
+ * Makefile force-includes it in front of every file of those examples, so
+ * they build unchanged.
+ */
+
+#ifndef ARMCC_COMPAT_H
+#define ARMCC_COMPAT_H
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Unlike the armcc ones these return nothing, no example uses the value. */
+#define __disable_irq()    __asm volatile ("cpsid i" ::: "memory")
+#define __enable_irq()     __asm volatile ("cpsie i" ::: "memory")
+
+#define __wfi()            __asm volatile ("wfi")
+
+#endif /* ARMCC_COMPAT_H */
@@ -0,0 +1,184 @@
+/*
+ * Host test of the scheduler of actors.c. The actors are created on a heap
+ * that counts a header per block like heap_5.c, and run tick by tick, with
+ * Actors_Schedule() called until every ready actor ran, as the idle hook
+ * would between two ticks. Each run starts at a different tick count, across
+ * the wrap of the 16 bit wake ticks and of the tick count itself. No sensor
+ * may take its sample before its period is over, every sample has to reach
+ * its filter, and the actors and their state have to fit ACTORS_TARGET_BYTES.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The module itself, to start it over for each run. */
+#include "../../FreeRTOS/actors.c"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* The BlockLink_t of heap_5.c on a 32 bit target, and its alignment. */
+#define TEST_HEAP_HEADER        8
+#define TEST_HEAP_ALIGNMENT     8
+#define TEST_HEAP_SIZE          16384
+
+#define TEST_PERIODS            25
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static TickType_t xTestTick;
+static size_t xTestHeapFree;
+static bool bTestHeapFull;
+
+static uint32_t ui32TestCases = 0;
+static uint32_t ui32TestFailures = 0;
+
+/*****************************************************************************/
+/*                               Kernel Functions                            */
+/*****************************************************************************/
+
+TickType_t xTaskGetTickCount (void)
+{
+    return xTestTick;
+}
+
+TaskHandle_t xTaskGetIdleTaskHandle (void)
+{
+    return NULL;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark (TaskHandle_t xTask)
+{
+    return 0;
+}
+
+void *pvPortMalloc (size_t xWantedSize)
+{
+    xWantedSize = (xWantedSize + TEST_HEAP_HEADER + TEST_HEAP_ALIGNMENT - 1) & ~(size_t) (TEST_HEAP_ALIGNMENT - 1);
+    if ((bTestHeapFull == true) || (xWantedSize > xTestHeapFree))
+    {
+        return NULL;
+    }
+    xTestHeapFree -= xWantedSize;
+
+    return malloc (xWantedSize);
+}
+
+size_t xPortGetFreeHeapSize (void)
+{
+    return xTestHeapFree;
+}
+
+/*****************************************************************************/
+/*                               Test Functions                              */
+/*****************************************************************************/
+
+static void Test_check (bool bCondition, const char *pcCase, uint32_t ui32Got, uint32_t ui32Expected)
+{
+    ui32TestCases++;
+    if (bCondition == false)
+    {
+        ui32TestFailures++;
+        printf ("FAIL %s: %u, expected %u\n", pcCase, ui32Got, ui32Expected);
+    }
+}
+
+/* The state of actors.c as at boot. */
+static void Test_reset (void)
+{
+    free (psActors);
+    psActors = NULL;
+    eActorsState = ACTORS_IDLE;
+    ui32ActorsHeapBytes = 0;
+    ui8ActorsReadyHead = ACTORS_NONE;
+    ui8ActorsReadyTail = ACTORS_NONE;
+    ui8ActorsDelayedHead = ACTORS_NONE;
+    ui32ActorsSamples = 0;
+    xTestHeapFree = TEST_HEAP_SIZE;
+    bTestHeapFull = false;
+}
+
+/* Every actor ready at this tick runs, more than once if it stays ready. */
+static void Test_idle (void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2 * ACTORS_COUNT; i++)
+    {
+        Actors_Schedule ();
+    }
+}
+
+/* The actors from xStart, for TEST_PERIODS periods. Each sensor samples ACTORS_PERIOD_MS ticks after it
+ * was first run, then every ACTORS_PERIOD_MS, and its filter averages the sample in the same tick. */
+static void Test_run (TickType_t xStart)
+{
+    Actors_Stats xStats;
+    char pcCase[64];
+    uint32_t ui32Tick, ui32Expected;
+
+    Test_reset ();
+    xTestTick = xStart;
+    Actors_Start ();
+    Actors_Create ();
+    Actors_getStats (&xStats);
+
+    snprintf (pcCase, sizeof (pcCase), "from tick %u, actors", xStart);
+    Test_check (xStats.ui32Actors == ACTORS_COUNT, pcCase, xStats.ui32Actors, ACTORS_COUNT);
+    snprintf (pcCase, sizeof (pcCase), "from tick %u, heap bytes", xStart);
+    Test_check (xStats.ui32HeapBytes <= ACTORS_TARGET_BYTES, pcCase, xStats.ui32HeapBytes, ACTORS_TARGET_BYTES);
+
+    for (ui32Tick = 0; ui32Tick <= TEST_PERIODS * ACTORS_PERIOD_MS; ui32Tick++)
+    {
+        xTestTick = xStart + ui32Tick;
+        Test_idle ();
+
+        /* Only checked around each period, a failure shows up as a wrong count there. */
+        if (((ui32Tick % ACTORS_PERIOD_MS) == 0) || ((ui32Tick % ACTORS_PERIOD_MS) == (ACTORS_PERIOD_MS - 1)))
+        {
+            ui32Expected = (ui32Tick / ACTORS_PERIOD_MS) * ACTORS_PAIRS;
+            snprintf (pcCase, sizeof (pcCase), "from tick %u, samples at tick +%u", xStart, ui32Tick);
+            Test_check (ui32ActorsSamples == ui32Expected, pcCase, ui32ActorsSamples, ui32Expected);
+        }
+    }
+}
+
+int main (void)
+{
+    static const TickType_t xStarts[] = { 0, 1000, 0xFFFF - 1234, 0xFFFFFFFF - 1234 };
+    Actors_Stats xStats;
+    uint32_t i;
+
+    /* Nothing runs until asked for, and a heap with no room is said so. */
+    Test_reset ();
+    Actors_Create ();
+    Test_idle ();
+    Actors_getStats (&xStats);
+    Test_check (xStats.ui32Actors == 0, "before Actors_Start(), actors", xStats.ui32Actors, 0);
+    bTestHeapFull = true;
+    Actors_Start ();
+    Actors_Create ();
+    Test_idle ();
+    Actors_getStats (&xStats);
+    Test_check (xStats.bNoRoom == true, "no room", xStats.bNoRoom, true);
+
+    for (i = 0; i < sizeof (xStarts) / sizeof (xStarts[0]); i++)
+    {
+        Test_run (xStarts[i]);
+    }
+    Actors_getStats (&xStats);
+
+    printf ("actors_test: %u cases, %u failed, %u actors in %u bytes, control/state %u/%u\n",
+            ui32TestCases, ui32TestFailures, ACTORS_COUNT, xStats.ui32HeapBytes,
+            xStats.ui32ControlBytes, xStats.ui32StateBytes);
+
+    return (ui32TestFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/*
+ * Host test of atomic.h on the exclusive access primitives of host.h, which
+ * loop like those of portmacro.h. Each operation is first checked alone for
+ * the value it returns and the value it leaves, then hammered from several
+ * threads at once, where an operation that is not atomic loses updates or
+ * returns an old value that another call returned too.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/* Header Files Includes.  */
+#include "atomic.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define TEST_THREADS        4
+#define TEST_ROUNDS         4000000
+#define TEST_PRINTED        10
+
+#define TEST_CHECK(bCondition, ...)                                                         \
+    do                                                                                      \
+    {                                                                                       \
+        __atomic_add_fetch (&ui32TestCases, 1, __ATOMIC_RELAXED);                           \
+        if (!(bCondition))                                                                  \
+        {                                                                                   \
+            if (__atomic_add_fetch (&ui32TestFailures, 1, __ATOMIC_RELAXED) <= TEST_PRINTED) \
+            {                                                                               \
+                printf ("FAIL " __VA_ARGS__);                                               \
+                printf ("\n");                                                              \
+            }                                                                               \
+        }                                                                                   \
+    } while (0)
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static uint32_t ui32TestCases = 0;
+static uint32_t ui32TestFailures = 0;
+
+/* What the threads share. */
+static volatile uint32_t ui32TestCounter;
+static volatile uint32_t ui32TestSum;
+static volatile uint32_t ui32TestEven;
+static volatile uint32_t ui32TestBits;
+static volatile uint32_t ui32TestSlot;
+
+/* One bit for each value Atomic_Increment_u32() returned. */
+static uint8_t *pui8TestSeen;
+
+/* What each thread counted, added up by main(). */
+static uint32_t ui32TestEvenFailures[TEST_THREADS];
+static uint64_t ui64TestSwappedIn[TEST_THREADS];
+static uint64_t ui64TestSwappedOut[TEST_THREADS];
+
+/*****************************************************************************/
+/*                               Test Functions                              */
+/*****************************************************************************/
+
+/* The returned and the left value of each operation, on one thread. */
+static void Test_single (void)
+{
+    volatile uint32_t ui32Value = 5;
+    uint32_t ui32Old;
+
+    TEST_CHECK (Atomic_CompareAndSwap_u32 (&ui32Value, 9, 4) == ATOMIC_COMPARE_AND_SWAP_FAILURE, "CAS on a different value");
+    TEST_CHECK (ui32Value == 5, "a failed CAS wrote %u", ui32Value);
+    TEST_CHECK (Atomic_CompareAndSwap_u32 (&ui32Value, 9, 5) == ATOMIC_COMPARE_AND_SWAP_SUCCESS, "CAS on the same value");
+    TEST_CHECK (ui32Value == 9, "CAS left %u instead of 9", ui32Value);
+
+    ui32Old = Atomic_Add_u32 (&ui32Value, 3);
+    TEST_CHECK ((ui32Old == 9) && (ui32Value == 12), "Add returned %u, left %u", ui32Old, ui32Value);
+    ui32Old = Atomic_Subtract_u32 (&ui32Value, 20);
+    TEST_CHECK ((ui32Old == 12) && (ui32Value == 0xFFFFFFF8u), "Subtract returned %u, left %u", ui32Old, ui32Value);
+    ui32Old = Atomic_Increment_u32 (&ui32Value);
+    TEST_CHECK ((ui32Old == 0xFFFFFFF8u) && (ui32Value == 0xFFFFFFF9u), "Increment returned %u, left %u", ui32Old, ui32Value);
+    ui32Old = Atomic_Decrement_u32 (&ui32Value);
+    TEST_CHECK ((ui32Old == 0xFFFFFFF9u) && (ui32Value == 0xFFFFFFF8u), "Decrement returned %u, left %u", ui32Old, ui32Value);
+
+    ui32Value = 0x0F0F;
+    ui32Old = Atomic_OR_u32 (&ui32Value, 0x00FF);
+    TEST_CHECK ((ui32Old == 0x0F0F) && (ui32Value == 0x0FFF), "OR returned %x, left %x", ui32Old, ui32Value);
+    ui32Old = Atomic_AND_u32 (&ui32Value, 0xF0F0);
+    TEST_CHECK ((ui32Old == 0x0FFF) && (ui32Value == 0x00F0), "AND returned %x, left %x", ui32Old, ui32Value);
+    ui32Old = Atomic_XOR_u32 (&ui32Value, 0x0FF0);
+    TEST_CHECK ((ui32Old == 0x00F0) && (ui32Value == 0x0F00), "XOR returned %x, left %x", ui32Old, ui32Value);
+    ui32Old = Atomic_NAND_u32 (&ui32Value, 0x0300);
+    TEST_CHECK ((ui32Old == 0x0F00) && (ui32Value == 0xFFFFFCFFu), "NAND returned %x, left %x", ui32Old, ui32Value);
+}
+
+/*
+ * Each thread increments the counter and marks the value it got back, adds
+ * to ui32TestSum and takes one less away again, adds 2 to ui32TestEven with a CAS
+ * loop, tries to put an odd value there with a CAS that can never succeed,
+ * flips its own bit of ui32TestBits and swaps its own values through one
+ * slot. The slot is swapped with ulPortAtomicSwap(), the swap of atomic.h is
+ * for pointers, which are wider than 32 bits here.
+ */
+static void *Test_thread (void *pvParameter)
+{
+    uint32_t ui32Thread = (uint32_t) (uintptr_t) pvParameter;
+    uint32_t ui32Bit = 1u << ui32Thread;
+    uint32_t ui32Old, ui32Value, i;
+
+    for (i = 0; i < TEST_ROUNDS; i++)
+    {
+        ui32Old = Atomic_Increment_u32 (&ui32TestCounter);
+        if (__atomic_fetch_or (&pui8TestSeen[ui32Old >> 3], 1u << (ui32Old & 7), __ATOMIC_RELAXED) & (1u << (ui32Old & 7)))
+        {
+            TEST_CHECK (0, "Increment returned %u twice", ui32Old);
+        }
+        Atomic_Add_u32 (&ui32TestSum, 1000);
+        Atomic_Subtract_u32 (&ui32TestSum, 998);
+        Atomic_Decrement_u32 (&ui32TestSum);
+
+        do
+        {
+            ui32Old = ui32TestEven;
+        } while (Atomic_CompareAndSwap_u32 (&ui32TestEven, ui32Old + 2, ui32Old) != ATOMIC_COMPARE_AND_SWAP_SUCCESS);
+        if (Atomic_CompareAndSwap_u32 (&ui32TestEven, 1, 1 + 2 * i) == ATOMIC_COMPARE_AND_SWAP_SUCCESS)
+        {
+            TEST_CHECK (0, "a CAS succeeded on an odd value that was never there");
+        }
+        else
+        {
+            ui32TestEvenFailures[ui32Thread]++;
+        }
+
+        ui32Old = Atomic_OR_u32 (&ui32TestBits, ui32Bit);
+        if (ui32Old & ui32Bit)
+        {
+            TEST_CHECK (0, "thread %u: OR found its bit set", ui32Thread);
+        }
+        ui32Old = Atomic_XOR_u32 (&ui32TestBits, ui32Bit);
+        if (!(ui32Old & ui32Bit))
+        {
+            TEST_CHECK (0, "thread %u: XOR found its bit clear", ui32Thread);
+        }
+        ui32Old = Atomic_XOR_u32 (&ui32TestBits, ui32Bit);
+        ui32Old = Atomic_AND_u32 (&ui32TestBits, ~ui32Bit);
+        if (!(ui32Old & ui32Bit))
+        {
+            TEST_CHECK (0, "thread %u: AND found its bit clear", ui32Thread);
+        }
+
+        ui32Value = (i * TEST_THREADS) + ui32Thread + 1;
+        ui64TestSwappedIn[ui32Thread] += ui32Value;
+        ui64TestSwappedOut[ui32Thread] += ulPortAtomicSwap (&ui32TestSlot, ui32Value);
+    }
+
+    return NULL;
+}
+
+/* Nothing may have been lost, or counted twice. */
+static void Test_threads (void)
+{
+    pthread_t xThreads[TEST_THREADS];
+    uint64_t ui64In = 0, ui64Out = 0;
+    uint32_t ui32Failures = 0, ui32Missing = 0, i;
+
+    pui8TestSeen = calloc ((TEST_THREADS * TEST_ROUNDS + 7) / 8, 1);
+
+    for (i = 0; i < TEST_THREADS; i++)
+    {
+        pthread_create (&xThreads[i], NULL, Test_thread, (void *) (uintptr_t) i);
+    }
+    for (i = 0; i < TEST_THREADS; i++)
+    {
+        pthread_join (xThreads[i], NULL);
+        ui32Failures += ui32TestEvenFailures[i];
+        ui64In += ui64TestSwappedIn[i];
+        ui64Out += ui64TestSwappedOut[i];
+    }
+
+    for (i = 0; i < TEST_THREADS * TEST_ROUNDS; i++)
+    {
+        if (!(pui8TestSeen[i >> 3] & (1u << (i & 7))))
+        {
+            ui32Missing++;
+        }
+    }
+    free (pui8TestSeen);
+
+    TEST_CHECK (ui32TestCounter == TEST_THREADS * TEST_ROUNDS, "counter at %u instead of %u", ui32TestCounter, TEST_THREADS * TEST_ROUNDS);
+    TEST_CHECK (ui32TestSum == TEST_THREADS * TEST_ROUNDS, "sum at %u instead of %u", ui32TestSum, TEST_THREADS * TEST_ROUNDS);
+    TEST_CHECK (ui32Missing == 0, "Increment never returned %u of the values", ui32Missing);
+    TEST_CHECK (ui32TestEven == 2 * TEST_THREADS * TEST_ROUNDS, "CAS loop at %u instead of %u", ui32TestEven, 2 * TEST_THREADS * TEST_ROUNDS);
+    TEST_CHECK (ui32Failures == TEST_THREADS * TEST_ROUNDS, "%u failed CAS instead of %u", ui32Failures, TEST_THREADS * TEST_ROUNDS);
+    TEST_CHECK (ui32TestBits == 0, "bits left at %x", ui32TestBits);
+    TEST_CHECK (ui64In == ui64Out + ui32TestSlot, "swapped %llu in, %llu out", (unsigned long long) ui64In, (unsigned long long) (ui64Out + ui32TestSlot));
+}
+
+int main (void)
+{
+    Test_single ();
+    Test_threads ();
+
+    printf ("atomic_test: %u checks on %u threads of %u rounds, %u failed\n",
+            ui32TestCases, TEST_THREADS, TEST_ROUNDS, ui32TestFailures);
+
+    return (ui32TestFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/*
+ * Host test of Baud_detect() of baud.c on a simulated UART line. The host
+ * sends U characters at each rate of the table, a little off, while the
+ * cycle counter goes on by a few cycles for every read of it and of the pin,
+ * as the polling loops would on the target. A SysTick interrupt comes every
+ * millisecond and takes a while, it waits while Baud_detect() has the
+ * interrupts masked. Every rate has to be found, no tick may be lost and no
+ * masked window may be longer than BAUD_TEST_MASKED_MAX.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdio.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "baud.h"
+#include "inc/hw_types.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define BAUD_TEST_CLOCK         80000000
+
+/* Cycles of a read of the counter and of the pin, of the loops around them included. */
+#define BAUD_TEST_COUNTER_READ  4
+#define BAUD_TEST_PIN_READ      3
+
+/* The tick, and how long its interrupt takes. */
+#define BAUD_TEST_TICK          (BAUD_TEST_CLOCK / 1000)
+#define BAUD_TEST_TICK_ISR      600
+
+/* Longest the interrupts may stay masked, half a tick. */
+#define BAUD_TEST_MASKED_MAX    (BAUD_TEST_TICK / 2)
+
+#define BAUD_TEST_TIMEOUT_MS    1000
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    double dStart;              /* Cycle of the first start bit. */
+    double dBit;                /* Cycles of a bit at the rate of the host. */
+    double dGap;                /* Idle cycles between two characters. */
+    uint32_t ui32Characters;
+    uint8_t ui8Character;
+} Baud_TestLine;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static uint64_t ui64TestTime;
+static Baud_TestLine xTestLine;
+
+static bool bTestMasked;
+static uint64_t ui64TestMaskedAt;
+static uint64_t ui64TestMaskedMax;
+
+static uint64_t ui64TestTickDue;
+static uint64_t ui64TestTickLatencyMax;
+static uint32_t ui32TestTicksLost;
+
+static uint32_t ui32TestCases = 0;
+static uint32_t ui32TestFailures = 0;
+
+/*****************************************************************************/
+/*                               Host Functions                              */
+/*****************************************************************************/
+
+/* The ticks that came due while the interrupts were masked, each taken as soon as they are not. */
+static void Test_interrupts (void)
+{
+    while ((bTestMasked == false) && (ui64TestTime >= ui64TestTickDue))
+    {
+        if ((ui64TestTime - ui64TestTickDue) >= BAUD_TEST_TICK)
+        {
+            /* Another one came due before this one was taken, the kernel only sees one. */
+            ui32TestTicksLost++;
+        }
+        if ((ui64TestTime - ui64TestTickDue) > ui64TestTickLatencyMax)
+        {
+            ui64TestTickLatencyMax = ui64TestTime - ui64TestTickDue;
+        }
+        ui64TestTime += BAUD_TEST_TICK_ISR;
+        ui64TestTickDue += BAUD_TEST_TICK;
+    }
+}
+
+uint32_t Host_getCycles (void)
+{
+    ui64TestTime += BAUD_TEST_COUNTER_READ;
+    Test_interrupts ();
+
+    return (uint32_t) ui64TestTime;
+}
+
+void Host_enterCritical (void)
+{
+    bTestMasked = true;
+    ui64TestMaskedAt = ui64TestTime;
+}
+
+void Host_exitCritical (void)
+{
+    bTestMasked = false;
+    if ((ui64TestTime - ui64TestMaskedAt) > ui64TestMaskedMax)
+    {
+        ui64TestMaskedMax = ui64TestTime - ui64TestMaskedAt;
+    }
+    Test_interrupts ();
+}
+
+/* PA0 at this cycle: idle high, then the characters, a low start bit, the data bits from bit 0 and a high stop bit. */
+uint32_t Host_readRegister (uint32_t ui32Address)
+{
+    double dTime, dCharacter;
+    uint32_t ui32Index, ui32Bit;
+
+    ui64TestTime += BAUD_TEST_PIN_READ;
+    Test_interrupts ();
+
+    dTime = (double) ui64TestTime - xTestLine.dStart;
+    dCharacter = (10 * xTestLine.dBit) + xTestLine.dGap;
+    if ((dTime < 0) || (dTime >= (dCharacter * xTestLine.ui32Characters)))
+    {
+        return 1;
+    }
+
+    ui32Index = (uint32_t) (dTime / dCharacter);
+    ui32Bit = (uint32_t) ((dTime - (ui32Index * dCharacter)) / xTestLine.dBit);
+    if (ui32Bit == 0)
+    {
+        return 0;
+    }
+    if (ui32Bit >= 9)
+    {
+        return 1;
+    }
+
+    return (xTestLine.ui8Character >> (ui32Bit - 1)) & 1;
+}
+
+/*****************************************************************************/
+/*                               Test Functions                              */
+/*****************************************************************************/
+
+/* Baud_detect() on a line where the host starts sending ui32Characters of ui8Character at ui32Baud,
+ * i32Ppm off, after dDelayMs, with dGapBits between them. */
+static uint32_t Test_detect (uint32_t ui32Baud, int32_t i32Ppm, double dDelayMs, double dGapBits,
+                             uint32_t ui32Characters, uint8_t ui8Character)
+{
+    uint64_t ui64Start;
+    uint32_t ui32Detected;
+
+    ui64TestTime = 1000000;
+    ui64TestTickDue = ui64TestTime + (BAUD_TEST_TICK / 3);
+    ui64TestMaskedMax = 0;
+    ui64TestTickLatencyMax = 0;
+    ui32TestTicksLost = 0;
+
+    xTestLine.dBit = (double) BAUD_TEST_CLOCK / ((double) ui32Baud * (1.0 + (i32Ppm / 1e6)));
+    xTestLine.dStart = (double) ui64TestTime + (dDelayMs * (BAUD_TEST_CLOCK / 1000));
+    xTestLine.dGap = dGapBits * xTestLine.dBit;
+    xTestLine.ui32Characters = ui32Characters;
+    xTestLine.ui8Character = ui8Character;
+
+    ui64Start = ui64TestTime;
+    ui32Detected = Baud_detect (0x40004000, 1, BAUD_TEST_CLOCK, BAUD_TEST_TIMEOUT_MS);
+
+    ui32TestCases++;
+    if ((ui64TestMaskedMax > BAUD_TEST_MASKED_MAX) || (ui32TestTicksLost != 0) ||
+        ((ui64TestTime - ui64Start) > ((uint64_t) (BAUD_TEST_TIMEOUT_MS + 2) * (BAUD_TEST_CLOCK / 1000))))
+    {
+        ui32TestFailures++;
+        printf ("FAIL %u baud: masked %llu cycles at most, %u ticks lost, %llu cycles in all\n", ui32Baud,
+                (unsigned long long) ui64TestMaskedMax, ui32TestTicksLost, (unsigned long long) (ui64TestTime - ui64Start));
+    }
+
+    return ui32Detected;
+}
+
+static void Test_expect (const char *pcCase, uint32_t ui32Detected, uint32_t ui32Expected)
+{
+    ui32TestCases++;
+    if (ui32Detected != ui32Expected)
+    {
+        ui32TestFailures++;
+        printf ("FAIL %s: %u baud instead of %u\n", pcCase, ui32Detected, ui32Expected);
+    }
+}
+
+int main (void)
+{
+    static const uint32_t ui32Rates[] =
+    {
+        9600, 14400, 19200, 38400, 57600, 115200, 128000, 230400, 256000, 460800, 500000, 921600
+    };
+    static const int32_t i32Errors[] = { 0, -20000, 20000 };
+    uint64_t ui64MaskedMax = 0, ui64LatencyMax = 0;
+    char pcCase[64];
+    uint32_t r, e;
+
+    /* Every rate up to 921600, off by up to 2%, the host starting to send after a while, back to back
+     * characters or with a gap between them. */
+    for (r = 0; r < sizeof (ui32Rates) / sizeof (ui32Rates[0]); r++)
+    {
+        for (e = 0; e < sizeof (i32Errors) / sizeof (i32Errors[0]); e++)
+        {
+            snprintf (pcCase, sizeof (pcCase), "%u baud %+d ppm", ui32Rates[r], i32Errors[e]);
+            Test_expect (pcCase, Test_detect (ui32Rates[r], i32Errors[e], 37.3, 0, 40, BAUD_SYNC), ui32Rates[r]);
+            if (ui64TestMaskedMax > ui64MaskedMax)
+            {
+                ui64MaskedMax = ui64TestMaskedMax;
+            }
+            if (ui64TestTickLatencyMax > ui64LatencyMax)
+            {
+                ui64LatencyMax = ui64TestTickLatencyMax;
+            }
+
+            snprintf (pcCase, sizeof (pcCase), "%u baud %+d ppm, 1.5 bits apart", ui32Rates[r], i32Errors[e]);
+            Test_expect (pcCase, Test_detect (ui32Rates[r], i32Errors[e], 5, 1.5, 40, BAUD_SYNC), ui32Rates[r]);
+        }
+    }
+
+    /* Nothing, and characters that are not U, give nothing, within the time. */
+    Test_expect ("silence", Test_detect (115200, 0, 0, 0, 0, BAUD_SYNC), 0);
+    Test_expect ("a at 115200", Test_detect (115200, 0, 3, 0, 2000, 'a'), 0);
+    Test_expect ("\\r at 9600", Test_detect (9600, 0, 3, 0, 800, '\r'), 0);
+
+    printf ("baud_test: %u cases, %u failed, interrupts masked %llu cycles at most, tick late %llu at most\n",
+            ui32TestCases, ui32TestFailures, (unsigned long long) ui64MaskedMax, (unsigned long long) ui64LatencyMax);
+
+    return (ui32TestFailures == 0) ? 0 : 1;
+}
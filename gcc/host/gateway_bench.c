@@ -0,0 +1,787 @@
+/*
+ * Host benchmark of the serial gateway: the serial.c and gateway.c of the
+ * firmware run on a discrete event model of the four UARTs they use, their
+ * FIFOs, trigger levels, receive timeout and line timing, with the time the
+ * Cortex-M4 spends counted in cycles from a rough cost of each interrupt,
+ * driverlib call, notification and context switch, BENCH_COST_*. A host on
+ * each line sends numbered bytes at a share of its line rate, or in bursts,
+ * and the host on the peer line checks that they come out in order.
+ *
+ *   gateway_bench                           the rates of the gateway, make host-bench
+ *   gateway_bench SECONDS B1 B3 B4 B7 LOAD [BURST PERIOD_US]
+ *
+ * With a burst size, only UART1 and UART4 send, BURST bytes back to back
+ * every PERIOD_US. The figures are those of the model, which has no flash
+ * wait states, no other task and no other interrupt than the UARTs.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* Header Files Includes.  */
+#include "serial.h"
+#include "gateway.h"
+
+/* TivaWare includes.  */
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/uart.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define BENCH_CPU_HZ            80000000ULL
+#define BENCH_UARTS             4
+#define BENCH_FIFO_SIZE         16
+
+/* Cycles of each thing the firmware does, at 80 MHz. */
+#define BENCH_COST_ISR          40      /* Interrupt entry and exit. */
+#define BENCH_COST_UART         15      /* A driverlib call on the UART registers. */
+#define BENCH_COST_NOTIFY       150     /* xTaskNotifyIndexed(), from an interrupt or not. */
+#define BENCH_COST_SWITCH       300     /* Context switch into the gateway task. */
+#define BENCH_COST_BLOCK        200     /* ulQueueSelect() that blocks. */
+#define BENCH_COST_SELECT       100     /* Serial_Select() and ulQueueSelect() that do not. */
+#define BENCH_COST_RW           30      /* Serial_Read() and Serial_Write()... */
+#define BENCH_COST_RW_BYTE      3       /* ...and for each byte. */
+#define BENCH_COST_SELECT_ADD   60      /* Serial_SelectAdd(). */
+#define BENCH_COST_PEND         10      /* IntPendSet(). */
+
+/* The interrupt bits of the UART model, as in UARTRIS. */
+#define BENCH_INT_RX            UART_INT_RX
+#define BENCH_INT_TX            UART_INT_TX
+#define BENCH_INT_RT            UART_INT_RT
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    uint32_t ui32Base;
+    uint32_t ui32Interrupt;
+    void (*pfnHandler) (void);
+    uint32_t ui32Baud;
+    uint64_t ui64CharacterCycles;
+    uint64_t ui64BitCycles;
+
+    /* The FIFOs and the shift register of the transmitter. */
+    uint8_t ui8RxFifo[BENCH_FIFO_SIZE];
+    uint32_t ui32RxHead, ui32RxCount;
+    uint64_t ui64RxTimeoutAt;
+    bool bRxTimeoutArmed;
+    uint8_t ui8TxFifo[BENCH_FIFO_SIZE];
+    uint32_t ui32TxHead, ui32TxCount;
+    uint8_t ui8TxShift;
+    bool bTxShifting;
+    uint64_t ui64TxDoneAt;
+
+    /* UARTIM, UARTRIS, and IntPendSet(). */
+    uint32_t ui32Mask;
+    uint32_t ui32Raw;
+    bool bPended;
+
+    /* The host that sends on the line. */
+    bool bSending;
+    uint64_t ui64NextAt;
+    uint8_t ui8NextByte;
+    uint64_t ui64Generated;
+    uint64_t ui64Overruns;
+    double dLoad;
+    uint32_t ui32Burst, ui32BurstLeft;
+    uint64_t ui64BurstPeriod, ui64BurstStart;
+
+    /* The host that receives, what it got and how many times it was out of order. */
+    uint8_t ui8Expected;
+    bool bReceived;
+    uint64_t ui64Delivered;
+    uint64_t ui64OutOfOrder;
+} Bench_UART;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static Bench_UART xBenchUARTs[BENCH_UARTS];
+
+static const uint32_t ui32BenchBases[BENCH_UARTS] = { UART1_BASE, UART3_BASE, UART4_BASE, UART7_BASE };
+static const uint32_t ui32BenchInterrupts[BENCH_UARTS] = { INT_UART1, INT_UART3, INT_UART4, INT_UART7 };
+static void (*const pfnBenchHandlers[BENCH_UARTS]) (void) =
+{
+    Serial_UART1IntHandler, Serial_UART3IntHandler, Serial_UART4IntHandler, Serial_UART7IntHandler
+};
+
+/* Time now, at the end of the run, and spent by the CPU. */
+static uint64_t ui64BenchNow, ui64BenchEnd, ui64BenchBusy;
+static uint64_t ui64BenchInterrupts;
+static uint64_t ui64BenchBlocks;
+static bool bBenchInISR;
+static jmp_buf xBenchEnd;
+
+/* The notification value of the gateway task, and the task. */
+static volatile uint32_t ui32BenchNotified;
+static TaskFunction_t pxBenchTask;
+
+/*****************************************************************************/
+/*                                Model Functions                            */
+/*****************************************************************************/
+
+static Bench_UART *Bench_find (uint32_t ui32Base)
+{
+    uint32_t i;
+
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        if (xBenchUARTs[i].ui32Base == ui32Base)
+        {
+            return &xBenchUARTs[i];
+        }
+    }
+    abort ();
+}
+
+/* The next cycle something happens on a line. */
+static uint64_t Bench_nextEvent (void)
+{
+    uint64_t ui64Next = ~0ULL;
+    uint32_t i;
+
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        Bench_UART *psUART = &xBenchUARTs[i];
+
+        if ((psUART->bSending == true) && (psUART->ui64NextAt < ui64Next))
+        {
+            ui64Next = psUART->ui64NextAt;
+        }
+        if ((psUART->bTxShifting == true) && (psUART->ui64TxDoneAt < ui64Next))
+        {
+            ui64Next = psUART->ui64TxDoneAt;
+        }
+        if ((psUART->bRxTimeoutArmed == true) && (psUART->ui64RxTimeoutAt < ui64Next))
+        {
+            ui64Next = psUART->ui64RxTimeoutAt;
+        }
+    }
+
+    return ui64Next;
+}
+
+/* Move the next byte of the Tx FIFO to the shift register, with the TX interrupt at 2/8 like serial.c sets it. */
+static void Bench_txStart (Bench_UART *psUART, uint64_t ui64Time)
+{
+    uint32_t ui32Before = psUART->ui32TxCount;
+
+    if ((psUART->bTxShifting == false) && (psUART->ui32TxCount > 0))
+    {
+        psUART->ui8TxShift = psUART->ui8TxFifo[psUART->ui32TxHead];
+        psUART->ui32TxHead = (psUART->ui32TxHead + 1) % BENCH_FIFO_SIZE;
+        psUART->ui32TxCount--;
+        psUART->bTxShifting = true;
+        psUART->ui64TxDoneAt = ui64Time + psUART->ui64CharacterCycles;
+        if ((ui32Before > 4) && (psUART->ui32TxCount <= 4))
+        {
+            psUART->ui32Raw |= BENCH_INT_TX;
+        }
+    }
+}
+
+static void Bench_process (uint64_t ui64Time)
+{
+    uint32_t i;
+
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        Bench_UART *psUART = &xBenchUARTs[i];
+
+        /* A byte from the host, RX at 4/8, the receive timeout 32 bits after the last one. */
+        if ((psUART->bSending == true) && (psUART->ui64NextAt == ui64Time))
+        {
+            psUART->ui64Generated++;
+            if (psUART->ui32RxCount == BENCH_FIFO_SIZE)
+            {
+                psUART->ui64Overruns++;
+                psUART->ui8NextByte++;
+            }
+            else
+            {
+                psUART->ui8RxFifo[(psUART->ui32RxHead + psUART->ui32RxCount) % BENCH_FIFO_SIZE] = psUART->ui8NextByte++;
+                if (++psUART->ui32RxCount == 8)
+                {
+                    psUART->ui32Raw |= BENCH_INT_RX;
+                }
+            }
+            psUART->ui64RxTimeoutAt = ui64Time + (32 * psUART->ui64BitCycles);
+            psUART->bRxTimeoutArmed = true;
+
+            if (psUART->ui32Burst != 0)
+            {
+                if (--psUART->ui32BurstLeft == 0)
+                {
+                    psUART->ui64BurstStart += psUART->ui64BurstPeriod;
+                    psUART->ui32BurstLeft = psUART->ui32Burst;
+                    psUART->ui64NextAt = psUART->ui64BurstStart;
+                }
+                else
+                {
+                    psUART->ui64NextAt = ui64Time + psUART->ui64CharacterCycles;
+                }
+            }
+            else
+            {
+                psUART->ui64NextAt = ui64Time + (uint64_t) (psUART->ui64CharacterCycles / psUART->dLoad);
+            }
+            if (psUART->ui64NextAt >= ui64BenchEnd)
+            {
+                psUART->bSending = false;
+            }
+        }
+
+        /* A byte out to the host of the line. */
+        if ((psUART->bTxShifting == true) && (psUART->ui64TxDoneAt == ui64Time))
+        {
+            if ((psUART->bReceived == true) && (psUART->ui8TxShift != psUART->ui8Expected))
+            {
+                psUART->ui64OutOfOrder++;
+            }
+            psUART->bReceived = true;
+            psUART->ui8Expected = psUART->ui8TxShift + 1;
+            psUART->ui64Delivered++;
+            psUART->bTxShifting = false;
+            Bench_txStart (psUART, ui64Time);
+        }
+
+        if ((psUART->bRxTimeoutArmed == true) && (psUART->ui64RxTimeoutAt == ui64Time))
+        {
+            psUART->bRxTimeoutArmed = false;
+            if (psUART->ui32RxCount > 0)
+            {
+                psUART->ui32Raw |= BENCH_INT_RT;
+            }
+        }
+    }
+}
+
+static void Bench_runLinesTo (uint64_t ui64Time)
+{
+    uint64_t ui64Next;
+
+    while ((ui64Next = Bench_nextEvent ()) <= ui64Time)
+    {
+        ui64BenchNow = ui64Next;
+        Bench_process (ui64Next);
+    }
+    ui64BenchNow = ui64Time;
+}
+
+static bool Bench_interruptPending (void)
+{
+    uint32_t i;
+
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        if (((xBenchUARTs[i].ui32Raw & xBenchUARTs[i].ui32Mask) != 0) || (xBenchUARTs[i].bPended == true))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void Bench_spend (uint64_t ui64Cycles);
+
+/* The handlers of every pending interrupt, in the order of the table, as all four have the same priority. */
+static void Bench_runInterrupts (void)
+{
+    int32_t i;
+
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        Bench_UART *psUART = &xBenchUARTs[i];
+
+        if (((psUART->ui32Raw & psUART->ui32Mask) != 0) || (psUART->bPended == true))
+        {
+            psUART->bPended = false;
+            bBenchInISR = true;
+            ui64BenchInterrupts++;
+            Bench_spend (BENCH_COST_ISR);
+            psUART->pfnHandler ();
+            bBenchInISR = false;
+            i = -1;
+        }
+    }
+}
+
+/* The CPU is busy for ui64Cycles, of the task or of an interrupt, the task is interrupted meanwhile. */
+static void Bench_spend (uint64_t ui64Cycles)
+{
+    uint64_t ui64Until = ui64BenchNow + ui64Cycles;
+    uint64_t ui64Next, ui64Before;
+
+    ui64BenchBusy += ui64Cycles;
+    while (ui64BenchNow < ui64Until)
+    {
+        ui64Next = Bench_nextEvent ();
+        Bench_runLinesTo ((ui64Next > ui64Until) ? ui64Until : ui64Next);
+        if ((bBenchInISR == false) && (Bench_interruptPending () == true))
+        {
+            ui64Before = ui64BenchNow;
+            Bench_runInterrupts ();
+            ui64Until += ui64BenchNow - ui64Before;
+        }
+    }
+
+    if ((bBenchInISR == false) && (ui64BenchNow >= ui64BenchEnd))
+    {
+        longjmp (xBenchEnd, 1);
+    }
+}
+
+/* The gateway task blocked, the CPU sleeps until an interrupt notifies it. */
+static void Bench_idle (void)
+{
+    uint64_t ui64Next;
+
+    while (ui32BenchNotified == 0)
+    {
+        if (Bench_interruptPending () == true)
+        {
+            Bench_runInterrupts ();
+            continue;
+        }
+        ui64Next = Bench_nextEvent ();
+        Bench_runLinesTo ((ui64Next > ui64BenchEnd) ? ui64BenchEnd : ui64Next);
+        if (ui64BenchNow >= ui64BenchEnd)
+        {
+            longjmp (xBenchEnd, 1);
+        }
+    }
+}
+
+/*****************************************************************************/
+/*                              TivaWare Functions                           */
+/*****************************************************************************/
+
+void SysCtlPeripheralEnable (uint32_t ui32Peripheral)
+{
+}
+
+bool SysCtlPeripheralReady (uint32_t ui32Peripheral)
+{
+    return true;
+}
+
+void GPIOPinConfigure (uint32_t ui32PinConfig)
+{
+}
+
+void GPIOPinTypeUART (uint32_t ui32Port, uint8_t ui8Pins)
+{
+}
+
+void IntRegister (uint32_t ui32Interrupt, void (*pfnHandler) (void))
+{
+}
+
+void IntEnable (uint32_t ui32Interrupt)
+{
+}
+
+void IntPrioritySet (uint32_t ui32Interrupt, uint8_t ui8Priority)
+{
+}
+
+void IntPendSet (uint32_t ui32Interrupt)
+{
+    uint32_t i;
+
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        if (xBenchUARTs[i].ui32Interrupt == ui32Interrupt)
+        {
+            xBenchUARTs[i].bPended = true;
+        }
+    }
+    Bench_spend (BENCH_COST_PEND);
+}
+
+void UARTEnable (uint32_t ui32Base)
+{
+}
+
+void UARTFIFOLevelSet (uint32_t ui32Base, uint32_t ui32TxLevel, uint32_t ui32RxLevel)
+{
+}
+
+void UARTIntEnable (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    Bench_find (ui32Base)->ui32Mask |= ui32IntFlags;
+}
+
+uint32_t UARTIntStatus (uint32_t ui32Base, bool bMasked)
+{
+    Bench_UART *psUART = Bench_find (ui32Base);
+
+    Bench_spend (BENCH_COST_UART);
+
+    return (bMasked == true) ? (psUART->ui32Raw & psUART->ui32Mask) : psUART->ui32Raw;
+}
+
+void UARTIntClear (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    Bench_UART *psUART = Bench_find (ui32Base);
+
+    Bench_spend (BENCH_COST_UART);
+    psUART->ui32Raw &= ~ui32IntFlags;
+
+    /* The receive timeout starts over while there is something in the FIFO. */
+    if (((ui32IntFlags & BENCH_INT_RT) != 0) && (psUART->ui32RxCount > 0) && (psUART->bRxTimeoutArmed == false))
+    {
+        psUART->ui64RxTimeoutAt = ui64BenchNow + (32 * psUART->ui64BitCycles);
+        psUART->bRxTimeoutArmed = true;
+    }
+}
+
+bool UARTCharsAvail (uint32_t ui32Base)
+{
+    Bench_spend (BENCH_COST_UART);
+
+    return (Bench_find (ui32Base)->ui32RxCount > 0);
+}
+
+int32_t UARTCharGetNonBlocking (uint32_t ui32Base)
+{
+    Bench_UART *psUART = Bench_find (ui32Base);
+    uint8_t ui8Byte;
+
+    Bench_spend (BENCH_COST_UART);
+    if (psUART->ui32RxCount == 0)
+    {
+        return -1;
+    }
+
+    ui8Byte = psUART->ui8RxFifo[psUART->ui32RxHead];
+    psUART->ui32RxHead = (psUART->ui32RxHead + 1) % BENCH_FIFO_SIZE;
+    if (--psUART->ui32RxCount == 0)
+    {
+        psUART->bRxTimeoutArmed = false;
+    }
+
+    return ui8Byte;
+}
+
+bool UARTSpaceAvail (uint32_t ui32Base)
+{
+    Bench_spend (BENCH_COST_UART);
+
+    return (Bench_find (ui32Base)->ui32TxCount < BENCH_FIFO_SIZE);
+}
+
+bool UARTCharPutNonBlocking (uint32_t ui32Base, unsigned char ucData)
+{
+    Bench_UART *psUART = Bench_find (ui32Base);
+
+    Bench_spend (BENCH_COST_UART);
+    if (psUART->ui32TxCount == BENCH_FIFO_SIZE)
+    {
+        return false;
+    }
+
+    psUART->ui8TxFifo[(psUART->ui32TxHead + psUART->ui32TxCount) % BENCH_FIFO_SIZE] = ucData;
+    psUART->ui32TxCount++;
+    Bench_txStart (psUART, ui64BenchNow);
+
+    return true;
+}
+
+void UARTCharPut (uint32_t ui32Base, unsigned char ucData)
+{
+}
+
+bool Clock_UARTConfigSet (uint32_t ui32Base, uint32_t ui32Baud, uint32_t ui32Config)
+{
+    (void) Bench_find (ui32Base);
+
+    return true;
+}
+
+/*****************************************************************************/
+/*                               Kernel Functions                            */
+/*****************************************************************************/
+
+void Host_enterCritical (void)
+{
+}
+
+void Host_exitCritical (void)
+{
+}
+
+uint32_t Host_getCycles (void)
+{
+    return (uint32_t) ui64BenchNow;
+}
+
+BaseType_t xTaskCreate (TaskFunction_t pxTaskCode, const char *pcName, uint16_t usStackDepth,
+                        void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask)
+{
+    pxBenchTask = pxTaskCode;
+
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle (void)
+{
+    return (TaskHandle_t) &pxBenchTask;
+}
+
+BaseType_t xTaskNotifyIndexedFromISR (TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify,
+                                      uint32_t ulValue, eNotifyAction eAction,
+                                      BaseType_t *pxHigherPriorityTaskWoken)
+{
+    ui32BenchNotified |= ulValue;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+    Bench_spend (BENCH_COST_NOTIFY);
+
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyIndexed (TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify,
+                               uint32_t ulValue, eNotifyAction eAction)
+{
+    ui32BenchNotified |= ulValue;
+    Bench_spend (BENCH_COST_NOTIFY);
+
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTakeIndexed (UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit,
+                                  TickType_t xTicksToWait)
+{
+    /* Only Ring_Wait() takes them, which serial.c does not use. */
+    abort ();
+}
+
+uint32_t ulQueueSelect (TickType_t xTicksToWait)
+{
+    uint32_t ui32Bits;
+
+    Bench_spend (BENCH_COST_SELECT);
+    if ((ui32BenchNotified == 0) && (xTicksToWait != 0))
+    {
+        ui64BenchBlocks++;
+        Bench_spend (BENCH_COST_BLOCK);
+        Bench_idle ();
+        Bench_spend (BENCH_COST_SWITCH);
+    }
+
+    ui32Bits = ui32BenchNotified;
+    ui32BenchNotified = 0;
+
+    return ui32Bits;
+}
+
+/* The cost of the calls of gateway.c to serial.c, through the --wrap of the linker. */
+uint32_t __real_Serial_Read (uint32_t ui32Port, uint8_t *pui8Data, uint32_t ui32Length);
+uint32_t __real_Serial_Write (uint32_t ui32Port, const uint8_t *pui8Data, uint32_t ui32Length);
+uint32_t __real_Serial_Select (TickType_t xTicksToWait);
+void __real_Serial_SelectAdd (uint32_t ui32Port, uint32_t ui32Events);
+
+uint32_t __wrap_Serial_Read (uint32_t ui32Port, uint8_t *pui8Data, uint32_t ui32Length)
+{
+    uint32_t ui32Read = __real_Serial_Read (ui32Port, pui8Data, ui32Length);
+
+    Bench_spend (BENCH_COST_RW + (BENCH_COST_RW_BYTE * ui32Read));
+
+    return ui32Read;
+}
+
+uint32_t __wrap_Serial_Write (uint32_t ui32Port, const uint8_t *pui8Data, uint32_t ui32Length)
+{
+    Bench_spend (BENCH_COST_RW + (BENCH_COST_RW_BYTE * ui32Length));
+
+    return __real_Serial_Write (ui32Port, pui8Data, ui32Length);
+}
+
+uint32_t __wrap_Serial_Select (TickType_t xTicksToWait)
+{
+    Bench_spend (BENCH_COST_SELECT);
+
+    return __real_Serial_Select (xTicksToWait);
+}
+
+void __wrap_Serial_SelectAdd (uint32_t ui32Port, uint32_t ui32Events)
+{
+    Bench_spend (BENCH_COST_SELECT_ADD);
+    __real_Serial_SelectAdd (ui32Port, ui32Events);
+}
+
+/*****************************************************************************/
+/*                                Bench Functions                            */
+/*****************************************************************************/
+
+/* One run of dSeconds, the ports at their rates, each host sending dLoad of its line rate, or bursts of
+ * ui32Burst bytes every ui32PeriodUs from UART1 and UART4 only. Returns false if anything was lost or
+ * out of order. */
+static bool Bench_run (double dSeconds, const uint32_t *pui32Bauds, double dLoad, uint32_t ui32Burst,
+                       uint32_t ui32PeriodUs, bool bTable)
+{
+    Gateway_Stats xGateway;
+    Serial_Stats xSerial;
+    uint64_t ui64Delivered = 0, ui64Capacity = 0, ui64Overruns = 0, ui64Dropped = 0, ui64OutOfOrder = 0;
+    uint32_t i;
+
+    ui64BenchEnd = (uint64_t) (dSeconds * BENCH_CPU_HZ);
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        Bench_UART *psUART = &xBenchUARTs[i];
+
+        psUART->ui32Base = ui32BenchBases[i];
+        psUART->ui32Interrupt = ui32BenchInterrupts[i];
+        psUART->pfnHandler = pfnBenchHandlers[i];
+        psUART->ui32Baud = pui32Bauds[i];
+        psUART->ui64BitCycles = BENCH_CPU_HZ / psUART->ui32Baud;
+        psUART->ui64CharacterCycles = (10 * BENCH_CPU_HZ) / psUART->ui32Baud;
+        psUART->dLoad = dLoad;
+        psUART->ui64NextAt = 1000 + (i * 37);
+        psUART->ui32Burst = ui32Burst;
+        psUART->ui32BurstLeft = ui32Burst;
+        psUART->ui64BurstPeriod = (uint64_t) ui32PeriodUs * (BENCH_CPU_HZ / 1000000);
+        psUART->ui64BurstStart = psUART->ui64NextAt;
+        psUART->bSending = (ui32Burst == 0) || ((i & 1) == 0);
+    }
+
+    if (Gateway_Init () == false)
+    {
+        printf ("Gateway_Init() failed\n");
+        return false;
+    }
+    if (setjmp (xBenchEnd) == 0)
+    {
+        pxBenchTask (NULL);
+    }
+
+    Gateway_getStats (&xGateway);
+    for (i = 0; i < BENCH_UARTS; i++)
+    {
+        Serial_getStats (xGateway.ui32Port[i], &xSerial);
+        ui64Delivered += xBenchUARTs[i].ui64Delivered;
+        ui64Overruns += xBenchUARTs[i].ui64Overruns;
+        ui64Dropped += xSerial.ui32Dropped;
+        ui64OutOfOrder += xBenchUARTs[i].ui64OutOfOrder;
+        ui64Capacity += xBenchUARTs[i].ui32Baud / 10;
+        if (bTable == false)
+        {
+            printf ("  UART%u %7u baud: in %8llu forwarded %8u out %8llu, overruns %llu, ring drops %u, out of order %llu, interrupts %u\n",
+                    xGateway.ui32Port[i], xBenchUARTs[i].ui32Baud, (unsigned long long) xBenchUARTs[i].ui64Generated,
+                    xGateway.ui32Forwarded[i], (unsigned long long) xBenchUARTs[i].ui64Delivered,
+                    (unsigned long long) xBenchUARTs[i].ui64Overruns, xSerial.ui32Dropped,
+                    (unsigned long long) xBenchUARTs[i].ui64OutOfOrder, xSerial.ui32Interrupts);
+        }
+    }
+
+    if (bTable == true)
+    {
+        printf ("  %7u   %8.0f B/s   %5.1f%%   %5.1f%%   %6.1f   %8.2f   %llu/%llu\n",
+                pui32Bauds[0], ui64Delivered / dSeconds, (100.0 * ui64Delivered) / dSeconds / ui64Capacity,
+                (100.0 * ui64BenchBusy) / ui64BenchEnd, (1024.0 * ui64BenchInterrupts) / (ui64Delivered ? ui64Delivered : 1),
+                (1024.0 * xGateway.ui32Wakeups) / (ui64Delivered ? ui64Delivered : 1),
+                (unsigned long long) ui64Overruns, (unsigned long long) ui64Dropped);
+    }
+    else
+    {
+        printf ("%.1f s: out %.0f B/s, %.1f%% of the %llu B/s of the 4 lines, CPU %.1f%%, %.1f interrupts and %.2f wakeups a KB, "
+                "lost %llu (overruns %llu, ring drops %llu), out of order %llu\n",
+                dSeconds, ui64Delivered / dSeconds, (100.0 * ui64Delivered) / dSeconds / ui64Capacity,
+                (unsigned long long) ui64Capacity, (100.0 * ui64BenchBusy) / ui64BenchEnd,
+                (1024.0 * ui64BenchInterrupts) / (ui64Delivered ? ui64Delivered : 1),
+                (1024.0 * xGateway.ui32Wakeups) / (ui64Delivered ? ui64Delivered : 1),
+                (unsigned long long) (ui64Overruns + ui64Dropped), (unsigned long long) ui64Overruns,
+                (unsigned long long) ui64Dropped, (unsigned long long) ui64OutOfOrder);
+    }
+
+    return ((ui64Overruns + ui64Dropped + ui64OutOfOrder) == 0);
+}
+
+/* Bench_run() in a child process, as serial.c and gateway.c can only be initialised once. */
+static bool Bench_fork (double dSeconds, const uint32_t *pui32Bauds, double dLoad, uint32_t ui32Burst,
+                        uint32_t ui32PeriodUs, bool bTable)
+{
+    pid_t xChild;
+    int iStatus;
+
+    fflush (stdout);
+    xChild = fork ();
+    if (xChild == 0)
+    {
+        exit ((Bench_run (dSeconds, pui32Bauds, dLoad, ui32Burst, ui32PeriodUs, bTable) == true) ? 0 : 1);
+    }
+    if ((xChild < 0) || (waitpid (xChild, &iStatus, 0) != xChild) || !WIFEXITED (iStatus))
+    {
+        printf ("the run did not finish\n");
+        return false;
+    }
+
+    return (WEXITSTATUS (iStatus) == 0);
+}
+
+int main (int argc, char *argv[])
+{
+    static const uint32_t ui32Rates[] = { 115200, 460800, 921600, 2000000, 3000000 };
+    static const uint32_t ui32Bursts[] = { 400, 600 };
+    uint32_t ui32Bauds[BENCH_UARTS];
+    uint32_t i, j;
+
+    if (argc >= 7)
+    {
+        for (i = 0; i < BENCH_UARTS; i++)
+        {
+            ui32Bauds[i] = (uint32_t) atoi (argv[2 + i]);
+        }
+
+        return (Bench_run (atof (argv[1]), ui32Bauds, atof (argv[6]), (argc > 7) ? atoi (argv[7]) : 0,
+                           (argc > 8) ? atoi (argv[8]) : 0, false) == true) ? 0 : 1;
+    }
+    if (argc != 1)
+    {
+        fprintf (stderr, "usage: gateway_bench [SECONDS B1 B3 B4 B7 LOAD [BURST PERIOD_US]]\n");
+        return 2;
+    }
+
+    /* The hosts send back to back, every rate but the last has to get through without a loss. */
+    printf ("All four ports at the same rate, each host sending at its line rate, 1 s:\n");
+    printf ("  baud     aggregate out   of lines  CPU     IRQs/KB  wakeups/KB  lost (overrun/ring)\n");
+    for (j = 0; j < sizeof (ui32Rates) / sizeof (ui32Rates[0]); j++)
+    {
+        for (i = 0; i < BENCH_UARTS; i++)
+        {
+            ui32Bauds[i] = ui32Rates[j];
+        }
+        if ((Bench_fork (1.0, ui32Bauds, 1.0, 0, 0, true) == false) && (j != (sizeof (ui32Rates) / sizeof (ui32Rates[0])) - 1))
+        {
+            return 1;
+        }
+    }
+
+    /* UART1 and UART4 at 921600 send bursts every 50 ms to their peers at 115200, eight times slower,
+     * the two rings of 256 bytes and the FIFOs on the way have to hold a burst while it drains. */
+    ui32Bauds[0] = ui32Bauds[2] = 921600;
+    ui32Bauds[1] = ui32Bauds[3] = 115200;
+    for (j = 0; j < sizeof (ui32Bursts) / sizeof (ui32Bursts[0]); j++)
+    {
+        printf ("Bursts of %u bytes every 50 ms from 921600 into 115200, 1 s:\n", ui32Bursts[j]);
+        Bench_fork (1.0, ui32Bauds, 1.0, ui32Bursts[j], 50000, false);
+    }
+
+    return 0;
+}
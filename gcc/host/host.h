@@ -0,0 +1,167 @@
+/*
+ * Host build of the firmware modules that do not touch the hardware, for the
+ * tests of make host-test. This header is forced in front of every file of
+ * the host build, as qemu/board_qemu.h is in the QEMU build. It takes the
+ * include guards of the kernel headers, so the modules include them as they
+ * are, and declares in their place the little of the kernel they use, with
+ * the tasks never started. The TivaWare headers they include are in
+ * host/include. The exclusive access primitives of atomic.h are those of
+ * portmacro.h with the GCC __atomic builtins in place of ldrex and strex, a
+ * weak compare exchange fails now and then like a strex does, so the same
+ * loops run, on threads. The cycle counter and the critical sections are
+ * Host_getCycles(), Host_enterCritical() and Host_exitCritical(), which the
+ * tests that need them define, as they do any task function a module calls.
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* The kernel headers, kept out. */
+#define INC_FREERTOS_H
+#define INC_TASK_H
+#define QUEUE_H
+#define FAST_MUTEX_H
+
+#define pdFALSE                         ((BaseType_t) 0)
+#define pdTRUE                          ((BaseType_t) 1)
+#define pdPASS                          pdTRUE
+#define portMAX_DELAY                   ((TickType_t) 0xFFFFFFFF)
+#define pdMS_TO_TICKS(xTimeInMs)        ((TickType_t) (xTimeInMs))
+#define configASSERT(x)                 assert (x)
+#define configMAX_PRIORITIES            5
+#define configMINIMAL_STACK_SIZE        128
+#define configQUEUE_SELECT_INDEX        1
+#define configUSE_QUEUE_SELECT          1
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY    0xA0
+
+#define portGET_RUN_TIME_COUNTER_VALUE()        Host_getCycles ()
+#define portTASK_DOES_NOT_USE_FLOATING_POINT()
+#define portYIELD_FROM_ISR(xSwitchRequired)     ((void) (xSwitchRequired))
+#define taskENTER_CRITICAL()                    Host_enterCritical ()
+#define taskEXIT_CRITICAL()                     Host_exitCritical ()
+#define taskENTER_CRITICAL_FROM_ISR()           (Host_enterCritical (), (UBaseType_t) 0)
+#define taskEXIT_CRITICAL_FROM_ISR(uxSaved)     ((void) (uxSaved), Host_exitCritical ())
+
+/* Only main() runs, no mutex is ever taken. */
+#define taskSCHEDULER_NOT_STARTED       ((BaseType_t) 1)
+#define taskSCHEDULER_RUNNING           ((BaseType_t) 2)
+#define xTaskGetSchedulerState()        taskSCHEDULER_NOT_STARTED
+
+#define portFORCE_INLINE                inline __attribute__ ((always_inline))
+#define portHAS_EXCLUSIVE_ACCESS        1
+
+#define vFastMutexInit(pxMutex)         (*(pxMutex) = 0)
+#define xFastMutexTake(pxMutex, xWait)  ((void) (pxMutex))
+#define xFastMutexGive(pxMutex)         ((void) (pxMutex))
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+typedef uint32_t FastMutex_t;
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t) (void *);
+
+/* Only its size is ever taken. */
+typedef struct
+{
+    void *pxDummy[24];
+} StaticTask_t;
+
+typedef enum
+{
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+/*****************************************************************************/
+/*                               Host Functions                              */
+/*****************************************************************************/
+
+uint32_t Host_getCycles (void);
+void Host_enterCritical (void);
+void Host_exitCritical (void);
+
+BaseType_t xTaskCreate (TaskFunction_t pxTaskCode, const char *pcName, uint16_t usStackDepth,
+                        void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask);
+void vTaskDelay (TickType_t xTicksToDelay);
+TickType_t xTaskGetTickCount (void);
+TaskHandle_t xTaskGetIdleTaskHandle (void);
+UBaseType_t uxTaskGetStackHighWaterMark (TaskHandle_t xTask);
+void *pvPortMalloc (size_t xWantedSize);
+size_t xPortGetFreeHeapSize (void);
+TaskHandle_t xTaskGetCurrentTaskHandle (void);
+BaseType_t xTaskNotifyIndexed (TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify,
+                               uint32_t ulValue, eNotifyAction eAction);
+BaseType_t xTaskNotifyIndexedFromISR (TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify,
+                                      uint32_t ulValue, eNotifyAction eAction,
+                                      BaseType_t *pxHigherPriorityTaskWoken);
+uint32_t ulTaskNotifyTakeIndexed (UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit,
+                                  TickType_t xTicksToWait);
+uint32_t ulQueueSelect (TickType_t xTicksToWait);
+
+/*****************************************************************************/
+/*                               Port Functions                              */
+/*****************************************************************************/
+
+/* Store ulNew in *pulDestination only if it still holds ulExpected. */
+static portFORCE_INLINE BaseType_t xPortCompareAndSwap (volatile uint32_t *pulDestination,
+                                                        uint32_t ulExpected, uint32_t ulNew)
+{
+    uint32_t ulOld;
+
+    do
+    {
+        ulOld = __atomic_load_n (pulDestination, __ATOMIC_SEQ_CST);
+        if (ulOld != ulExpected)
+        {
+            return pdFALSE;
+        }
+    } while (!__atomic_compare_exchange_n (pulDestination, &ulOld, ulNew, 1, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
+
+    return pdTRUE;
+}
+
+/* The other operations, each returns the value *pulDestination held before. */
+#define HOST_ATOMIC_OPERATION(xName, xNewValue)                                                     \
+static portFORCE_INLINE uint32_t xName (volatile uint32_t *pulDestination, uint32_t ulValue)       \
+{                                                                                                   \
+    uint32_t ulOld;                                                                                 \
+                                                                                                    \
+    do                                                                                              \
+    {                                                                                               \
+        ulOld = __atomic_load_n (pulDestination, __ATOMIC_SEQ_CST);                                 \
+    } while (!__atomic_compare_exchange_n (pulDestination, &ulOld, (xNewValue), 1,                  \
+                                           __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));                    \
+                                                                                                    \
+    return ulOld;                                                                                   \
+}
+
+HOST_ATOMIC_OPERATION (ulPortAtomicSwap, ulValue)
+HOST_ATOMIC_OPERATION (ulPortAtomicAdd, ulOld + ulValue)
+HOST_ATOMIC_OPERATION (ulPortAtomicOR, ulOld | ulValue)
+HOST_ATOMIC_OPERATION (ulPortAtomicAND, ulOld & ulValue)
+HOST_ATOMIC_OPERATION (ulPortAtomicNAND, ~(ulOld & ulValue))
+HOST_ATOMIC_OPERATION (ulPortAtomicXOR, ulOld ^ ulValue)
+
+#endif /* HOST_H */
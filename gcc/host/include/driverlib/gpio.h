@@ -0,0 +1,22 @@
+/*
+ * The driverlib functions of gpio.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_GPIO_H
+#define HOST_GPIO_H
+
+#include <stdint.h>
+
+#define GPIO_PIN_0              0x00000001
+#define GPIO_PIN_1              0x00000002
+#define GPIO_PIN_2              0x00000004
+#define GPIO_PIN_3              0x00000008
+#define GPIO_PIN_4              0x00000010
+#define GPIO_PIN_5              0x00000020
+#define GPIO_PIN_6              0x00000040
+#define GPIO_PIN_7              0x00000080
+
+void GPIOPinConfigure (uint32_t ui32PinConfig);
+void GPIOPinTypeUART (uint32_t ui32Port, uint8_t ui8Pins);
+
+#endif /* HOST_GPIO_H */
@@ -0,0 +1,15 @@
+/*
+ * The driverlib functions of interrupt.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_INTERRUPT_H
+#define HOST_INTERRUPT_H
+
+#include <stdint.h>
+
+void IntRegister (uint32_t ui32Interrupt, void (*pfnHandler) (void));
+void IntEnable (uint32_t ui32Interrupt);
+void IntPendSet (uint32_t ui32Interrupt);
+void IntPrioritySet (uint32_t ui32Interrupt, uint8_t ui8Priority);
+
+#endif /* HOST_INTERRUPT_H */
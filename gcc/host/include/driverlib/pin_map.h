@@ -0,0 +1,17 @@
+/*
+ * The pin functions of pin_map.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_PIN_MAP_H
+#define HOST_PIN_MAP_H
+
+#define GPIO_PB0_U1RX           0x00010001
+#define GPIO_PB1_U1TX           0x00010401
+#define GPIO_PC4_U4RX           0x00021008
+#define GPIO_PC5_U4TX           0x00021408
+#define GPIO_PC6_U3RX           0x00021801
+#define GPIO_PC7_U3TX           0x00021C01
+#define GPIO_PE0_U7RX           0x00040001
+#define GPIO_PE1_U7TX           0x00040401
+
+#endif /* HOST_PIN_MAP_H */
@@ -0,0 +1,26 @@
+/*
+ * The driverlib functions of sysctl.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_SYSCTL_H
+#define HOST_SYSCTL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SYSCTL_PERIPH_GPIOB     0xf0000801
+#define SYSCTL_PERIPH_GPIOC     0xf0000802
+#define SYSCTL_PERIPH_GPIOE     0xf0000804
+#define SYSCTL_PERIPH_UART0     0xf0001800
+#define SYSCTL_PERIPH_UART1     0xf0001801
+#define SYSCTL_PERIPH_UART2     0xf0001802
+#define SYSCTL_PERIPH_UART3     0xf0001803
+#define SYSCTL_PERIPH_UART4     0xf0001804
+#define SYSCTL_PERIPH_UART5     0xf0001805
+#define SYSCTL_PERIPH_UART6     0xf0001806
+#define SYSCTL_PERIPH_UART7     0xf0001807
+
+void SysCtlPeripheralEnable (uint32_t ui32Peripheral);
+bool SysCtlPeripheralReady (uint32_t ui32Peripheral);
+
+#endif /* HOST_SYSCTL_H */
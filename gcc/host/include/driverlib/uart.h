@@ -0,0 +1,33 @@
+/*
+ * The driverlib functions of uart.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_UART_H
+#define HOST_UART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UART_INT_RT             0x040
+#define UART_INT_TX             0x020
+#define UART_INT_RX             0x010
+
+#define UART_CONFIG_WLEN_8      0x00000060
+#define UART_CONFIG_STOP_ONE    0x00000000
+#define UART_CONFIG_PAR_NONE    0x00000000
+
+#define UART_FIFO_TX2_8         0x00000001
+#define UART_FIFO_RX4_8         0x00000010
+
+void UARTCharPut (uint32_t ui32Base, unsigned char ucData);
+bool UARTCharPutNonBlocking (uint32_t ui32Base, unsigned char ucData);
+int32_t UARTCharGetNonBlocking (uint32_t ui32Base);
+bool UARTCharsAvail (uint32_t ui32Base);
+bool UARTSpaceAvail (uint32_t ui32Base);
+void UARTEnable (uint32_t ui32Base);
+void UARTFIFOLevelSet (uint32_t ui32Base, uint32_t ui32TxLevel, uint32_t ui32RxLevel);
+void UARTIntEnable (uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t UARTIntStatus (uint32_t ui32Base, bool bMasked);
+void UARTIntClear (uint32_t ui32Base, uint32_t ui32IntFlags);
+
+#endif /* HOST_UART_H */
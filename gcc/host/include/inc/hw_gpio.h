@@ -0,0 +1,10 @@
+/*
+ * The GPIO register offsets of hw_gpio.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_HW_GPIO_H
+#define HOST_HW_GPIO_H
+
+#define GPIO_O_DATA     0x00000000
+
+#endif /* HOST_HW_GPIO_H */
@@ -0,0 +1,17 @@
+/*
+ * The interrupt numbers of hw_ints.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_HW_INTS_H
+#define HOST_HW_INTS_H
+
+#define INT_UART0               21
+#define INT_UART1               22
+#define INT_UART2               49
+#define INT_UART3               75
+#define INT_UART4               76
+#define INT_UART5               77
+#define INT_UART6               78
+#define INT_UART7               79
+
+#endif /* HOST_HW_INTS_H */
@@ -0,0 +1,21 @@
+/*
+ * The peripheral base addresses of hw_memmap.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_HW_MEMMAP_H
+#define HOST_HW_MEMMAP_H
+
+#define GPIO_PORTA_BASE         0x40004000
+#define GPIO_PORTB_BASE         0x40005000
+#define GPIO_PORTC_BASE         0x40006000
+#define GPIO_PORTE_BASE         0x40024000
+#define UART0_BASE              0x4000C000
+#define UART1_BASE              0x4000D000
+#define UART2_BASE              0x4000E000
+#define UART3_BASE              0x4000F000
+#define UART4_BASE              0x40010000
+#define UART5_BASE              0x40011000
+#define UART6_BASE              0x40012000
+#define UART7_BASE              0x40013000
+
+#endif /* HOST_HW_MEMMAP_H */
@@ -0,0 +1,15 @@
+/*
+ * The register access of hw_types.h the host build uses, see host.h.
+ */
+
+#ifndef HOST_HW_TYPES_H
+#define HOST_HW_TYPES_H
+
+#include <stdint.h>
+
+/* Every register read goes to the test, which has the hardware. */
+uint32_t Host_readRegister (uint32_t ui32Address);
+
+#define HWREG(x)    Host_readRegister (x)
+
+#endif /* HOST_HW_TYPES_H */
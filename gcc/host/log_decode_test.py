@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+#
+# Host test of log_decode.py on the records of log.c: runs log_test, which
+# writes them with Log_write() into a capture with the lines they stand for,
+# puts its format strings in the .logstr section of a 32 bit ELF file built
+# here, with its string constants in an allocated .rodata, and checks that
+# the decoder prints those lines from the capture.
+#
+#   python3 host/log_decode_test.py build/host/log_test
+#
+
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DECODER = os.path.join(HERE, "..", "..", "FreeRTOS", "log_decode.py")
+
+# Where log_test.c takes its string constants to be.
+RODATA_ADDRESS = 0x1000
+
+SHT_PROGBITS = 1
+SHT_STRTAB = 3
+SHF_ALLOC = 2
+
+
+def write_elf(path, sections):
+    """A 32 bit little endian ELF file of nothing but sections, (name, address, flags, data) each."""
+    names = b"\0.shstrtab\0"
+    offsets = []
+    for name, _, _, _ in sections:
+        offsets.append(len(names))
+        names += name.encode() + b"\0"
+
+    header = bytearray(52)
+    header[:7] = b"\x7fELF\x01\x01\x01"
+    body = names
+    headers = bytes(40) + struct.pack("<10I", 1, SHT_STRTAB, 0, 0, 52, len(names), 0, 0, 1, 0)
+    for (name, address, flags, data), name_offset in zip(sections, offsets):
+        headers += struct.pack("<10I", name_offset, SHT_PROGBITS, flags, address, 52 + len(body), len(data), 0, 0, 1, 0)
+        body += data
+    struct.pack_into("<I", header, 0x20, 52 + len(body))
+    struct.pack_into("<HHH", header, 0x2E, 40, 2 + len(sections), 1)
+
+    with open(path, "wb") as f:
+        f.write(bytes(header) + body + headers)
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write("usage: log_decode_test.py <log_test>\n")
+        return 2
+
+    with tempfile.TemporaryDirectory() as directory:
+        subprocess.run([sys.argv[1], directory], check=True)
+
+        def read(name):
+            with open(os.path.join(directory, name), "rb") as f:
+                return f.read()
+
+        elf = os.path.join(directory, "test.elf")
+        write_elf(elf, [(".logstr", 0, 0, read("logstr.bin")),
+                        (".rodata", RODATA_ADDRESS, SHF_ALLOC, read("rodata.bin"))])
+
+        result = subprocess.run([sys.executable, DECODER, elf, os.path.join(directory, "capture.bin"), "--clock", "0"],
+                                stdout=subprocess.PIPE, stderr=subprocess.PIPE, check=True)
+        got = result.stdout.decode("latin-1").splitlines()
+        expected = read("expected.txt").decode("latin-1").splitlines()
+
+    failures = 0
+    for i in range(max(len(got), len(expected))):
+        line = got[i] if i < len(got) else "<nothing>"
+        want = expected[i] if i < len(expected) else "<nothing>"
+        if line != want:
+            failures += 1
+            if failures <= 10:
+                print("FAIL line %d: %r instead of %r" % (i + 1, line, want))
+
+    print("log_decode_test: %d lines, %d failed" % (len(expected), failures))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,339 @@
+/*
+ * Host half of the test of log.c and log_decode.py. This writes records with
+ * the Log_write() of log.c, on a cycle counter it moves, into a capture with
+ * console text and stray bytes between them like the UART gets, and the
+ * lines log_decode.py has to turn it into, built with printf(). The records
+ * pass sequence number 0 several times, the counter wraps, the ring fills
+ * up and drops some, and one record is cut to its first byte.
+ *
+ *   log_test <directory>
+ *
+ * leaves logstr.bin, rodata.bin, capture.bin and expected.txt there, for
+ * log_decode_test.py, which puts the first two in an ELF file and runs the
+ * decoder on the capture.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/* The module itself, for its ring. */
+#include "../../FreeRTOS/log.c"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* Where rodata.bin goes in the ELF file, the address a %s argument points to. */
+#define TEST_RODATA_ADDRESS     0x1000
+
+#define TEST_LINE_SIZE          256
+#define TEST_PENDING_SIZE       16384
+
+/*****************************************************************************/
+/*                                   Types                                   */
+/*****************************************************************************/
+
+typedef struct
+{
+    /* What LOG() is given, and what log_decode.py prints for it through printf(). */
+    const char *pcFormat;
+    const char *pcExpected;
+    uint32_t ui32Count;
+} Test_Case;
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* The ID of a format is its offset in pcTestStrings, which starts with a 0 like .logstr
+ * of the firmware, the first strings are small enough for a record to be cut. */
+static const Test_Case xTestCases[] =
+{
+    { "boot %u", "boot %u", 1 },
+    { "no arguments here", "no arguments here", 0 },
+    { "%d %i %u %x %X %c", "%d %i %u %x %X %c", 6 },
+    { "The last color preference %c will be unable to be used.", "The last color preference %c will be unable to be used.", 1 },
+    { "%s is %08x, %p, 100%%", "%s is %08x, 0x%08x, 100%%", 3 },
+    { "negative %d small %u\r\n", "negative %d small %u", 2 },
+};
+
+#define TEST_BOOT       0
+#define TEST_NONE       1
+#define TEST_SIX        2
+#define TEST_COLOR      3
+#define TEST_STRING     4
+#define TEST_NEGATIVE   5
+
+static char pcTestStrings[512];
+static uint32_t ui32TestIDs[sizeof (xTestCases) / sizeof (xTestCases[0])];
+
+static const char pcTestRodata[] = "Task_LOG";
+
+/* The simulated cycle counter, and how far it really went. */
+static uint64_t ui64TestTime = 12345;
+
+static FILE *pxTestCapture;
+static FILE *pxTestExpected;
+
+/* The lines of the records in the ring, written to expected.txt when the ring is. */
+static char pcTestPending[TEST_PENDING_SIZE];
+static uint32_t ui32TestPendingLength;
+
+static uint32_t ui32TestSequence = 0;
+static uint32_t ui32TestDropped = 0;
+static uint32_t ui32TestRecords = 0;
+static uint32_t ui32TestRecordBytes = 0;
+static uint32_t ui32TestColorBytes = 0;
+
+/*****************************************************************************/
+/*                               Host Functions                              */
+/*****************************************************************************/
+
+uint32_t Host_getCycles (void)
+{
+    return (uint32_t) ui64TestTime;
+}
+
+void Host_enterCritical (void)
+{
+}
+
+void Host_exitCritical (void)
+{
+}
+
+/* Log_Init() creates the task, which never runs here, the ring is emptied by Test_drain(). */
+BaseType_t xTaskCreate (TaskFunction_t pxTaskCode, const char *pcName, uint16_t usStackDepth,
+                        void *pvParameters, UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask)
+{
+    return pdPASS;
+}
+
+void vTaskDelay (TickType_t xTicksToDelay)
+{
+}
+
+/*****************************************************************************/
+/*                               Test Functions                              */
+/*****************************************************************************/
+
+static void Test_pending (const char *pcFormat, ...)
+{
+    va_list xArgs;
+
+    va_start (xArgs, pcFormat);
+    ui32TestPendingLength += vsnprintf (&pcTestPending[ui32TestPendingLength],
+                                        TEST_PENDING_SIZE - ui32TestPendingLength, pcFormat, xArgs);
+    va_end (xArgs);
+}
+
+/* LOG() of case ui32Case with its arguments, after ui32Delta cycles. */
+static bool Test_log (uint32_t ui32Case, uint32_t ui32Delta, uint32_t ui32Arg1, uint32_t ui32Arg2, uint32_t ui32Arg3,
+                      uint32_t ui32Arg4, uint32_t ui32Arg5, uint32_t ui32Arg6)
+{
+    const Test_Case *pxCase = &xTestCases[ui32Case];
+    uint32_t ui32Before = Ring_Count (&xLogRing);
+    char pcText[TEST_LINE_SIZE];
+    bool bWritten;
+
+    ui64TestTime += ui32Delta;
+    bWritten = Log_write ((const char *) (uintptr_t) ui32TestIDs[ui32Case], pxCase->ui32Count,
+                          ui32Arg1, ui32Arg2, ui32Arg3, ui32Arg4, ui32Arg5, ui32Arg6);
+    ui32TestSequence = (ui32TestSequence + 1) & LOG_SEQUENCE_MASK;
+
+    if (bWritten == false)
+    {
+        ui32TestDropped++;
+        return false;
+    }
+
+    if (ui32TestDropped != 0)
+    {
+        Test_pending ("<%u records dropped>\n", ui32TestDropped);
+        ui32TestDropped = 0;
+    }
+
+    /* The decoder has the time on the grid of LOG_STAMP_SHIFT the record is on. */
+    if (ui32Case == TEST_STRING)
+    {
+        snprintf (pcText, sizeof (pcText), pxCase->pcExpected, pcTestRodata, ui32Arg2, ui32Arg3);
+    }
+    else
+    {
+        snprintf (pcText, sizeof (pcText), pxCase->pcExpected, ui32Arg1, ui32Arg2, ui32Arg3, ui32Arg4, ui32Arg5, ui32Arg6);
+    }
+    Test_pending ("[%10llu] %s\n", (unsigned long long) (ui64TestTime - (uint32_t) ((uint32_t) ui64TestTime - ui32LogStamp)),
+                  pcText);
+
+    ui32TestRecords++;
+    ui32TestRecordBytes += Ring_Count (&xLogRing) - ui32Before;
+    if (ui32Case == TEST_COLOR)
+    {
+        ui32TestColorBytes = Ring_Count (&xLogRing) - ui32Before;
+    }
+
+    return true;
+}
+
+/* What the log task does, and the decoder prints them at that point of the capture. */
+static void Test_drain (void)
+{
+    uint8_t ui8Chunk[LOG_CHUNK];
+    uint32_t ui32Length;
+
+    while ((ui32Length = Ring_Read (&xLogRing, ui8Chunk, LOG_CHUNK)) != 0)
+    {
+        fwrite (ui8Chunk, 1, ui32Length, pxTestCapture);
+    }
+    fwrite (pcTestPending, 1, ui32TestPendingLength, pxTestExpected);
+    ui32TestPendingLength = 0;
+}
+
+static void Test_text (const char *pcText)
+{
+    fputs (pcText, pxTestCapture);
+    fputs (pcText, pxTestExpected);
+}
+
+/* Bytes of a protocol frame, all out of ASCII, which the decoder drops, some of them look like a sync byte. */
+static void Test_junk (void)
+{
+    static const uint8_t ui8Junk[] = { 0xA0, 0xFF, 0xFF, 0xB7, 0xA3, 0xF0, 0x81, 0xBF, 0x80, 0x80 };
+
+    fwrite (ui8Junk, 1, sizeof (ui8Junk), pxTestCapture);
+}
+
+static FILE *Test_open (const char *pcDirectory, const char *pcName)
+{
+    char pcPath[TEST_LINE_SIZE];
+    FILE *pxFile;
+
+    snprintf (pcPath, sizeof (pcPath), "%s/%s", pcDirectory, pcName);
+    pxFile = fopen (pcPath, "wb");
+    if (pxFile == NULL)
+    {
+        perror (pcPath);
+    }
+
+    return pxFile;
+}
+
+static void Test_strings (const char *pcDirectory)
+{
+    uint32_t ui32Length = 1, i;
+    FILE *pxFile;
+
+    for (i = 0; i < sizeof (xTestCases) / sizeof (xTestCases[0]); i++)
+    {
+        ui32TestIDs[i] = ui32Length;
+        strcpy (&pcTestStrings[ui32Length], xTestCases[i].pcFormat);
+        ui32Length += strlen (xTestCases[i].pcFormat) + 1;
+    }
+
+    pxFile = Test_open (pcDirectory, "logstr.bin");
+    fwrite (pcTestStrings, 1, ui32Length, pxFile);
+    fclose (pxFile);
+    pxFile = Test_open (pcDirectory, "rodata.bin");
+    fwrite (pcTestRodata, 1, sizeof (pcTestRodata), pxFile);
+    fclose (pxFile);
+}
+
+int main (int argc, char *argv[])
+{
+    static Print_Sink xSink;
+    uint8_t ui8Record[LOG_HEADER_MAX + 5 * LOG_ARGS_MAX];
+    uint32_t i, ui32Length;
+
+    if (argc != 2)
+    {
+        fprintf (stderr, "usage: log_test <directory>\n");
+        return 2;
+    }
+
+    Test_strings (argv[1]);
+    pxTestCapture = Test_open (argv[1], "capture.bin");
+    pxTestExpected = Test_open (argv[1], "expected.txt");
+    Log_Init (&xSink);
+
+    /* The first record, of sequence number 0, and text around it. */
+    Test_text ("FreeRTOS console\r\n");
+    Test_log (TEST_BOOT, 0, 1, 0, 0, 0, 0, 0);
+    Test_drain ();
+    Test_text ("> ");
+
+    /* Every length of the time and of the arguments, with sequence number 0 coming back twice and the
+     * counter wrapping, 20 s a few times over. */
+    for (i = 0; i < 80; i++)
+    {
+        static const uint32_t ui32Deltas[] = { 5, 1000, 130000, 24000000, 400000000, 1600000000, 77, 2047 };
+
+        switch (i % 5)
+        {
+        case 0:
+            Test_log (TEST_SIX, ui32Deltas[i % 8], (uint32_t) -1, 0x80000000u, 0x7F, 0x80, 0xFFFFFFFFu, 'z');
+            break;
+        case 1:
+            Test_log (TEST_COLOR, ui32Deltas[i % 8], 'r', 0, 0, 0, 0, 0);
+            break;
+        case 2:
+            Test_log (TEST_STRING, ui32Deltas[i % 8], TEST_RODATA_ADDRESS, 0x1234ABCD, 0x20000400, 0, 0, 0);
+            break;
+        case 3:
+            Test_log (TEST_NEGATIVE, ui32Deltas[i % 8], (uint32_t) -(int32_t) i, i * 1000, 0, 0, 0, 0);
+            break;
+        default:
+            Test_log (TEST_NONE, ui32Deltas[i % 8], 0, 0, 0, 0, 0, 0);
+            break;
+        }
+        if ((i % 7) == 6)
+        {
+            Test_drain ();
+            Test_text ("help\r\n");
+            Test_junk ();
+        }
+    }
+    Test_drain ();
+
+    /* The ring fills up, 10 records are dropped, and the time goes on from the last one written. */
+    while (Test_log (TEST_SIX, 3000, 1, 2, 3, 4, 5, 6) == true)
+    {
+    }
+    for (i = 0; i < 9; i++)
+    {
+        Test_log (TEST_SIX, 3000, 1, 2, 3, 4, 5, 6);
+    }
+    Test_drain ();
+    Test_log (TEST_COLOR, 3000, 'g', 0, 0, 0, 0, 0);
+    Test_drain ();
+
+    /* A record cut to its sync byte on the way, right before one of sequence number 0, the decoder counts
+     * it dropped. */
+    while (ui32TestSequence != LOG_SEQUENCE_MASK)
+    {
+        Test_log (TEST_NONE, 100000, 0, 0, 0, 0, 0, 0);
+        Test_drain ();
+    }
+    ui64TestTime += 5000;
+    Log_write ((const char *) (uintptr_t) ui32TestIDs[TEST_COLOR], 1, 'b');
+    ui32TestSequence = 0;
+    ui32Length = Ring_Read (&xLogRing, ui8Record, sizeof (ui8Record));
+    fwrite (ui8Record, 1, 1, pxTestCapture);
+    ui32TestDropped = 1;
+    Test_log (TEST_NEGATIVE, 20000, (uint32_t) -5, 5, 0, 0, 0, 0);
+    Test_text ("\r\nbye\r\n");
+    Test_drain ();
+
+    fclose (pxTestCapture);
+    fclose (pxTestExpected);
+
+    printf ("log_test: %u records, %.1f bytes each on average, %u bytes for the 55 character message\n",
+            ui32TestRecords, (double) ui32TestRecordBytes / ui32TestRecords, ui32TestColorBytes);
+
+    return (ui32Length > 1) ? 0 : 1;
+}
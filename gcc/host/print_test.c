@@ -0,0 +1,198 @@
+/*
+ * Host test of print.c: every conversion it shares with printf() is checked
+ * against snprintf() of the C library, over a sweep of the flags, widths,
+ * precisions and values, then %q, %p, the cut at the size of the buffer and
+ * the writes to a sink are checked against what they have to give.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdio.h>
+#include <string.h>
+
+/* Header Files Includes.  */
+#include "print.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define TEST_LINE_SIZE      256
+
+/* Formats and compares both, the arguments are read twice. */
+#define TEST_LIBC(pcFormat, ...)                                                            \
+    do                                                                                      \
+    {                                                                                       \
+        char pcPrint[TEST_LINE_SIZE], pcLibc[TEST_LINE_SIZE];                               \
+        uint32_t ui32Print = Print_snprintf (pcPrint, TEST_LINE_SIZE, pcFormat, __VA_ARGS__); \
+        int iLibc = snprintf (pcLibc, TEST_LINE_SIZE, pcFormat, __VA_ARGS__);               \
+        Test_compare (pcFormat, pcPrint, ui32Print, pcLibc, (uint32_t) iLibc);              \
+    } while (0)
+
+/* Compares with the whole of what it has to give. */
+#define TEST_OWN(pcName, pcGot, ui32Got, pcExpected)                                        \
+    Test_compare (pcName, pcGot, ui32Got, pcExpected, (uint32_t) strlen (pcExpected))
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+static uint32_t ui32TestCases = 0;
+static uint32_t ui32TestFailures = 0;
+
+static const char *const pcTestFlags[] = { "", "-", "0", "+", "-0", "+0", "-+", "0-+" };
+static const char *const pcTestWidths[] = { "", "1", "5", "12" };
+static const char *const pcTestPrecisions[] = { "", ".", ".0", ".1", ".3", ".10" };
+static const char pcTestConversions[] = "diuxX";
+static const int32_t i32TestValues[] =
+{
+    0, 1, -1, 7, -7, 9, 10, 99, 100, 12345, -12345, 2147483647, -2147483647 - 1, (int32_t) 0xDEADBEEF
+};
+
+/* What the sink of Test_sink got. */
+static char pcTestSink[1024];
+static uint32_t ui32TestSinkLength;
+static uint32_t ui32TestSinkWrites;
+
+/*****************************************************************************/
+/*                               Test Functions                              */
+/*****************************************************************************/
+
+/* Print_UARTWrite() is in print.c, there is no UART here. */
+void UARTCharPut (uint32_t ui32Base, unsigned char ucData)
+{
+    (void) ui32Base;
+    putchar (ucData);
+}
+
+static void Test_compare (const char *pcFormat, const char *pcGot, uint32_t ui32Got,
+                          const char *pcExpected, uint32_t ui32Expected)
+{
+    ui32TestCases++;
+    if ((strcmp (pcGot, pcExpected) != 0) || (ui32Got != ui32Expected))
+    {
+        ui32TestFailures++;
+        printf ("FAIL \"%s\": \"%s\" (%u) instead of \"%s\" (%u)\n", pcFormat, pcGot, ui32Got, pcExpected, ui32Expected);
+    }
+}
+
+static void Test_sink (void *pvContext, const char *pcData, uint32_t ui32Length)
+{
+    (void) pvContext;
+    if ((ui32TestSinkLength + ui32Length) < sizeof (pcTestSink))
+    {
+        memcpy (&pcTestSink[ui32TestSinkLength], pcData, ui32Length);
+        ui32TestSinkLength += ui32Length;
+        pcTestSink[ui32TestSinkLength] = '\0';
+    }
+    ui32TestSinkWrites++;
+}
+
+/* Every flag, width and precision with every value, for each integer conversion. */
+static void Test_sweep (void)
+{
+    char pcFormat[32];
+    uint32_t f, w, p, c, v;
+
+    for (c = 0; pcTestConversions[c] != '\0'; c++)
+    {
+        for (f = 0; f < sizeof (pcTestFlags) / sizeof (pcTestFlags[0]); f++)
+        {
+            for (w = 0; w < sizeof (pcTestWidths) / sizeof (pcTestWidths[0]); w++)
+            {
+                for (p = 0; p < sizeof (pcTestPrecisions) / sizeof (pcTestPrecisions[0]); p++)
+                {
+                    snprintf (pcFormat, sizeof (pcFormat), "[%%%s%s%s%c]",
+                              pcTestFlags[f], pcTestWidths[w], pcTestPrecisions[p], pcTestConversions[c]);
+                    for (v = 0; v < sizeof (i32TestValues) / sizeof (i32TestValues[0]); v++)
+                    {
+                        TEST_LIBC (pcFormat, i32TestValues[v]);
+                    }
+                }
+            }
+        }
+    }
+
+    /* '*' for both, a negative width is the '-' flag and a negative precision is none. */
+    for (w = 0; w < 5; w++)
+    {
+        for (p = 0; p < 5; p++)
+        {
+            TEST_LIBC ("[%*.*d]", (int) w * 3 - 6, (int) p * 2 - 3, -42);
+            TEST_LIBC ("[%-*.*x]", (int) w * 3 - 6, (int) p * 2 - 3, 0xABu);
+        }
+    }
+}
+
+static void Test_fixed (void)
+{
+    TEST_LIBC ("%d %u %x %X", 0, 0u, 0u, 0u);
+    TEST_LIBC ("%d %d %d %d", 1, -1, 2147483647, -2147483647 - 1);
+    TEST_LIBC ("%c%c|%3c|%-3c|", 'a', 'b', 'x', 'y');
+    TEST_LIBC ("%s|%10s|%-10s|%.3s|%*s|%.0s|", "abc", "hi", "hi", "abcdef", 4, "z", "gone");
+    TEST_LIBC ("100%% %s", "done");
+    TEST_LIBC ("%ld %lu %hd", 7L, 8UL, 9);
+    TEST_LIBC ("Task %s, load %% %u, stack %u, stamp %08x, delta %d\n\r", "Task_UART_RECEIVE", 42u, 96u, 0x1234u, -3);
+}
+
+/* The digits of a lot of values, in both directions of the pairs table. */
+static void Test_values (void)
+{
+    uint32_t v;
+
+    for (v = 0; v < 200000; v += 7)
+    {
+        TEST_LIBC ("%u %d %x", v * 21013u, -(int32_t) v * 3, v * 2654435761u);
+    }
+}
+
+/* What printf() does not have, or does not give the same. */
+static void Test_own (void)
+{
+    char pcLine[TEST_LINE_SIZE];
+    Print_Sink xSink;
+    uint32_t ui32Length;
+
+    ui32Length = Print_snprintf (pcLine, TEST_LINE_SIZE, "%.3q|%.2q|%.3q|%q|%.1q|%08.3q|%.9q|%6.2q|%-8.1q|",
+                                 1234, -5, 7, 12, -100, -1500, 1, -123, 5);
+    TEST_OWN ("%q", pcLine, ui32Length, "1.234|-0.05|0.007|12|-10.0|-001.500|0.000000001| -1.23|0.5     |");
+    ui32Length = Print_snprintf (pcLine, TEST_LINE_SIZE, "%.3q", -2147483647 - 1);
+    TEST_OWN ("%.3q of INT32_MIN", pcLine, ui32Length, "-2147483.648");
+
+    ui32Length = Print_snprintf (pcLine, TEST_LINE_SIZE, "%p|%12p|", (void *) 0x20001234, (void *) 0x2C);
+    TEST_OWN ("%p", pcLine, ui32Length, "0x20001234|  0x0000002c|");
+
+    /* Cut at the size, with the length of the whole output returned. */
+    ui32Length = Print_snprintf (pcLine, 5, "%d", 123456);
+    Test_compare ("cut at 5", pcLine, ui32Length, "1234", 6);
+    ui32Length = Print_snprintf (pcLine, 0, "%d", 12);
+    Test_compare ("size 0", "", ui32Length, "", 2);
+
+    /* A line longer than the buffer of the call goes to the sink in several writes, all of it. */
+    Print_SinkInit (&xSink, Test_sink, NULL);
+    ui32Length = Print_printf (&xSink, "long line %s %u %s\n", "0123456789012345678901234567890123456789", 12345u,
+                               "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz");
+    TEST_OWN ("sink", pcTestSink, ui32Length,
+              "long line 0123456789012345678901234567890123456789 12345 "
+              "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz\n");
+    if (ui32TestSinkWrites < 2)
+    {
+        ui32TestFailures++;
+        printf ("FAIL sink: one write for %u characters, more than a buffer\n", ui32Length);
+    }
+}
+
+int main (void)
+{
+    Test_fixed ();
+    Test_sweep ();
+    Test_values ();
+    Test_own ();
+
+    printf ("print_test: %u cases, %u failed\n", ui32TestCases, ui32TestFailures);
+
+    return (ui32TestFailures == 0) ? 0 : 1;
+}
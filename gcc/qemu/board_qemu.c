@@ -0,0 +1,134 @@
+/*
+ * Board support for QEMU's lm3s6965evb machine, see board_qemu.h.
+ *
+ * The functions named __wrap_X take the place of X everywhere else in the
+ * image, the Makefile links with --wrap=X, and reach the original as
+ * __real_X.
+ */
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Header Files Includes.  */
+#include "board_qemu.h"
+
+/* TivaWare includes.  */
+#include "inc/hw_memmap.h"
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+#define BOARD_SYSTICK_RELOAD       (*((volatile uint32_t *) 0xE000E014))
+#define BOARD_SYSTICK_CURRENT      (*((volatile uint32_t *) 0xE000E018))
+#define BOARD_INT_CTRL             (*((volatile uint32_t *) 0xE000ED04))
+#define BOARD_INT_CTRL_PENDSTSET   0x04000000
+
+/* Timer 0 to 5, one every 4KB from TIMER0_BASE. */
+#define BOARD_TIMERS               6
+#define BOARD_TIMER(ui32Base)      (((ui32Base) - TIMER0_BASE) >> 12)
+
+/*****************************************************************************/
+/*                              Global Variables                             */
+/*****************************************************************************/
+
+/* Cycles counted by the SysTick up to its last reload. */
+static volatile uint32_t ui32BoardCycleBase = 0;
+
+/* Load value of each timer, and the cycle count when it was last enabled. */
+static uint32_t ui32BoardTimerLoad[BOARD_TIMERS];
+static uint32_t ui32BoardTimerStart[BOARD_TIMERS];
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+void __real_xPortSysTickHandler (void);
+void __real_TimerLoadSet (uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+void __real_TimerEnable (uint32_t ui32Base, uint32_t ui32Timer);
+uint32_t __real_TimerValueGet (uint32_t ui32Base, uint32_t ui32Timer);
+
+/*****************************************************************************/
+/*                                Board Functions                            */
+/*****************************************************************************/
+
+/* The SysTick vector, each tick is one more reload counted. */
+void __wrap_xPortSysTickHandler (void)
+{
+    ui32BoardCycleBase += BOARD_SYSTICK_RELOAD + 1;
+
+    __real_xPortSysTickHandler ();
+}
+
+uint32_t Board_getCycles (void)
+{
+    uint32_t ui32Base, ui32Reload, ui32Before, ui32After;
+    bool bPending;
+
+    /* Start over if the tick came in between. */
+    do
+    {
+        ui32Base = ui32BoardCycleBase;
+        ui32Reload = BOARD_SYSTICK_RELOAD;
+        ui32Before = BOARD_SYSTICK_CURRENT;
+        bPending = ((BOARD_INT_CTRL & BOARD_INT_CTRL_PENDSTSET) != 0);
+        ui32After = BOARD_SYSTICK_CURRENT;
+    } while (ui32Base != ui32BoardCycleBase);
+
+    /* With interrupts masked the SysTick can reload before its handler counts it. If it is seen pending,
+     * the reload happened before ui32After was read, if not, after ui32Before was. */
+    if (bPending == true)
+    {
+        return ui32Base + (ui32Reload + 1) + (ui32Reload - ui32After);
+    }
+
+    return ui32Base + (ui32Reload - ui32Before);
+}
+
+/* QEMU does not model the peripheral ready registers, every peripheral is ready as soon as it is enabled. */
+bool __wrap_SysCtlPeripheralReady (uint32_t ui32Peripheral)
+{
+    return true;
+}
+
+/* QEMU does not model reading a timer back either, so TimerValueGet works out what it would read
+ * from the cycles since the timer was enabled, for the periodic count down mode of latency.c. */
+void __wrap_TimerLoadSet (uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    if (BOARD_TIMER (ui32Base) < BOARD_TIMERS)
+    {
+        ui32BoardTimerLoad[BOARD_TIMER (ui32Base)] = ui32Value;
+    }
+
+    __real_TimerLoadSet (ui32Base, ui32Timer, ui32Value);
+}
+
+void __wrap_TimerEnable (uint32_t ui32Base, uint32_t ui32Timer)
+{
+    if (BOARD_TIMER (ui32Base) < BOARD_TIMERS)
+    {
+        ui32BoardTimerStart[BOARD_TIMER (ui32Base)] = Board_getCycles ();
+    }
+
+    __real_TimerEnable (ui32Base, ui32Timer);
+}
+
+uint32_t __wrap_TimerValueGet (uint32_t ui32Base, uint32_t ui32Timer)
+{
+    uint32_t ui32Index = BOARD_TIMER (ui32Base);
+    uint32_t ui32Load;
+
+    if (ui32Index >= BOARD_TIMERS)
+    {
+        return __real_TimerValueGet (ui32Base, ui32Timer);
+    }
+
+    ui32Load = ui32BoardTimerLoad[ui32Index];
+
+    return ui32Load - ((Board_getCycles () - ui32BoardTimerStart[ui32Index]) % (ui32Load + 1));
+}
@@ -0,0 +1,40 @@
+/*
+ * Board support for QEMU's lm3s6965evb machine, built with make BOARD=qemu.
+ * The LM3S6965 is the Stellaris part the TM4C123GH6PM grew out of, with the
+ * same addresses for the flash, the SRAM, UART0, the GPIO ports and the
+ * general purpose timers, and the same interrupt numbers, so UART0_Init and
+ * the rest of the projects run on it unchanged, with -cpu cortex-m4 for the
+ * FPU. This header is forced in front of every file of the QEMU build, and
+ * board_qemu.c fills in for the little QEMU does not model.
+ */
+
+#ifndef BOARD_QEMU_H
+#define BOARD_QEMU_H
+
+/*****************************************************************************/
+/*                                 HEADER FILES                              */
+/*****************************************************************************/
+
+/* Libraries includes.  */
+#include <stdint.h>
+
+/*****************************************************************************/
+/*                                  #defines                                 */
+/*****************************************************************************/
+
+/* QEMU has no DWT, so the run time counter is rebuilt from the SysTick, which counts the same
+ * system clock. It is only as exact as the timing of QEMU, run it with -icount to make it repeatable. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()          Board_getCycles ()
+
+/* The LM3S6965 only has UART0 to UART2, so the ports the gateway bridges are not there. */
+#define GATEWAY_USE                               0
+
+/*****************************************************************************/
+/*                               Function Prototypes                         */
+/*****************************************************************************/
+
+/* Free running count of system clock cycles, wraps around at 2^32 like CYCCNT. */
+uint32_t Board_getCycles (void);
+
+#endif /* BOARD_QEMU_H */
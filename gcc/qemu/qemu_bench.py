@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+#
+# Runs the FreeRTOS project under QEMU's lm3s6965evb machine and collects the
+# results of its benchmark commands from the emulated UART0.
+#
+#   qemu_bench.py build/qemu/FreeRTOS/FreeRTOS.elf
+#   qemu_bench.py --runs 10 --latency --csv results.csv <elf>
+#
+# The kernel benchmark, k, is run --runs times, the latency test, t, once with
+# --latency, alone with --runs 0 --latency.  Every result line is printed as it
+# comes in, then a summary.  The exit status is not 0 if the firmware never
+# prompted or a command timed out.
+#
+
+import argparse
+import csv
+import re
+import select
+import subprocess
+import sys
+import time
+
+PROMPT = re.compile(r"Please enter")
+KERNEL = re.compile(r"Hot paths in (flash|SRAM), context switch cycles (\d+), "
+                    r"tick cycles min/average/max (\d+)/(\d+)/(\d+) over (\d+) ticks")
+FPU = re.compile(r"Notify round trip cycles to no FPU/FPU/FPU reset (\d+)/(\d+)/(\d+)")
+LOAD = re.compile(r"Load (\w+), samples (\d+), overruns (\d+)")
+POINT = re.compile(r" to (ISR|task|GPIO) (\d+)/(\d+): ([\d ]+)")
+
+
+class Target:
+    """QEMU with the UART0 of the firmware on its standard input and output."""
+
+    def __init__(self, qemu, elf, cpu, icount):
+        command = [qemu, "-machine", "lm3s6965evb", "-cpu", cpu,
+                   "-kernel", elf, "-display", "none", "-monitor", "none",
+                   "-serial", "stdio"]
+        if icount is not None:
+            command += ["-icount", "shift=" + icount]
+        self.process = subprocess.Popen(command, stdin=subprocess.PIPE,
+                                        stdout=subprocess.PIPE)
+        self.pending = b""
+
+    def send(self, command):
+        self.process.stdin.write(command.encode())
+        self.process.stdin.flush()
+
+    def line(self, deadline):
+        """The next line from the UART, None once the deadline has passed."""
+        while True:
+            for end in (b"\n", b"\r"):
+                if end in self.pending:
+                    text, self.pending = self.pending.split(end, 1)
+                    if text.strip():
+                        return text.decode(errors="replace")
+            left = deadline - time.monotonic()
+            if left <= 0:
+                return None
+            ready, _, _ = select.select([self.process.stdout], [], [], left)
+            if ready:
+                data = self.process.stdout.read1(4096)
+                if not data:
+                    raise RuntimeError("QEMU exited")
+                self.pending += data
+
+    def expect(self, pattern, timeout):
+        deadline = time.monotonic() + timeout
+        while True:
+            text = self.line(deadline)
+            if text is None:
+                raise TimeoutError("no " + pattern.pattern)
+            print(text)
+            match = pattern.search(text)
+            if match:
+                return match
+
+    def close(self):
+        self.process.kill()
+        self.process.wait()
+
+
+def kernel_bench(target, timeout):
+    target.send("k")
+    match = target.expect(KERNEL, timeout)
+    fpu = target.expect(FPU, timeout)
+    return {"hot_paths": match.group(1),
+            "switch_cycles": int(match.group(2)),
+            "tick_min": int(match.group(3)),
+            "tick_average": int(match.group(4)),
+            "tick_max": int(match.group(5)),
+            "ticks": int(match.group(6)),
+            "notify_no_fpu": int(fpu.group(1)),
+            "notify_fpu": int(fpu.group(2)),
+            "notify_fpu_reset": int(fpu.group(3))}
+
+
+def latency_test(target, timeout):
+    target.send("t")
+    results = []
+    for _ in range(4):
+        load = target.expect(LOAD, timeout)
+        for _ in range(3):
+            point = target.expect(POINT, timeout)
+            results.append({"load": load.group(1),
+                            "samples": int(load.group(2)),
+                            "overruns": int(load.group(3)),
+                            "point": point.group(1),
+                            "min": int(point.group(2)),
+                            "max": int(point.group(3)),
+                            "buckets": point.group(4).strip()})
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Run the benchmarks of the FreeRTOS project under QEMU.")
+    parser.add_argument("elf", help="FreeRTOS image built with make BOARD=qemu")
+    parser.add_argument("--qemu", default="qemu-system-arm")
+    parser.add_argument("--cpu", default="cortex-m4")
+    parser.add_argument("--icount", default="0",
+                        help="QEMU -icount shift, 'none' for real time")
+    parser.add_argument("--runs", type=int, default=5,
+                        help="times the kernel benchmark is run, may be 0")
+    parser.add_argument("--latency", action="store_true",
+                        help="also run the latency test")
+    parser.add_argument("--timeout", type=float, default=60,
+                        help="seconds to wait for each result")
+    parser.add_argument("--csv", help="write the kernel benchmark runs here")
+    args = parser.parse_args()
+
+    target = Target(args.qemu, args.elf, args.cpu,
+                    None if args.icount == "none" else args.icount)
+    try:
+        target.expect(PROMPT, args.timeout)
+        runs = [kernel_bench(target, args.timeout) for _ in range(args.runs)]
+        latency = latency_test(target, args.timeout) if args.latency else []
+    except (TimeoutError, RuntimeError) as error:
+        print("qemu_bench: " + str(error), file=sys.stderr)
+        return 1
+    finally:
+        target.close()
+
+    if args.csv and runs:
+        with open(args.csv, "w", newline="") as output:
+            writer = csv.DictWriter(output, fieldnames=list(runs[0].keys()))
+            writer.writeheader()
+            writer.writerows(runs)
+
+    if runs:
+        print("\nKernel benchmark over %d runs, hot paths in %s"
+              % (len(runs), runs[0]["hot_paths"]))
+        for key in ("switch_cycles", "tick_min", "tick_average", "tick_max",
+                    "notify_no_fpu", "notify_fpu", "notify_fpu_reset"):
+            values = [run[key] for run in runs]
+            print("  %-16s min %8d  average %8d  max %8d"
+                  % (key, min(values), sum(values) // len(values), max(values)))
+
+    if latency:
+        print("\nLatency test, cycles from the timer time-out")
+    for result in latency:
+        print("  latency %-9s to %-5s min %6d  max %6d"
+              % (result["load"], result["point"], result["min"], result["max"]))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
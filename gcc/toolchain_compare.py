@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+#
+# Compares the images of the TI and Keil toolchains with those of GCC, and the
+# output of the kernel benchmark, k, of the FreeRTOS project built by each.
+#
+#   toolchain_compare.py sizes
+#   toolchain_compare.py capture /dev/ttyACM0 ti.txt
+#   toolchain_compare.py bench ti.txt gcc.txt
+#
+# sizes reads the image CCS leaves in <project>/Debug, the one named in its
+# Debug/makefile, or the .axf Keil leaves in the project directory, and the
+# one make leaves in build/<project>.  Both are read the way size reads them,
+# text is the allocated sections that are not written, data those that are,
+# bss those that take no room in the file, so the two toolchains are counted
+# alike without arm-none-eabi-size.  The TI linker keeps the initial values
+# of .data in .cinit and copies them at boot, so its data is in text and bss.
+# Build both from the same sources first, the images CCS left in the tree are
+# not rebuilt by anything here.
+#
+# capture sends k to the console of the board on the serial port and saves
+# what comes back until the last line of the benchmark.  bench puts two such
+# captures side by side, every line with the numbers of each, and the change
+# from the first to the second.
+#
+
+import argparse
+import fcntl
+import os
+import re
+import struct
+import sys
+import termios
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.join(HERE, "..")
+BUILD = os.path.join(HERE, "build")
+
+FREERTOS_PROJECTS = ["FreeRTOS", "FreeRTOS_EX1", "FreeRTOS_EX2", "FreeRTOS_EX3"]
+BAREMETAL_PROJECTS = ["GPIO_Example", "Interrupt_Example", "SysTick_Timer_Example"]
+
+# The console of main.c, CONSOLE_BAUD, and the last line k prints.
+CONSOLE_BAUD = 128000
+BENCH_END = re.compile(r"Counter increment cycles")
+
+# 128000 is not one of the rates of termios, it takes the struct termios2 of
+# Linux with BOTHER: 4 flag words, c_line, 19 c_cc, then the two speeds.
+TCGETS2 = 0x802C542A
+TCSETS2 = 0x402C542B
+TERMIOS2 = "<4IB19s2I"
+CBAUD = 0o010017
+BOTHER = 0o010000
+VMIN = 6
+VTIME = 5
+
+NUMBER = re.compile(r"\d+")
+
+SHT_NOBITS = 8
+SHF_WRITE = 1
+SHF_ALLOC = 2
+
+
+def elf_size(path):
+    """(text, data, bss) of a 32 bit little endian ELF file."""
+    with open(path, "rb") as f:
+        image = f.read()
+    if image[:6] != b"\x7fELF\x01\x01":
+        raise ValueError(path + " is not a 32 bit little endian ELF file")
+
+    shoff, = struct.unpack_from("<I", image, 0x20)
+    shentsize, shnum = struct.unpack_from("<HH", image, 0x2E)
+    text = data = bss = 0
+    for i in range(shnum):
+        _, kind, flags, _, _, size = struct.unpack_from("<6I", image, shoff + i * shentsize)
+        if not flags & SHF_ALLOC:
+            continue
+        if kind == SHT_NOBITS:
+            bss += size
+        elif flags & SHF_WRITE:
+            data += size
+        else:
+            text += size
+    return text, data, bss
+
+
+def vendor_image(project):
+    """The image CCS or Keil built for the project, None if there is none."""
+    makefile = os.path.join(ROOT, project, "Debug", "makefile")
+    if os.path.exists(makefile):
+        with open(makefile, errors="replace") as f:
+            match = re.search(r"([\w.-]+\.out)", f.read())
+        if match:
+            path = os.path.join(ROOT, project, "Debug", match.group(1))
+            return path if os.path.exists(path) else None
+    images = sorted(name for name in os.listdir(os.path.join(ROOT, project)) if name.endswith(".axf"))
+    return os.path.join(ROOT, project, images[0]) if images else None
+
+
+def sizes(_):
+    print("%-22s %-5s %8s %8s %8s   %s" % ("project", "tool", "text", "data", "bss", "image"))
+    for project in FREERTOS_PROJECTS + BAREMETAL_PROJECTS:
+        vendor = "ti" if project in FREERTOS_PROJECTS else "keil"
+        rows = []
+        for tool, path in ((vendor, vendor_image(project)),
+                           ("gcc", os.path.join(BUILD, project, project + ".elf"))):
+            if path is None or not os.path.exists(path):
+                print("%-22s %-5s %8s %8s %8s   not built" % (project, tool, "-", "-", "-"))
+                continue
+            rows.append(elf_size(path))
+            print("%-22s %-5s %8d %8d %8d   %s" % ((project, tool) + rows[-1] + (os.path.relpath(path, ROOT),)))
+        if len(rows) == 2:
+            print("%-22s %-5s %+8d %+8d %+8d" % ((project, "diff") + tuple(g - v for v, g in zip(*rows))))
+    return 0
+
+
+def capture(args):
+    fd = os.open(args.port, os.O_RDWR | os.O_NOCTTY)
+    try:
+        # Raw 8N1 at CONSOLE_BAUD, reads return after 0.1 s without a byte.
+        raw = fcntl.ioctl(fd, TCGETS2, bytes(struct.calcsize(TERMIOS2)))
+        _, _, cflag, _, line, cc, _, _ = struct.unpack(TERMIOS2, raw)
+        cflag = (cflag & ~(CBAUD | termios.CSIZE | termios.PARENB | termios.CSTOPB | termios.CRTSCTS)) \
+            | BOTHER | termios.CS8 | termios.CREAD | termios.CLOCAL
+        cc = bytearray(cc)
+        cc[VMIN] = 0
+        cc[VTIME] = 1
+        fcntl.ioctl(fd, TCSETS2, struct.pack(TERMIOS2, 0, 0, cflag, 0, line, bytes(cc),
+                                             CONSOLE_BAUD, CONSOLE_BAUD))
+        termios.tcflush(fd, termios.TCIOFLUSH)
+
+        os.write(fd, b"k")
+        received = b""
+        deadline = time.monotonic() + args.timeout
+        while not BENCH_END.search(received.decode(errors="replace")):
+            if time.monotonic() > deadline:
+                print("capture: no end of the benchmark after %g s" % args.timeout, file=sys.stderr)
+                return 1
+            received += os.read(fd, 256)
+        # The rest of the last line.
+        while not received.endswith(b"\r") and time.monotonic() <= deadline:
+            chunk = os.read(fd, 256)
+            if not chunk:
+                break
+            received += chunk
+    finally:
+        os.close(fd)
+
+    with open(args.output, "w") as f:
+        f.write(received.decode(errors="replace").replace("\r", ""))
+    return 0
+
+
+def bench_lines(path):
+    """The lines of a capture that have numbers, as (label, numbers)."""
+    lines = []
+    with open(path, errors="replace") as f:
+        for line in f:
+            numbers = NUMBER.findall(line)
+            if numbers:
+                lines.append((NUMBER.sub("#", line.strip()), [int(n) for n in numbers]))
+    return lines
+
+
+def bench(args):
+    first = bench_lines(args.first)
+    second = dict(bench_lines(args.second))
+    for label, numbers in first:
+        print(label)
+        if label not in second:
+            print("    %-8s %s\n    %-8s missing" % (args.first_name, numbers, args.second_name))
+            continue
+        print("    %-8s %s\n    %-8s %s" % (args.first_name, numbers, args.second_name, second[label]))
+        print("    %-8s %s" % ("change", ["%+.1f%%" % (100.0 * (b - a) / a) if a else "-"
+                                         for a, b in zip(numbers, second[label])]))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the TI and Keil builds with the GCC ones.")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    commands.add_parser("sizes", help="text, data and bss of every image")
+
+    command = commands.add_parser("capture", help="save the output of k from the board")
+    command.add_argument("port")
+    command.add_argument("output")
+    command.add_argument("--timeout", type=float, default=30)
+
+    command = commands.add_parser("bench", help="put two captures side by side")
+    command.add_argument("first")
+    command.add_argument("second")
+    command.add_argument("--first-name", default="ti")
+    command.add_argument("--second-name", default="gcc")
+
+    args = parser.parse_args()
+    return {"sizes": sizes, "capture": capture, "bench": bench}[args.command](args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())